@@ -18,6 +18,7 @@
 #define CYBER_BLOCKER_INTRA_WRITER_H_
 
 #include <memory>
+#include <utility>
 
 #include "cyber/blocker/blocker_manager.h"
 #include "cyber/node/writer.h"
@@ -39,6 +40,7 @@ class IntraWriter : public apollo::cyber::Writer<MessageT> {
   void Shutdown() override;
 
   bool Write(const MessageT& msg) override;
+  bool Write(MessageT&& msg) override;
   bool Write(const MessagePtr& msg_ptr) override;
 
  private:
@@ -90,6 +92,16 @@ bool IntraWriter<MessageT>::Write(const MessageT& msg) {
                                              msg);
 }
 
+template <typename MessageT>
+bool IntraWriter<MessageT>::Write(MessageT&& msg) {
+  if (!WriterBase::IsInit()) {
+    return false;
+  }
+  return blocker_manager_->Publish<MessageT>(
+      this->role_attr_.channel_name(),
+      std::make_shared<MessageT>(std::move(msg)));
+}
+
 template <typename MessageT>
 bool IntraWriter<MessageT>::Write(const MessagePtr& msg_ptr) {
   if (!WriterBase::IsInit()) {
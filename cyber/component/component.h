@@ -17,7 +17,9 @@
 #ifndef CYBER_COMPONENT_COMPONENT_H_
 #define CYBER_COMPONENT_COMPONENT_H_
 
+#include <algorithm>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -39,22 +41,27 @@ using apollo::cyber::proto::RoleAttributes;
 
 /**
  * @brief .
- * The Component can process up to four channels of messages. The message type
- * is specified when the component is created. The Component is inherited from
- * ComponentBase. Your component can inherit from Component, and implement
- * Init() & Proc(...), They are picked up by the CyberRT. There are 4
- * specialization implementations.
+ * The Component can process messages of any number of channels. The message
+ * types are specified when the component is created. The Component is
+ * inherited from ComponentBase. Your component can inherit from Component,
+ * and implement Init() & Proc(...), They are picked up by the CyberRT.
+ * Components of zero to three channels are specializations, this template
+ * handles four channels or more. Proc is called for each message of the
+ * first channel together with one message of every other channel, their
+ * latest ones or, if the config sets fusion_window_ms, the ones nearest in
+ * time to it, see data::DataVisitor.
  *
  * @tparam M0 the first message.
  * @tparam M1 the second message.
  * @tparam M2 the third message.
  * @tparam M3 the fourth message.
+ * @tparam M the messages of any further channels.
  * @warning The Init & Proc functions need to be overloaded, but don't want to
  * be called. They are called by the CyberRT Frame.
  *
  */
 template <typename M0 = NullType, typename M1 = NullType,
-          typename M2 = NullType, typename M3 = NullType>
+          typename M2 = NullType, typename M3 = NullType, typename... M>
 class Component : public ComponentBase {
  public:
   Component() {}
@@ -69,10 +76,17 @@ class Component : public ComponentBase {
    */
   bool Initialize(const ComponentConfig& config) override;
   bool Process(const std::shared_ptr<M0>& msg0, const std::shared_ptr<M1>& msg1,
-               const std::shared_ptr<M2>& msg2,
-               const std::shared_ptr<M3>& msg3);
+               const std::shared_ptr<M2>& msg2, const std::shared_ptr<M3>& msg3,
+               const std::shared_ptr<M>&... msgs);
 
  private:
+  // message type of the I-th channel after the first one
+  template <std::size_t I>
+  using FusedMessage = std::tuple_element_t<I, std::tuple<M1, M2, M3, M...>>;
+
+  template <std::size_t... I>
+  bool Initialize(const ComponentConfig& config, std::index_sequence<I...>);
+
   /**
    * @brief The process logical of yours.
    *
@@ -80,13 +94,15 @@ class Component : public ComponentBase {
    * @param msg1 the second channel message.
    * @param msg2 the third channel message.
    * @param msg3 the fourth channel message.
+   * @param msgs the messages of the further channels.
    *
    * @return returns true if successful, otherwise returns false
    */
   virtual bool Proc(const std::shared_ptr<M0>& msg0,
                     const std::shared_ptr<M1>& msg1,
                     const std::shared_ptr<M2>& msg2,
-                    const std::shared_ptr<M3>& msg3) = 0;
+                    const std::shared_ptr<M3>& msg3,
+                    const std::shared_ptr<M>&... msgs) = 0;
 };
 
 template <>
@@ -309,7 +325,8 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(
+      config_list, uint64_t{config.fusion_window_ms()} * 1000000);
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -419,29 +436,38 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(
+      config_list, uint64_t{config.fusion_window_ms()} * 1000000);
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2>(func, dv);
   return sched->CreateTask(factory, node_->Name());
 }
 
-template <typename M0, typename M1, typename M2, typename M3>
-bool Component<M0, M1, M2, M3>::Process(const std::shared_ptr<M0>& msg0,
-                                        const std::shared_ptr<M1>& msg1,
-                                        const std::shared_ptr<M2>& msg2,
-                                        const std::shared_ptr<M3>& msg3) {
+template <typename M0, typename M1, typename M2, typename M3, typename... M>
+bool Component<M0, M1, M2, M3, M...>::Process(
+    const std::shared_ptr<M0>& msg0, const std::shared_ptr<M1>& msg1,
+    const std::shared_ptr<M2>& msg2, const std::shared_ptr<M3>& msg3,
+    const std::shared_ptr<M>&... msgs) {
   if (is_shutdown_.load()) {
     return true;
   }
-  return Proc(msg0, msg1, msg2, msg3);
+  return Proc(msg0, msg1, msg2, msg3, msgs...);
+}
+
+template <typename M0, typename M1, typename M2, typename M3, typename... M>
+bool Component<M0, M1, M2, M3, M...>::Initialize(
+    const ComponentConfig& config) {
+  return Initialize(config, std::index_sequence_for<M1, M2, M3, M...>());
 }
 
-template <typename M0, typename M1, typename M2, typename M3>
-bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
+template <typename M0, typename M1, typename M2, typename M3, typename... M>
+template <std::size_t... I>
+bool Component<M0, M1, M2, M3, M...>::Initialize(const ComponentConfig& config,
+                                                 std::index_sequence<I...>) {
   node_.reset(new Node(config.name()));
   LoadConfigFiles(config);
 
-  if (config.readers_size() < 4) {
+  if (config.readers_size() < static_cast<int>(sizeof...(I) + 1)) {
     AERROR << "Invalid config file: too few readers_." << std::endl;
     return false;
   }
@@ -453,98 +479,77 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
 
   bool is_reality_mode = GlobalData::Instance()->IsRealityMode();
 
-  ReaderConfig reader_cfg;
-  reader_cfg.channel_name = config.readers(1).channel();
-  reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
-  reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
-
-  auto reader1 = node_->template CreateReader<M1>(reader_cfg);
-
-  reader_cfg.channel_name = config.readers(2).channel();
-  reader_cfg.qos_profile.CopyFrom(config.readers(2).qos_profile());
-  reader_cfg.pending_queue_size = config.readers(2).pending_queue_size();
-
-  auto reader2 = node_->template CreateReader<M2>(reader_cfg);
-
-  reader_cfg.channel_name = config.readers(3).channel();
-  reader_cfg.qos_profile.CopyFrom(config.readers(3).qos_profile());
-  reader_cfg.pending_queue_size = config.readers(3).pending_queue_size();
+  auto reader_config = [&config](int index) {
+    ReaderConfig reader_cfg;
+    reader_cfg.channel_name = config.readers(index).channel();
+    reader_cfg.qos_profile.CopyFrom(config.readers(index).qos_profile());
+    reader_cfg.pending_queue_size = config.readers(index).pending_queue_size();
+    return reader_cfg;
+  };
 
-  auto reader3 = node_->template CreateReader<M3>(reader_cfg);
-
-  reader_cfg.channel_name = config.readers(0).channel();
-  reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
-  reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  std::vector<std::shared_ptr<ReaderBase>> fused_readers = {
+      node_->template CreateReader<FusedMessage<I>>(reader_config(I + 1))...};
 
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
-    reader0 = node_->template CreateReader<M0>(reader_cfg);
+    reader0 = node_->template CreateReader<M0>(reader_config(0));
   } else {
-    std::weak_ptr<Component<M0, M1, M2, M3>> self =
-        std::dynamic_pointer_cast<Component<M0, M1, M2, M3>>(
-            shared_from_this());
+    std::weak_ptr<Component> self =
+        std::dynamic_pointer_cast<Component>(shared_from_this());
 
-    auto blocker1 = blocker::BlockerManager::Instance()->GetBlocker<M1>(
-        config.readers(1).channel());
-    auto blocker2 = blocker::BlockerManager::Instance()->GetBlocker<M2>(
-        config.readers(2).channel());
-    auto blocker3 = blocker::BlockerManager::Instance()->GetBlocker<M3>(
-        config.readers(3).channel());
+    auto blockers = std::make_tuple(
+        blocker::BlockerManager::Instance()->GetBlocker<FusedMessage<I>>(
+            config.readers(I + 1).channel())...);
 
-    auto func = [self, blocker1, blocker2,
-                 blocker3](const std::shared_ptr<M0>& msg0) {
+    auto func = [self, blockers](const std::shared_ptr<M0>& msg0) {
       auto ptr = self.lock();
       if (ptr) {
-        if (!blocker1->IsPublishedEmpty() && !blocker2->IsPublishedEmpty() &&
-            !blocker3->IsPublishedEmpty()) {
-          auto msg1 = blocker1->GetLatestPublishedPtr();
-          auto msg2 = blocker2->GetLatestPublishedPtr();
-          auto msg3 = blocker3->GetLatestPublishedPtr();
-          ptr->Process(msg0, msg1, msg2, msg3);
+        if (!(std::get<I>(blockers)->IsPublishedEmpty() || ...)) {
+          ptr->Process(msg0,
+                       std::get<I>(blockers)->GetLatestPublishedPtr()...);
         }
       } else {
         AERROR << "Component object has been destroyed.";
       }
     };
 
-    reader0 = node_->template CreateReader<M0>(reader_cfg, func);
+    reader0 = node_->template CreateReader<M0>(reader_config(0), func);
   }
 
-  if (reader0 == nullptr || reader1 == nullptr || reader2 == nullptr ||
-      reader3 == nullptr) {
+  if (reader0 == nullptr ||
+      std::find(fused_readers.begin(), fused_readers.end(), nullptr) !=
+          fused_readers.end()) {
     AERROR << "Component create reader failed." << std::endl;
     return false;
   }
   readers_.push_back(std::move(reader0));
-  readers_.push_back(std::move(reader1));
-  readers_.push_back(std::move(reader2));
-  readers_.push_back(std::move(reader3));
+  readers_.insert(readers_.end(), fused_readers.begin(), fused_readers.end());
 
   if (cyber_unlikely(!is_reality_mode)) {
     return true;
   }
 
   auto sched = scheduler::Instance();
-  std::weak_ptr<Component<M0, M1, M2, M3>> self =
-      std::dynamic_pointer_cast<Component<M0, M1, M2, M3>>(shared_from_this());
-  auto func =
-      [self](const std::shared_ptr<M0>& msg0, const std::shared_ptr<M1>& msg1,
-             const std::shared_ptr<M2>& msg2, const std::shared_ptr<M3>& msg3) {
-        auto ptr = self.lock();
-        if (ptr) {
-          ptr->Process(msg0, msg1, msg2, msg3);
-        } else {
-          AERROR << "Component object has been destroyed." << std::endl;
-        }
-      };
+  std::weak_ptr<Component> self =
+      std::dynamic_pointer_cast<Component>(shared_from_this());
+  auto func = [self](const std::shared_ptr<M0>& msg0,
+                     const std::shared_ptr<FusedMessage<I>>&... msgs) {
+    auto ptr = self.lock();
+    if (ptr) {
+      ptr->Process(msg0, msgs...);
+    } else {
+      AERROR << "Component object has been destroyed." << std::endl;
+    }
+  };
 
   std::vector<data::VisitorConfig> config_list;
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3, M...>>(
+      config_list, uint64_t{config.fusion_window_ms()} * 1000000);
   croutine::RoutineFactory factory =
-      croutine::CreateRoutineFactory<M0, M1, M2, M3>(func, dv);
+      croutine::CreateRoutineFactory<M0, M1, M2, M3, M...>(func, dv);
   return sched->CreateTask(factory, node_->Name());
 }
 
@@ -39,7 +39,7 @@ enum class RoutineState { READY, FINISHED, SLEEP, IO_WAIT, DATA_WAIT };
 
 class CRoutine {
  public:
-  explicit CRoutine(const RoutineFunc &func);
+  explicit CRoutine(const RoutineFunc &func, size_t stack_size = STACK_SIZE);
   virtual ~CRoutine();
 
   // static interfaces
@@ -94,6 +94,10 @@ class CRoutine {
 
   const std::string &group_name() { return group_name_; }
 
+  void set_group_id(uint32_t group_id) { group_id_ = group_id; }
+
+  uint32_t group_id() const { return group_id_; }
+
  private:
   CRoutine(CRoutine &) = delete;
   CRoutine &operator=(CRoutine &) = delete;
@@ -117,6 +121,7 @@ class CRoutine {
   uint64_t id_ = 0;
 
   std::string group_name_;
+  uint32_t group_id_ = 0;
 
   static thread_local CRoutine *current_routine_;
   static thread_local char *main_stack_;
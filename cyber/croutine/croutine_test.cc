@@ -15,9 +15,17 @@
  *****************************************************************************/
 #include "cyber/croutine/croutine.h"
 
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "cyber/common/global_data.h"
+#include "cyber/croutine/detail/stack_pool.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
 
@@ -49,6 +57,50 @@ TEST(Croutine, croutinetest) {
   EXPECT_EQ(cr->Resume(), RoutineState::FINISHED);
 }
 
+size_t ResidentKB() {
+  size_t size = 0;
+  size_t resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> size >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+TEST(Croutine, stack_size) {
+  auto cr = std::make_shared<CRoutine>(function, 64 * 1024);
+  EXPECT_EQ(cr->GetContext()->stack_size, 64 * 1024);
+  EXPECT_EQ(cr->Resume(), RoutineState::IO_WAIT);
+  auto stack = cr->GetContext()->stack;
+
+  // the stack is handed back to the pool and reused by the next croutine
+  auto reused_num = StackPool::Instance()->reused_num();
+  cr = nullptr;
+  cr = std::make_shared<CRoutine>(function, 64 * 1024);
+  EXPECT_EQ(cr->GetContext()->stack, stack);
+  EXPECT_EQ(StackPool::Instance()->reused_num(), reused_num + 1);
+}
+
+TEST(Croutine, stack_rss) {
+  const int kRoutineNum = 300;
+  auto rss = ResidentKB();
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  for (int i = 0; i < kRoutineNum; ++i) {
+    crs.emplace_back(std::make_shared<CRoutine>(function));
+    crs.back()->Resume();
+  }
+  auto delta = ResidentKB() - rss;
+  std::cout << kRoutineNum << " croutines with " << STACK_SIZE / 1024
+            << "KB stacks, rss grew by " << delta << "KB" << std::endl;
+  // only the pages a croutine touched are committed
+  EXPECT_LT(delta, kRoutineNum * STACK_SIZE / 1024 / 16);
+
+  auto mapped_num = StackPool::Instance()->mapped_num();
+  crs.resize(kRoutineNum / 10);
+  for (int i = 0; i < kRoutineNum / 10; ++i) {
+    crs.emplace_back(std::make_shared<CRoutine>(function));
+  }
+  EXPECT_EQ(StackPool::Instance()->mapped_num(), mapped_num);
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
@@ -16,10 +16,20 @@
 
 #include "cyber/croutine/detail/routine_context.h"
 
+#include "cyber/croutine/detail/stack_pool.h"
+
 namespace apollo {
 namespace cyber {
 namespace croutine {
 
+RoutineContext::RoutineContext(size_t size) : stack_size(size) {
+  stack = StackPool::Instance()->Acquire(&stack_size);
+}
+
+RoutineContext::~RoutineContext() {
+  StackPool::Instance()->Release(stack, stack_size);
+}
+
 //  The stack layout looks as follows:
 //
 //              +------------------+
@@ -38,12 +48,13 @@ namespace croutine {
 // ctx->sp  =>  |        RBP       |
 //              +------------------+
 void MakeContext(const func &f1, const void *arg, RoutineContext *ctx) {
-  ctx->sp = ctx->stack + STACK_SIZE - 2 * sizeof(void *) - REGISTERS_SIZE;
+  char *top = ctx->stack + ctx->stack_size;
+  ctx->sp = top - 2 * sizeof(void *) - REGISTERS_SIZE;
   std::memset(ctx->sp, 0, REGISTERS_SIZE);
 #ifdef __aarch64__
-  char *sp = ctx->stack + STACK_SIZE - sizeof(void *);
+  char *sp = top - sizeof(void *);
 #else
-  char *sp = ctx->stack + STACK_SIZE - 2 * sizeof(void *);
+  char *sp = top - 2 * sizeof(void *);
 #endif
   *reinterpret_cast<void **>(sp) = reinterpret_cast<void *>(f1);
   sp -= sizeof(void *);
@@ -40,7 +40,14 @@ constexpr size_t REGISTERS_SIZE = 56;
 
 typedef void (*func)(void*);
 struct RoutineContext {
-  char stack[STACK_SIZE];
+  explicit RoutineContext(size_t size = STACK_SIZE);
+  ~RoutineContext();
+  RoutineContext(const RoutineContext&) = delete;
+  RoutineContext& operator=(const RoutineContext&) = delete;
+
+  // taken from StackPool, lazily committed with a guard page below it
+  char* stack = nullptr;
+  size_t stack_size = 0;
   char* sp = nullptr;
 #if defined __aarch64__
 } __attribute__((aligned(16)));
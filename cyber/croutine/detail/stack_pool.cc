@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <new>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+namespace {
+
+// released stacks kept per size when routine_num is not configured higher
+const uint32_t kMinFreeNum = 64;
+
+size_t PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+}  // namespace
+
+StackPool::StackPool() {
+  uint32_t routine_num = std::max(
+      kMinFreeNum,
+      static_cast<uint32_t>(common::GlobalData::Instance()->ComponentNums()));
+  auto& global_conf = common::GlobalData::Instance()->Config();
+  if (global_conf.has_scheduler_conf() &&
+      global_conf.scheduler_conf().has_routine_num()) {
+    routine_num =
+        std::max(routine_num, global_conf.scheduler_conf().routine_num());
+  }
+  max_free_num_ = routine_num;
+}
+
+size_t StackPool::RoundUp(size_t size) {
+  auto page_size = PageSize();
+  return (std::max(size, page_size) + page_size - 1) / page_size * page_size;
+}
+
+char* StackPool::Acquire(size_t* size) {
+  *size = RoundUp(*size);
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = free_stacks_.find(*size);
+    if (it != free_stacks_.end() && !it->second.empty()) {
+      auto stack = it->second.back();
+      it->second.pop_back();
+      ++reused_num_;
+      return stack;
+    }
+    ++mapped_num_;
+  }
+
+  auto page_size = PageSize();
+  void* addr = mmap(nullptr, *size + page_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "mmap croutine stack of size " << *size << " failed.";
+    throw std::bad_alloc();
+  }
+  // stacks grow down, the guard page sits below the usable range
+  if (mprotect(addr, page_size, PROT_NONE) != 0) {
+    AWARN << "failed to protect croutine stack guard page.";
+  }
+  return static_cast<char*>(addr) + page_size;
+}
+
+void StackPool::Release(char* stack, size_t size) {
+  // hand the touched pages back, a reused stack starts from zero pages
+  madvise(stack, size, MADV_DONTNEED);
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto& stacks = free_stacks_[size];
+    if (stacks.size() < max_free_num_) {
+      stacks.push_back(stack);
+      return;
+    }
+  }
+  Unmap(stack, size);
+}
+
+void StackPool::Unmap(char* stack, size_t size) {
+  auto page_size = PageSize();
+  munmap(stack - page_size, size + page_size);
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
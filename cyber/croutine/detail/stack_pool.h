@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+#define CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+// Croutine stacks mapped with mmap. Pages are only committed when the
+// croutine touches them, and an inaccessible guard page below each stack
+// turns an overflow into a SIGSEGV instead of silent heap corruption.
+// Released stacks are kept for reuse, up to routine_num (at least 64) per
+// size.
+class StackPool {
+ public:
+  // returns the lowest usable address of a stack of at least size bytes,
+  // size is rounded up to whole pages
+  char* Acquire(size_t* size);
+  void Release(char* stack, size_t size);
+
+  static size_t RoundUp(size_t size);
+
+  uint64_t mapped_num() const { return mapped_num_.load(); }
+  uint64_t reused_num() const { return reused_num_.load(); }
+
+ private:
+  void Unmap(char* stack, size_t size);
+
+  std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<char*>> free_stacks_;
+  size_t max_free_num_ = 0;
+  std::atomic<uint64_t> mapped_num_ = {0};
+  std::atomic<uint64_t> reused_num_ = {0};
+
+  DECLARE_SINGLETON(StackPool)
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_STACK_POOL_H_
@@ -18,6 +18,7 @@
 #define CYBER_CROUTINE_ROUTINE_FACTORY_H_
 
 #include <memory>
+#include <tuple>
 #include <utility>
 
 #include "cyber/common/global_data.h"
@@ -47,90 +48,22 @@ class RoutineFactory {
   std::shared_ptr<data::DataVisitorBase> data_visitor_ = nullptr;
 };
 
-template <typename M0, typename F>
+template <typename M0, typename... M, typename F>
 RoutineFactory CreateRoutineFactory(
-    F&& f, const std::shared_ptr<data::DataVisitor<M0>>& dv) {
+    F&& f, const std::shared_ptr<data::DataVisitor<M0, M...>>& dv) {
   RoutineFactory factory;
   factory.SetDataVisitor(dv);
   factory.create_routine = [=]() {
     return [=]() {
-      std::shared_ptr<M0> msg;
+      std::tuple<std::shared_ptr<M0>, std::shared_ptr<M>...> msgs;
+      auto try_fetch = [&dv](std::shared_ptr<M0>& msg0,  // NOLINT
+                             std::shared_ptr<M>&... msg) {  // NOLINT
+        return dv->TryFetch(msg0, msg...);
+      };
       for (;;) {
         CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
-        if (dv->TryFetch(msg)) {
-          f(msg);
-          CRoutine::Yield(RoutineState::READY);
-        } else {
-          CRoutine::Yield();
-        }
-      }
-    };
-  };
-  return factory;
-}
-
-template <typename M0, typename M1, typename F>
-RoutineFactory CreateRoutineFactory(
-    F&& f, const std::shared_ptr<data::DataVisitor<M0, M1>>& dv) {
-  RoutineFactory factory;
-  factory.SetDataVisitor(dv);
-  factory.create_routine = [=]() {
-    return [=]() {
-      std::shared_ptr<M0> msg0;
-      std::shared_ptr<M1> msg1;
-      for (;;) {
-        CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
-        if (dv->TryFetch(msg0, msg1)) {
-          f(msg0, msg1);
-          CRoutine::Yield(RoutineState::READY);
-        } else {
-          CRoutine::Yield();
-        }
-      }
-    };
-  };
-  return factory;
-}
-
-template <typename M0, typename M1, typename M2, typename F>
-RoutineFactory CreateRoutineFactory(
-    F&& f, const std::shared_ptr<data::DataVisitor<M0, M1, M2>>& dv) {
-  RoutineFactory factory;
-  factory.SetDataVisitor(dv);
-  factory.create_routine = [=]() {
-    return [=]() {
-      std::shared_ptr<M0> msg0;
-      std::shared_ptr<M1> msg1;
-      std::shared_ptr<M2> msg2;
-      for (;;) {
-        CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
-        if (dv->TryFetch(msg0, msg1, msg2)) {
-          f(msg0, msg1, msg2);
-          CRoutine::Yield(RoutineState::READY);
-        } else {
-          CRoutine::Yield();
-        }
-      }
-    };
-  };
-  return factory;
-}
-
-template <typename M0, typename M1, typename M2, typename M3, typename F>
-RoutineFactory CreateRoutineFactory(
-    F&& f, const std::shared_ptr<data::DataVisitor<M0, M1, M2, M3>>& dv) {
-  RoutineFactory factory;
-  factory.SetDataVisitor(dv);
-  factory.create_routine = [=]() {
-    return [=]() {
-      std::shared_ptr<M0> msg0;
-      std::shared_ptr<M1> msg1;
-      std::shared_ptr<M2> msg2;
-      std::shared_ptr<M3> msg3;
-      for (;;) {
-        CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
-        if (dv->TryFetch(msg0, msg1, msg2, msg3)) {
-          f(msg0, msg1, msg2, msg3);
+        if (std::apply(try_fetch, msgs)) {
+          std::apply(f, msgs);
           CRoutine::Yield(RoutineState::READY);
         } else {
           CRoutine::Yield();
@@ -17,15 +17,27 @@
 #ifndef CYBER_DATA_CACHE_BUFFER_H_
 #define CYBER_DATA_CACHE_BUFFER_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <vector>
+#include <thread>
+#include <utility>
+
+#include "cyber/base/macros.h"
 
 namespace apollo {
 namespace cyber {
 namespace data {
 
+/**
+ * Ring buffer filled by writers holding Mutex() and read without it.
+ * Head and tail are published with release stores. Each element has its
+ * own spin lock, held only for the copy of one element, so readers never
+ * wait on a writer filling another slot. Load() checks under that lock
+ * that the element has not been overwritten, like a seqlock read that
+ * validates its sequence.
+ */
 template <typename T>
 class CacheBuffer {
  public:
@@ -35,61 +47,120 @@ class CacheBuffer {
 
   explicit CacheBuffer(uint64_t size) {
     capacity_ = size + 1;
-    buffer_.resize(capacity_);
+    slots_.reset(new Slot[capacity_]);
   }
 
   CacheBuffer(const CacheBuffer& rhs) {
     std::lock_guard<std::mutex> lg(rhs.mutex_);
-    head_ = rhs.head_;
-    tail_ = rhs.tail_;
-    buffer_ = rhs.buffer_;
+    head_.store(rhs.head_.load());
+    tail_.store(rhs.tail_.load());
     capacity_ = rhs.capacity_;
+    slots_.reset(new Slot[capacity_]);
+    for (uint64_t i = 0; i < capacity_; ++i) {
+      slots_[i].value = rhs.slots_[i].value;
+    }
     fusion_callback_ = rhs.fusion_callback_;
   }
 
-  T& operator[](const uint64_t& pos) { return buffer_[GetIndex(pos)]; }
-  const T& at(const uint64_t& pos) const { return buffer_[GetIndex(pos)]; }
+  // direct access is not synchronized with Fill, hold Mutex() or use Load
+  T& operator[](const uint64_t& pos) { return slots_[GetIndex(pos)].value; }
+  const T& at(const uint64_t& pos) const {
+    return slots_[GetIndex(pos)].value;
+  }
 
-  uint64_t Head() const { return head_ + 1; }
-  uint64_t Tail() const { return tail_; }
-  uint64_t Size() const { return tail_ - head_; }
+  uint64_t Head() const { return head_.load(std::memory_order_acquire) + 1; }
+  uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+  uint64_t Size() const { return Tail() - (Head() - 1); }
 
-  const T& Front() const { return buffer_[GetIndex(head_ + 1)]; }
-  const T& Back() const { return buffer_[GetIndex(tail_)]; }
+  const T& Front() const { return at(Head()); }
+  const T& Back() const { return at(Tail()); }
 
-  bool Empty() const { return tail_ == 0; }
-  bool Full() const { return capacity_ - 1 == tail_ - head_; }
+  bool Empty() const { return Tail() == 0; }
+  bool Full() const { return capacity_ - 1 == Size(); }
   uint64_t Capacity() const { return capacity_; }
 
   void SetFusionCallback(const FusionCallback& callback) {
     fusion_callback_ = callback;
   }
 
+  // writers must hold Mutex()
   void Fill(const T& value) {
     if (fusion_callback_) {
       fusion_callback_(value);
     } else {
-      if (Full()) {
-        buffer_[GetIndex(head_)] = value;
-        ++head_;
-        ++tail_;
-      } else {
-        buffer_[GetIndex(tail_ + 1)] = value;
-        ++tail_;
+      uint64_t tail = tail_.load(std::memory_order_relaxed);
+      bool full = Full();
+      // the slot after the tail holds an element already behind the head,
+      // the one it replaces is released after the slot is unlocked
+      T old = value;
+      Slot& slot = slots_[GetIndex(tail + 1)];
+      Lock(&slot);
+      std::swap(old, slot.value);
+      Unlock(&slot);
+      if (full) {
+        head_.fetch_add(1, std::memory_order_release);
       }
+      tail_.store(tail + 1, std::memory_order_release);
+    }
+  }
+
+  /**
+   * @brief Copy the element at pos without taking Mutex().
+   *
+   * @return false if pos is past the tail or has been overwritten.
+   */
+  bool Load(uint64_t pos, T* value) const {
+    T copy;
+    const Slot& slot = slots_[GetIndex(pos)];
+    Lock(&slot);
+    bool valid = pos >= Head() && pos <= Tail();
+    if (valid) {
+      copy = slot.value;
     }
+    Unlock(&slot);
+    if (valid) {
+      *value = std::move(copy);
+    }
+    return valid;
   }
 
   std::mutex& Mutex() { return mutex_; }
 
  private:
+  // one cache line per element, so a writer filling the next slot does not
+  // bounce the line readers of the current one are spinning on
+  struct alignas(CACHELINE_SIZE) Slot {
+    mutable std::atomic<bool> locked = {false};
+    T value;
+  };
+
+  static constexpr int kMaxSpins = 64;
+
   CacheBuffer& operator=(const CacheBuffer& other) = delete;
   uint64_t GetIndex(const uint64_t& pos) const { return pos % capacity_; }
 
-  uint64_t head_ = 0;
-  uint64_t tail_ = 0;
+  // the lock is held for one copy, yield only if its holder got preempted
+  static void Lock(const Slot* slot) {
+    int spins = 0;
+    while (slot->locked.exchange(true, std::memory_order_acquire)) {
+      while (slot->locked.load(std::memory_order_relaxed)) {
+        if (++spins < kMaxSpins) {
+          cpu_relax();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  static void Unlock(const Slot* slot) {
+    slot->locked.store(false, std::memory_order_release);
+  }
+
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> head_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail_ = {0};
   uint64_t capacity_ = 0;
-  std::vector<T> buffer_;
+  std::unique_ptr<Slot[]> slots_;
   mutable std::mutex mutex_;
   FusionCallback fusion_callback_;
 };
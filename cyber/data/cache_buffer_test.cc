@@ -16,9 +16,12 @@
 
 #include "cyber/data/cache_buffer.h"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -53,6 +56,45 @@ TEST(CacheBufferTest, cache_buffer_test) {
   EXPECT_TRUE(buffer1.Full());
 }
 
+TEST(CacheBufferTest, concurrent_load_test) {
+  CacheBuffer<std::shared_ptr<uint64_t>> buffer(8);
+  std::shared_ptr<uint64_t> value;
+  EXPECT_FALSE(buffer.Load(1, &value));
+  const uint64_t kFillNum = 200000;
+  std::atomic<bool> done = {false};
+  std::atomic<uint64_t> mismatch = {0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      std::shared_ptr<uint64_t> value;
+      while (!done) {
+        // every element holds its own position, a torn or stale copy shows
+        // up as a mismatch
+        uint64_t tail = buffer.Tail();
+        for (uint64_t pos = buffer.Head(); pos <= tail; ++pos) {
+          if (buffer.Load(pos, &value) && *value != pos) {
+            ++mismatch;
+          }
+        }
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= kFillNum; ++i) {
+    std::lock_guard<std::mutex> lock(buffer.Mutex());
+    buffer.Fill(std::make_shared<uint64_t>(i));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0, mismatch);
+  EXPECT_EQ(kFillNum, buffer.Tail());
+  EXPECT_TRUE(buffer.Load(kFillNum - 7, &value));
+  EXPECT_EQ(kFillNum - 7, *value);
+  EXPECT_FALSE(buffer.Load(kFillNum - 8, &value));
+  EXPECT_FALSE(buffer.Load(kFillNum + 1, &value));
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
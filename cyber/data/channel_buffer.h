@@ -53,53 +53,65 @@ class ChannelBuffer {
   std::shared_ptr<BufferType> buffer_;
 };
 
+// readers do not take the buffer mutex, an element overwritten while it
+// was being copied is retried as a buffer overflow
 template <typename T>
 bool ChannelBuffer<T>::Fetch(uint64_t* index,
                              std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
-  }
-
-  if (*index == 0) {
-    *index = buffer_->Tail();
-  } else if (*index == buffer_->Tail() + 1) {
-    return false;
-  } else if (*index < buffer_->Head()) {
-    auto interval = buffer_->Tail() - *index;
-    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
-          << "read buffer overflow, drop_message[" << interval << "] pre_index["
-          << *index << "] current_index[" << buffer_->Tail() << "] ";
-    *index = buffer_->Tail();
+  while (true) {
+    uint64_t tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    if (*index == 0) {
+      *index = tail;
+    } else if (*index == tail + 1) {
+      return false;
+    } else if (*index < buffer_->Head()) {
+      auto interval = tail - *index;
+      AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+            << "read buffer overflow, drop_message[" << interval
+            << "] pre_index[" << *index << "] current_index[" << tail << "] ";
+      *index = tail;
+    }
+    if (buffer_->Load(*index, &m)) {
+      return true;
+    }
   }
-  m = buffer_->at(*index);
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
+  while (true) {
+    uint64_t tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+    if (buffer_->Load(tail, &m)) {
+      return true;
+    }
   }
-
-  m = buffer_->Back();
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
+  uint64_t tail = buffer_->Tail();
+  if (tail == 0) {
     return false;
   }
 
-  auto num = std::min(buffer_->Size(), fetch_size);
+  // the head may have passed this tail if the writer lapped the reader
+  uint64_t head = std::min(buffer_->Head(), tail);
+  auto num = std::min(tail - head + 1, fetch_size);
   vec->reserve(num);
-  for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
-       ++index) {
-    vec->emplace_back(buffer_->at(index));
+  std::shared_ptr<T> m;
+  for (auto index = tail - num + 1; index <= tail; ++index) {
+    // the oldest ones may be overwritten while the newer are copied
+    if (buffer_->Load(index, &m)) {
+      vec->emplace_back(std::move(m));
+    }
   }
   return true;
 }
@@ -16,7 +16,12 @@
 
 #include "cyber/data/channel_buffer.h"
 
+#include <atomic>
+#include <chrono>
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -98,6 +103,56 @@ TEST(ChannelBufferTest, FetchMulti) {
   EXPECT_EQ(2, *vector[1]);
 }
 
+// One publisher fills a buffer while 10 readers poll its latest message,
+// taking the buffer mutex as they used to and without it.
+TEST(ChannelBufferTest, ContentionBenchmark) {
+  const int kReaderNum = 10;
+  const uint64_t kFillNum = 1000000;
+  for (bool locked_read : {true, false}) {
+    auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(10);
+    auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
+    std::atomic<bool> done = {false};
+    std::atomic<uint64_t> reads = {0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaderNum; ++i) {
+      readers.emplace_back([&]() {
+        std::shared_ptr<int> msg;
+        uint64_t count = 0;
+        while (!done) {
+          if (locked_read) {
+            std::lock_guard<std::mutex> lock(cache_buffer->Mutex());
+            if (!cache_buffer->Empty()) {
+              msg = cache_buffer->Back();
+              ++count;
+            }
+          } else if (buffer->Latest(msg)) {
+            ++count;
+          }
+          // give the core back like a croutine waiting for the next message
+          std::this_thread::yield();
+        }
+        reads += count;
+      });
+    }
+    auto msg = std::make_shared<int>(0);
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < kFillNum; ++i) {
+      std::lock_guard<std::mutex> lock(cache_buffer->Mutex());
+      cache_buffer->Fill(msg);
+    }
+    std::chrono::duration<double, std::micro> cost =
+        std::chrono::steady_clock::now() - start;
+    done = true;
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    EXPECT_EQ(kFillNum, cache_buffer->Tail());
+    std::cout << (locked_read ? "locked" : "lock-free") << " read, "
+              << kReaderNum << " readers: " << cost.count() * 1000 / kFillNum
+              << "ns per fill, " << reads << " reads" << std::endl;
+  }
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
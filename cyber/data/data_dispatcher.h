@@ -79,6 +79,8 @@ bool DataDispatcher<T>::Dispatch(const uint64_t channel_id,
   if (buffers_map_.Get(channel_id, &buffers)) {
     for (auto& buffer_wptr : *buffers) {
       if (auto buffer = buffer_wptr.lock()) {
+        // only serializes publishers of this channel, readers fetch from
+        // the buffer without its mutex
         std::lock_guard<std::mutex> lock(buffer->Mutex());
         buffer->Fill(msg);
       }
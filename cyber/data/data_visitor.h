@@ -20,6 +20,9 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -28,6 +31,7 @@
 #include "cyber/data/data_visitor_base.h"
 #include "cyber/data/fusion/all_latest.h"
 #include "cyber/data/fusion/data_fusion.h"
+#include "cyber/data/fusion/time_window.h"
 
 namespace apollo {
 namespace cyber {
@@ -43,69 +47,19 @@ struct VisitorConfig {
 template <typename T>
 using BufferType = CacheBuffer<std::shared_ptr<T>>;
 
-template <typename M0, typename M1 = NullType, typename M2 = NullType,
-          typename M3 = NullType>
+/**
+ * Fuses the messages of all channels each time the first one receives a
+ * message. With a zero time_window the latest message of every other
+ * channel is taken, see fusion::AllLatest. Otherwise the one nearest in time
+ * within time_window nanoseconds is, see fusion::TimeWindow, which needs
+ * fusion::MessageTime for every message type.
+ */
+template <typename M0, typename... M>
 class DataVisitor : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
-      : buffer_m0_(configs[0].channel_id,
-                   new BufferType<M0>(configs[0].queue_size)),
-        buffer_m1_(configs[1].channel_id,
-                   new BufferType<M1>(configs[1].queue_size)),
-        buffer_m2_(configs[2].channel_id,
-                   new BufferType<M2>(configs[2].queue_size)),
-        buffer_m3_(configs[3].channel_id,
-                   new BufferType<M3>(configs[3].queue_size)) {
-    DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
-    DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
-    DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
-    DataDispatcher<M3>::Instance()->AddBuffer(buffer_m3_);
-    data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
-        buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
-  }
-
-  ~DataVisitor() {
-    if (data_fusion_) {
-      delete data_fusion_;
-      data_fusion_ = nullptr;
-    }
-  }
-
-  bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,    // NOLINT
-                std::shared_ptr<M2>& m2, std::shared_ptr<M3>& m3) {  // NOLINT
-    if (data_fusion_->Fusion(&next_msg_index_, m0, m1, m2, m3)) {
-      next_msg_index_++;
-      return true;
-    }
-    return false;
-  }
-
- private:
-  fusion::DataFusion<M0, M1, M2, M3>* data_fusion_ = nullptr;
-  ChannelBuffer<M0> buffer_m0_;
-  ChannelBuffer<M1> buffer_m1_;
-  ChannelBuffer<M2> buffer_m2_;
-  ChannelBuffer<M3> buffer_m3_;
-};
-
-template <typename M0, typename M1, typename M2>
-class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
- public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
-      : buffer_m0_(configs[0].channel_id,
-                   new BufferType<M0>(configs[0].queue_size)),
-        buffer_m1_(configs[1].channel_id,
-                   new BufferType<M1>(configs[1].queue_size)),
-        buffer_m2_(configs[2].channel_id,
-                   new BufferType<M2>(configs[2].queue_size)) {
-    DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
-    DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
-    DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
-    data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ =
-        new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_, buffer_m2_);
-  }
+  explicit DataVisitor(const std::vector<VisitorConfig>& configs,
+                       uint64_t time_window = 0)
+      : DataVisitor(configs, time_window, std::index_sequence_for<M...>()) {}
 
   ~DataVisitor() {
     if (data_fusion_) {
@@ -114,9 +68,8 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
     }
   }
 
-  bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,  // NOLINT
-                std::shared_ptr<M2>& m2) {                         // NOLINT
-    if (data_fusion_->Fusion(&next_msg_index_, m0, m1, m2)) {
+  bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M>&... m) {  // NOLINT
+    if (data_fusion_->Fusion(&next_msg_index_, m0, m...)) {
       next_msg_index_++;
       return true;
     }
@@ -124,49 +77,40 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
   }
 
  private:
-  fusion::DataFusion<M0, M1, M2>* data_fusion_ = nullptr;
-  ChannelBuffer<M0> buffer_m0_;
-  ChannelBuffer<M1> buffer_m1_;
-  ChannelBuffer<M2> buffer_m2_;
-};
-
-template <typename M0, typename M1>
-class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
- public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  template <std::size_t... I>
+  DataVisitor(const std::vector<VisitorConfig>& configs, uint64_t time_window,
+              std::index_sequence<I...>)
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
-        buffer_m1_(configs[1].channel_id,
-                   new BufferType<M1>(configs[1].queue_size)) {
+        buffers_(ChannelBuffer<M>(
+            configs[I + 1].channel_id,
+            new BufferType<M>(configs[I + 1].queue_size))...) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
-    DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
+    (DataDispatcher<M>::Instance()->AddBuffer(std::get<I>(buffers_)), ...);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
-  }
-
-  ~DataVisitor() {
-    if (data_fusion_) {
-      delete data_fusion_;
-      data_fusion_ = nullptr;
-    }
-  }
-
-  bool TryFetch(std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1) {  // NOLINT
-    if (data_fusion_->Fusion(&next_msg_index_, m0, m1)) {
-      next_msg_index_++;
-      return true;
+    if constexpr (std::conjunction<fusion::HasMessageTime<M0>,
+                                   fusion::HasMessageTime<M>...>::value) {
+      if (time_window > 0) {
+        data_fusion_ = new fusion::TimeWindow<M0, M...>(
+            time_window, buffer_m0_, std::get<I>(buffers_)...);
+        return;
+      }
+    } else if (time_window > 0) {
+      AWARN << "No fusion::MessageTime for the messages of channel["
+            << buffer_m0_.channel_id()
+            << "], fuse the latest ones instead of aligning them in time.";
     }
-    return false;
+    data_fusion_ =
+        new fusion::AllLatest<M0, M...>(buffer_m0_, std::get<I>(buffers_)...);
   }
 
- private:
-  fusion::DataFusion<M0, M1>* data_fusion_ = nullptr;
+  fusion::DataFusion<M0, M...>* data_fusion_ = nullptr;
   ChannelBuffer<M0> buffer_m0_;
-  ChannelBuffer<M1> buffer_m1_;
+  std::tuple<ChannelBuffer<M>...> buffers_;
 };
 
 template <typename M0>
-class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
+class DataVisitor<M0> : public DataVisitorBase {
  public:
   explicit DataVisitor(const VisitorConfig& configs)
       : buffer_(configs.channel_id, new BufferType<M0>(configs.queue_size)) {
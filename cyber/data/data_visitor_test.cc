@@ -16,8 +16,11 @@
 
 #include "cyber/data/data_visitor.h"
 
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -34,6 +37,13 @@ using apollo::cyber::message::RawMessage;
 using apollo::cyber::proto::RoleAttributes;
 std::hash<std::string> str_hash;
 
+namespace fusion {
+template <>
+struct MessageTime<RawMessage> {
+  static uint64_t Get(const RawMessage& m) { return m.timestamp; }
+};
+}  // namespace fusion
+
 auto channel0 = str_hash("/channel0");
 auto channel1 = str_hash("/channel1");
 auto channel2 = str_hash("/channel2");
@@ -46,6 +56,12 @@ void DispatchMessage(uint64_t channel_id, int num) {
   }
 }
 
+void DispatchMessage(uint64_t channel_id, const std::string& data,
+                     uint64_t timestamp) {
+  auto raw_msg = std::make_shared<RawMessage>(data, timestamp);
+  DataDispatcher<RawMessage>::Instance()->Dispatch(channel_id, raw_msg);
+}
+
 std::vector<VisitorConfig> InitConfigs(int num) {
   std::vector<VisitorConfig> configs;
   configs.reserve(num);
@@ -139,6 +155,85 @@ TEST(DataVisitorTest, four_channel) {
   EXPECT_FALSE(dv->TryFetch(msg0, msg1, msg2, msg3));
 }
 
+TEST(DataVisitorTest, six_channel_time_window) {
+  auto configs = InitConfigs(6);
+  auto dv = std::make_shared<DataVisitor<RawMessage, RawMessage, RawMessage,
+                                         RawMessage, RawMessage, RawMessage>>(
+      configs, 30);
+
+  std::shared_ptr<RawMessage> msg0, msg1, msg2, msg3, msg4, msg5;
+  for (int i = 1; i < 6; ++i) {
+    DispatchMessage(configs[i].channel_id, "old", 0);
+    DispatchMessage(configs[i].channel_id, "near", 100 + i * 5);
+    DispatchMessage(configs[i].channel_id, "new", 200);
+  }
+  DispatchMessage(configs[0].channel_id, "0", 100);
+  EXPECT_TRUE(dv->TryFetch(msg0, msg1, msg2, msg3, msg4, msg5));
+  EXPECT_EQ(std::string("near"), msg1->message);
+  EXPECT_EQ(std::string("near"), msg5->message);
+  EXPECT_EQ(uint64_t{125}, msg5->timestamp);
+  DispatchMessage(configs[0].channel_id, "0", 150);
+  EXPECT_FALSE(dv->TryFetch(msg0, msg1, msg2, msg3, msg4, msg5));
+}
+
+// time of a fused tuple from the dispatch of every channel to the fetch
+template <typename... M>
+void BenchmarkDispatch(uint64_t time_window) {
+  const uint64_t kTupleNum = 20000;
+  const uint64_t kPeriod = 10000000;
+  const size_t kChannelNum = sizeof...(M) + 1;
+  static int run = 0;
+  std::vector<VisitorConfig> configs;
+  std::vector<std::vector<std::shared_ptr<RawMessage>>> messages(kChannelNum);
+  for (size_t i = 0; i < kChannelNum; ++i) {
+    configs.emplace_back(
+        str_hash("/benchmark" + std::to_string(run) + "_" + std::to_string(i)),
+        10);
+    // the other sensors lag the first one by up to a fifth of the period
+    for (uint64_t t = 0; t < kTupleNum; ++t) {
+      messages[i].emplace_back(std::make_shared<RawMessage>(
+          "", t * kPeriod + i * kPeriod / 25));
+    }
+  }
+  ++run;
+  auto dv = std::make_shared<DataVisitor<RawMessage, M...>>(configs,
+                                                             time_window);
+  auto dispatcher = DataDispatcher<RawMessage>::Instance();
+  std::shared_ptr<RawMessage> msg0;
+  std::tuple<std::shared_ptr<M>...> msgs;
+  auto try_fetch = [&dv, &msg0](std::shared_ptr<M>&... msg) {  // NOLINT
+    return dv->TryFetch(msg0, msg...);
+  };
+
+  uint64_t fused = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t t = 0; t < kTupleNum; ++t) {
+    for (size_t i = kChannelNum - 1; i > 0; --i) {
+      dispatcher->Dispatch(configs[i].channel_id, messages[i][t]);
+    }
+    dispatcher->Dispatch(configs[0].channel_id, messages[0][t]);
+    if (std::apply(try_fetch, msgs)) {
+      ++fused;
+    }
+  }
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(kTupleNum, fused);
+  std::cout << kChannelNum << " channels, "
+            << (time_window > 0 ? "time window" : "all latest") << ": "
+            << cost.count() / kTupleNum << "ns per fused tuple" << std::endl;
+}
+
+TEST(DataVisitorTest, DispatchBenchmark) {
+  const uint64_t kTimeWindow = 5000000;
+  for (uint64_t time_window : {uint64_t{0}, kTimeWindow}) {
+    BenchmarkDispatch<RawMessage>(time_window);
+    BenchmarkDispatch<RawMessage, RawMessage, RawMessage>(time_window);
+    BenchmarkDispatch<RawMessage, RawMessage, RawMessage, RawMessage,
+                      RawMessage>(time_window);
+  }
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
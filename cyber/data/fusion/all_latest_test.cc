@@ -147,6 +147,39 @@ TEST(AllLatestTest, four_channels) {
   EXPECT_EQ(std::string("3-0"), m3->message);
 }
 
+TEST(AllLatestTest, six_channels) {
+  std::vector<CacheBuffer<std::shared_ptr<RawMessage>>*> caches;
+  std::vector<ChannelBuffer<RawMessage>> buffers;
+  for (uint64_t i = 0; i < 6; ++i) {
+    caches.push_back(new CacheBuffer<std::shared_ptr<RawMessage>>(10));
+    buffers.emplace_back(i, caches.back());
+  }
+  std::shared_ptr<RawMessage> m0, m1, m2, m3, m4, m5;
+  uint64_t index = 0;
+  fusion::AllLatest<RawMessage, RawMessage, RawMessage, RawMessage, RawMessage,
+                    RawMessage>
+      fusion(buffers[0], buffers[1], buffers[2], buffers[3], buffers[4],
+             buffers[5]);
+
+  // normal fusion
+  for (uint64_t i = 1; i < 6; ++i) {
+    caches[0]->Fill(std::make_shared<RawMessage>("0-0"));
+    EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2, m3, m4, m5));
+    caches[i]->Fill(std::make_shared<RawMessage>(std::to_string(i) + "-0"));
+  }
+  caches[3]->Fill(std::make_shared<RawMessage>("3-1"));
+  caches[0]->Fill(std::make_shared<RawMessage>("0-1"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1, m2, m3, m4, m5));
+  index++;
+  EXPECT_EQ(std::string("0-1"), m0->message);
+  EXPECT_EQ(std::string("1-0"), m1->message);
+  EXPECT_EQ(std::string("2-0"), m2->message);
+  EXPECT_EQ(std::string("3-1"), m3->message);
+  EXPECT_EQ(std::string("4-0"), m4->message);
+  EXPECT_EQ(std::string("5-0"), m5->message);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2, m3, m4, m5));
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_FUSION_TIME_WINDOW_H_
+#define CYBER_DATA_FUSION_TIME_WINDOW_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "cyber/data/channel_buffer.h"
+#include "cyber/data/fusion/data_fusion.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+/**
+ * Stamp in nanoseconds TimeWindow aligns messages by. Messages with a
+ * header use header().timestamp_sec(), specialize this with a static
+ * uint64_t Get(const M&) for other message types.
+ */
+template <typename M, typename Enable = void>
+struct MessageTime {};
+
+template <typename M>
+struct MessageTime<M, std::void_t<decltype(
+                          std::declval<const M&>().header().timestamp_sec())>> {
+  static uint64_t Get(const M& m) {
+    return static_cast<uint64_t>(m.header().timestamp_sec() * 1e9);
+  }
+};
+
+template <typename M, typename Enable = void>
+struct HasMessageTime : std::false_type {};
+
+template <typename M>
+struct HasMessageTime<M, std::void_t<decltype(MessageTime<M>::Get(
+                             std::declval<const M&>()))>> : std::true_type {};
+
+/**
+ * Fuses each message of the first channel with the message of every other
+ * channel whose stamp is nearest to its own, if that one is at most window
+ * nanoseconds away. Only messages still in the channel buffers are
+ * considered, and when a channel has none in the window the message of the
+ * first channel is not fused. The buffers are scanned from the newest
+ * message back and the scan stops at the first one older than the window,
+ * so it takes a few steps per channel when messages arrive in stamp order.
+ */
+template <typename M0, typename... M>
+class TimeWindow : public DataFusion<M0, M...> {
+  using FusionDataType = std::tuple<std::shared_ptr<M0>, std::shared_ptr<M>...>;
+
+ public:
+  TimeWindow(uint64_t window, const ChannelBuffer<M0>& buffer_0,
+             const ChannelBuffer<M>&... buffers)
+      : window_(window),
+        buffer_m0_(buffer_0),
+        buffers_(buffers...),
+        buffer_fusion_(buffer_m0_.channel_id(),
+                       new CacheBuffer<std::shared_ptr<FusionDataType>>(
+                           buffer_0.Buffer()->Capacity() - uint64_t(1))) {
+    buffer_m0_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M0>& m0) {
+          auto fusion_data = std::make_shared<FusionDataType>();
+          std::get<0>(*fusion_data) = m0;
+          if (!FillNearest(MessageTime<M0>::Get(*m0), fusion_data.get(),
+                           std::index_sequence_for<M...>())) {
+            return;
+          }
+
+          std::lock_guard<std::mutex> lg(buffer_fusion_.Buffer()->Mutex());
+          buffer_fusion_.Buffer()->Fill(fusion_data);
+        });
+  }
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0,  // NOLINT
+              std::shared_ptr<M>&... m) override {       // NOLINT
+    std::shared_ptr<FusionDataType> fusion_data;
+    if (!buffer_fusion_.Fetch(index, fusion_data)) {
+      return false;
+    }
+    std::tie(m0, m...) = *fusion_data;
+    return true;
+  }
+
+ private:
+  template <std::size_t... I>
+  bool FillNearest(uint64_t stamp, FusionDataType* data,
+                   std::index_sequence<I...>) {
+    return (Nearest(stamp, std::get<I>(buffers_), &std::get<I + 1>(*data)) &&
+            ...);
+  }
+
+  template <typename T>
+  bool Nearest(uint64_t stamp, const ChannelBuffer<T>& buffer,
+               std::shared_ptr<T>* nearest) {
+    auto cache = buffer.Buffer();
+    uint64_t nearest_diff = 0;
+    std::shared_ptr<T> m;
+    // Load fails once the position falls behind the head
+    for (uint64_t pos = cache->Tail(); pos > 0 && cache->Load(pos, &m);
+         --pos) {
+      uint64_t time = MessageTime<T>::Get(*m);
+      uint64_t diff = time > stamp ? time - stamp : stamp - time;
+      if (diff <= window_ && (*nearest == nullptr || diff < nearest_diff)) {
+        nearest_diff = diff;
+        *nearest = std::move(m);
+      }
+      if (time < stamp && diff > window_) {
+        break;
+      }
+    }
+    return *nearest != nullptr;
+  }
+
+  uint64_t window_;
+  ChannelBuffer<M0> buffer_m0_;
+  std::tuple<ChannelBuffer<M>...> buffers_;
+  ChannelBuffer<FusionDataType> buffer_fusion_;
+};
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_FUSION_TIME_WINDOW_H_
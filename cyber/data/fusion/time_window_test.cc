@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/fusion/time_window.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/raw_message.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+using apollo::cyber::message::RawMessage;
+
+template <>
+struct MessageTime<RawMessage> {
+  static uint64_t Get(const RawMessage& m) { return m.timestamp; }
+};
+
+struct StampedHeader {
+  double timestamp_sec() const { return 1.5; }
+};
+
+struct StampedMessage {
+  StampedHeader header() const { return StampedHeader(); }
+};
+
+static_assert(HasMessageTime<RawMessage>::value, "specialized");
+static_assert(HasMessageTime<StampedMessage>::value, "has a header");
+static_assert(!HasMessageTime<int>::value, "has no stamp");
+
+std::shared_ptr<RawMessage> Stamped(const std::string& data, uint64_t time) {
+  return std::make_shared<RawMessage>(data, time);
+}
+
+TEST(TimeWindowTest, header_stamp) {
+  EXPECT_EQ(uint64_t{1500000000},
+            MessageTime<StampedMessage>::Get(StampedMessage()));
+}
+
+TEST(TimeWindowTest, two_channels) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<RawMessage>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<RawMessage>>(10);
+  ChannelBuffer<RawMessage> buffer0(0, cache0);
+  ChannelBuffer<RawMessage> buffer1(1, cache1);
+  std::shared_ptr<RawMessage> m0;
+  std::shared_ptr<RawMessage> m1;
+  uint64_t index = 0;
+  TimeWindow<RawMessage, RawMessage> fusion(50, buffer0, buffer1);
+
+  // nothing to align with
+  cache0->Fill(Stamped("0-0", 100));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+
+  cache1->Fill(Stamped("1-0", 100));
+  cache1->Fill(Stamped("1-1", 200));
+  cache1->Fill(Stamped("1-2", 300));
+
+  // nearest older message, not the latest one
+  cache0->Fill(Stamped("0-1", 210));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ(std::string("0-1"), m0->message);
+  EXPECT_EQ(std::string("1-1"), m1->message);
+
+  // nearest newer message
+  cache0->Fill(Stamped("0-2", 260));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ(std::string("1-2"), m1->message);
+
+  // both neighbours out of the window
+  cache0->Fill(Stamped("0-3", 500));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+
+  // window bounds are inclusive
+  cache0->Fill(Stamped("0-4", 50));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ(std::string("0-4"), m0->message);
+  EXPECT_EQ(std::string("1-0"), m1->message);
+}
+
+TEST(TimeWindowTest, overwritten_messages) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<RawMessage>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<RawMessage>>(2);
+  ChannelBuffer<RawMessage> buffer0(0, cache0);
+  ChannelBuffer<RawMessage> buffer1(1, cache1);
+  std::shared_ptr<RawMessage> m0;
+  std::shared_ptr<RawMessage> m1;
+  uint64_t index = 0;
+  TimeWindow<RawMessage, RawMessage> fusion(10, buffer0, buffer1);
+
+  for (uint64_t i = 0; i < 5; ++i) {
+    cache1->Fill(Stamped("1-" + std::to_string(i), i * 100));
+  }
+  // only the last two are still in the buffer
+  cache0->Fill(Stamped("0-0", 200));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache0->Fill(Stamped("0-1", 305));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_EQ(std::string("1-3"), m1->message);
+}
+
+TEST(TimeWindowTest, six_channels) {
+  std::vector<CacheBuffer<std::shared_ptr<RawMessage>>*> caches;
+  std::vector<ChannelBuffer<RawMessage>> buffers;
+  for (uint64_t i = 0; i < 6; ++i) {
+    caches.push_back(new CacheBuffer<std::shared_ptr<RawMessage>>(10));
+    buffers.emplace_back(i, caches.back());
+  }
+  std::shared_ptr<RawMessage> m0, m1, m2, m3, m4, m5;
+  uint64_t index = 0;
+  TimeWindow<RawMessage, RawMessage, RawMessage, RawMessage, RawMessage,
+             RawMessage>
+      fusion(30, buffers[0], buffers[1], buffers[2], buffers[3], buffers[4],
+             buffers[5]);
+
+  // channel i publishes every 100ns with an offset of 10 * i
+  for (uint64_t i = 1; i < 6; ++i) {
+    for (uint64_t t = 0; t < 3; ++t) {
+      caches[i]->Fill(Stamped(std::to_string(i) + "-" + std::to_string(t),
+                              t * 100 + i * 10));
+    }
+  }
+
+  caches[0]->Fill(Stamped("0-0", 110));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2, m3, m4, m5));
+  caches[0]->Fill(Stamped("0-1", 120));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1, m2, m3, m4, m5));
+  EXPECT_EQ(std::string("1-1"), m1->message);
+  EXPECT_EQ(std::string("2-1"), m2->message);
+  EXPECT_EQ(std::string("3-1"), m3->message);
+  EXPECT_EQ(std::string("4-1"), m4->message);
+  EXPECT_EQ(std::string("5-1"), m5->message);
+}
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
@@ -16,12 +16,16 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 
 #include "cyber/base/macros.h"
+#include "cyber/common/log.h"
 #include "cyber/logger/logger_util.h"
 
 namespace apollo {
@@ -31,11 +35,50 @@ namespace logger {
 static const std::unordered_map<char, int> log_level_map = {
     {'F', 3}, {'E', 2}, {'W', 1}, {'I', 0}};
 
-AsyncLogger::AsyncLogger(google::base::Logger* wrapped) : wrapped_(wrapped) {
-  active_buf_.reset(new std::deque<Msg>());
-  flushing_buf_.reset(new std::deque<Msg>());
+namespace {
+
+// records of each writing thread, about 300KB
+constexpr uint64_t kRingCapacity = 1024;
+// below this many messages per pass the logger thread sleeps before the next
+constexpr size_t kBusyMessageCount = 800;
+
+std::atomic<uint64_t> next_logger_id = {0};
+
+}  // namespace
+
+void AsyncLogger::Msg::Assign(
+    const std::chrono::system_clock::time_point& timestamp,
+    const char* message, size_t message_len) {
+  ts = timestamp;
+  len = message_len;
+  if (len > kDataSize) {
+    overflow.assign(message, len);
+  } else {
+    memcpy(data, message, len);
+  }
+}
+
+AsyncLogger::MsgRing::MsgRing(uint64_t capacity)
+    : mask_(capacity - 1), msgs_(new Msg[capacity]) {}
+
+bool AsyncLogger::MsgRing::Push(
+    const std::chrono::system_clock::time_point& timestamp,
+    const char* message, size_t message_len) {
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - cached_head_ > mask_) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    if (tail - cached_head_ > mask_) {
+      return false;
+    }
+  }
+  At(tail)->Assign(timestamp, message, message_len);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
 }
 
+AsyncLogger::AsyncLogger(google::base::Logger* wrapped)
+    : wrapped_(wrapped), id_(next_logger_id.fetch_add(1)) {}
+
 AsyncLogger::~AsyncLogger() { Stop(); }
 
 void AsyncLogger::Start() {
@@ -51,9 +94,7 @@ void AsyncLogger::Stop() {
     log_thread_.join();
   }
 
-  FlushBuffer(active_buf_);
-  ACHECK(active_buf_->empty());
-  ACHECK(flushing_buf_->empty());
+  FlushRings();
   // std::cout << "Async Logger Stop!" << std::endl;
 }
 
@@ -65,13 +106,11 @@ void AsyncLogger::Write(bool force_flush,
     return;
   }
   if (message_len > 0) {
-    auto msg_str = std::string(message, message_len);
-    while (flag_.test_and_set(std::memory_order_acquire)) {
-      cpu_relax();
+    MsgRing* ring = ThreadRing();
+    if (cyber_unlikely(ring == nullptr ||
+                       !ring->Push(timestamp, message, message_len))) {
+      drop_count_.fetch_add(1, std::memory_order_relaxed);
     }
-    active_buf_->emplace_back(timestamp, std::move(msg_str),
-                              log_level_map.at(message[0]));
-    flag_.clear(std::memory_order_release);
   }
 
   if (force_flush && timestamp == std::chrono::system_clock::time_point{} &&
@@ -88,42 +127,130 @@ void AsyncLogger::Flush() {
 
 uint32_t AsyncLogger::LogSize() { return wrapped_->LogSize(); }
 
+AsyncLogger::MsgRing* AsyncLogger::ThreadRing() {
+  // stays valid after thread_rings is destroyed, for logging from other
+  // thread local destructors
+  static thread_local bool exited = false;
+  struct ThreadRings {
+    ~ThreadRings() {
+      exited = true;
+      for (auto& ring : rings) {
+        ring.second->orphaned.store(true, std::memory_order_release);
+      }
+    }
+    std::vector<std::pair<uint64_t, std::shared_ptr<MsgRing>>> rings;
+  };
+  static thread_local ThreadRings thread_rings;
+  if (cyber_unlikely(exited)) {
+    return nullptr;
+  }
+  for (auto& ring : thread_rings.rings) {
+    if (ring.first == id_) {
+      return ring.second.get();
+    }
+  }
+  auto ring = std::make_shared<MsgRing>(kRingCapacity);
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(ring);
+  }
+  thread_rings.rings.emplace_back(id_, ring);
+  return ring.get();
+}
+
 void AsyncLogger::RunThread() {
+  uint64_t reported_drop_count = 0;
   while (state_ == RUNNING) {
-    while (flag_.test_and_set(std::memory_order_acquire)) {
-      cpu_relax();
+    size_t count = FlushRings();
+    uint64_t drop_count = DropCount();
+    if (drop_count != reported_drop_count) {
+      AWARN << "Async logger dropped " << drop_count - reported_drop_count
+            << " log messages, writers outpaced the log thread.";
+      reported_drop_count = drop_count;
     }
-    active_buf_.swap(flushing_buf_);
-    flag_.clear(std::memory_order_release);
-    FlushBuffer(flushing_buf_);
-    if (active_buf_->size() < 800) {
+    if (count < kBusyMessageCount) {
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
   }
 }
 
-void AsyncLogger::FlushBuffer(const std::unique_ptr<std::deque<Msg>>& buffer) {
-  std::string module_name = "";
-  while (!buffer->empty()) {
-    auto& msg = buffer->front();
-    FindModuleName(&(msg.message), &module_name);
-
-    if (module_logger_map_.find(module_name) == module_logger_map_.end()) {
-      std::string file_name = module_name + ".log.INFO.";
-      if (!FLAGS_log_dir.empty()) {
-        file_name = FLAGS_log_dir + "/" + file_name;
-      }
-      module_logger_map_[module_name].reset(
-          new LogFileObject(google::INFO, file_name.c_str()));
-      module_logger_map_[module_name]->SetSymlinkBasename(module_name.c_str());
+size_t AsyncLogger::FlushRings() {
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    flushing_rings_ = rings_;
+  }
+  // take what each ring holds now, messages written meanwhile go next time
+  std::vector<uint64_t> tails;
+  tails.reserve(flushing_rings_.size());
+  flushing_msgs_.clear();
+  size_t writing_rings = 0;
+  for (auto& ring : flushing_rings_) {
+    uint64_t tail = ring->Tail();
+    tails.push_back(tail);
+    if (ring->Head() != tail) {
+      ++writing_rings;
     }
-    const bool force_flush = msg.level > 0;
-    module_logger_map_.find(module_name)
-        ->second->Write(force_flush, msg.ts, msg.message.data(),
-                        static_cast<int>(msg.message.size()));
-    buffer->pop_front();
+    for (uint64_t pos = ring->Head(); pos != tail; ++pos) {
+      flushing_msgs_.push_back(ring->At(pos));
+    }
+  }
+  if (writing_rings > 1) {
+    std::stable_sort(flushing_msgs_.begin(), flushing_msgs_.end(),
+                     [](const Msg* lhs, const Msg* rhs) {
+                       return lhs->ts < rhs->ts;
+                     });
+  }
+
+  std::string module_name = "";
+  for (auto msg : flushing_msgs_) {
+    WriteMsg(*msg, &module_name);
+  }
+  for (size_t i = 0; i < flushing_rings_.size(); ++i) {
+    flushing_rings_[i]->Pop(tails[i]);
   }
   Flush();
+
+  // drop the rings of exited threads once they are drained
+  bool has_orphans = false;
+  for (size_t i = 0; i < flushing_rings_.size(); ++i) {
+    if (flushing_rings_[i]->orphaned.load(std::memory_order_acquire) &&
+        flushing_rings_[i]->Tail() == tails[i]) {
+      has_orphans = true;
+    }
+  }
+  if (has_orphans) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const std::shared_ptr<MsgRing>& ring) {
+                                  return ring->orphaned.load(
+                                             std::memory_order_acquire) &&
+                                         ring->Head() == ring->Tail();
+                                }),
+                 rings_.end());
+  }
+  flushing_rings_.clear();
+  return flushing_msgs_.size();
+}
+
+void AsyncLogger::WriteMsg(const Msg& msg, std::string* module_name) {
+  // level and module are parsed here rather than by the writing thread
+  flushing_message_.assign(msg.Data(), msg.len);
+  FindModuleName(&flushing_message_, module_name);
+
+  if (module_logger_map_.find(*module_name) == module_logger_map_.end()) {
+    std::string file_name = *module_name + ".log.INFO.";
+    if (!FLAGS_log_dir.empty()) {
+      file_name = FLAGS_log_dir + "/" + file_name;
+    }
+    module_logger_map_[*module_name].reset(
+        new LogFileObject(google::INFO, file_name.c_str()));
+    module_logger_map_[*module_name]->SetSymlinkBasename(module_name->c_str());
+  }
+  auto level = log_level_map.find(msg.Data()[0]);
+  const bool force_flush = level != log_level_map.end() && level->second > 0;
+  module_logger_map_.find(*module_name)
+      ->second->Write(force_flush, msg.ts, flushing_message_.data(),
+                      static_cast<int>(flushing_message_.size()));
 }
 
 }  // namespace logger
@@ -21,7 +21,6 @@
 #include <condition_variable>
 #include <cstdint>
 #include <ctime>
-#include <deque>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -33,6 +32,7 @@
 
 #include "glog/logging.h"
 
+#include "cyber/base/macros.h"
 #include "cyber/common/macros.h"
 #include "cyber/logger/log_file_object.h"
 
@@ -45,16 +45,17 @@ namespace logger {
  * @brief .
  * Wrapper for a glog Logger which asynchronously writes log messages.
  * This class starts a new thread responsible for forwarding the messages
- * to the logger, and performs double buffering. Writers append to the
- * current buffer and then wake up the logger thread. The logger swaps in
- * a new buffer and writes any accumulated messages to the wrapped
- * Logger.
+ * to the logger. Every writing thread owns a ring of preallocated records
+ * and copies its formatted message into the next free one, without locks
+ * or allocations. The logger thread drains all rings, merges the records
+ * by time, and only then parses their level and module and writes them to
+ * the module log files.
  *
- * This double-buffering design dramatically improves performance, especially
- * for logging messages which require flushing the underlying file (i.e WARNING
- * and above for default). The flush can take a couple of milliseconds, and in
- * some cases can even block for hundreds of milliseconds or more. With the
- * double-buffered approach, threads can proceed with useful work while the IO
+ * This design dramatically improves performance, especially for logging
+ * messages which require flushing the underlying file (i.e WARNING and above
+ * for default). The flush can take a couple of milliseconds, and in some
+ * cases can even block for hundreds of milliseconds or more. With the
+ * asynchronous approach, threads can proceed with useful work while the IO
  * thread blocks.
  *
  * The semantics provided by this wrapper are slightly weaker than the default
@@ -66,9 +67,9 @@ namespace logger {
  * worth it. We do take care that a glog FATAL message flushes all buffered log
  * messages before exiting.
  *
- * @warning The logger limits the total amount of buffer space, so if the
- * underlying log blocks for too long, eventually the threads generating the log
- * messages will block as well. This prevents runaway memory usage.
+ * @warning The logger limits the buffer space of each thread, so if the
+ * underlying log blocks for too long, messages of threads whose ring is full
+ * are dropped and counted rather than blocking the threads generating them.
  */
 class AsyncLogger : public google::base::Logger {
  public:
@@ -126,50 +127,69 @@ class AsyncLogger : public google::base::Logger {
    */
   std::thread* LogThread() { return &log_thread_; }
 
+  /**
+   * @brief Get the number of messages dropped because the ring of the
+   * writing thread was full.
+   *
+   * @return the dropped message count
+   */
+  uint64_t DropCount() const {
+    return drop_count_.load(std::memory_order_relaxed);
+  }
+
  private:
-  // A buffered message.
-  //
-  // TODO(todd): using std::string for buffered messages is convenient but not
-  // as efficient as it could be. It's better to make the buffers just be
-  // Arenas and allocate both the message data and Msg struct from them, forming
-  // a linked list.
+  // A buffered message, copied as formatted by glog. Messages longer than
+  // the record are kept in overflow.
   struct Msg {
-    std::chrono::system_clock::time_point ts;
-    std::string message;
-    int32_t level;
-    Msg()
-        : ts(std::chrono::system_clock::duration::zero()),
-          message(),
-          level(google::INFO) {}
-    Msg(std::chrono::system_clock::time_point ts, std::string&& message,
-        int32_t level)
-        : ts(ts), message(std::move(message)), level(level) {}
-    Msg(const Msg& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-    }
-    Msg(Msg&& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-    }
-    Msg& operator=(Msg&& rsh) {
-      ts = rsh.ts;
-      message = std::move(rsh.message);
-      level = rsh.level;
-      return *this;
-    }
-    Msg& operator=(const Msg& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-      return *this;
+    static constexpr size_t kDataSize = 256;
+
+    void Assign(const std::chrono::system_clock::time_point& timestamp,
+                const char* message, size_t message_len);
+    const char* Data() const {
+      return len > kDataSize ? overflow.data() : data;
     }
+
+    std::chrono::system_clock::time_point ts;
+    size_t len = 0;
+    std::string overflow;
+    char data[kDataSize];
+  };
+
+  // Records of one writing thread, which is the only producer, while the
+  // logger thread is the only consumer.
+  class MsgRing {
+   public:
+    explicit MsgRing(uint64_t capacity);
+
+    // false if the ring is full
+    bool Push(const std::chrono::system_clock::time_point& timestamp,
+              const char* message, size_t message_len);
+
+    // records from Head() up to Tail() may be read by the consumer, until
+    // it releases them with Pop
+    uint64_t Head() const { return head_.load(std::memory_order_relaxed); }
+    uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+    Msg* At(uint64_t pos) { return &msgs_[pos & mask_]; }
+    void Pop(uint64_t pos) { head_.store(pos, std::memory_order_release); }
+
+    // set when the writing thread exits
+    std::atomic<bool> orphaned = {false};
+
+   private:
+    const uint64_t mask_;
+    std::unique_ptr<Msg[]> msgs_;
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> head_ = {0};
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail_ = {0};
+    // producer side copy of head_, refreshed only when the ring looks full
+    uint64_t cached_head_ = 0;
   };
 
   void RunThread();
-  void FlushBuffer(const std::unique_ptr<std::deque<Msg>>& msg);
+  // writes out everything buffered so far, returns the message count
+  size_t FlushRings();
+  void WriteMsg(const Msg& msg, std::string* module_name);
+  // the ring of the calling thread, nullptr while the thread exits
+  MsgRing* ThreadRing();
 
   google::base::Logger* const wrapped_;
   std::thread log_thread_;
@@ -180,19 +200,24 @@ class AsyncLogger : public google::base::Logger {
 
   // Count of how many times the writer thread has dropped the log messages.
   // 64 bits should be enough to never worry about overflow.
-  uint64_t drop_count_ = 0;
+  std::atomic<uint64_t> drop_count_ = {0};
+
+  // Distinguishes the rings of this logger from those a thread keeps for
+  // other loggers.
+  const uint64_t id_;
 
-  // The buffer to which application threads append new log messages.
-  std::unique_ptr<std::deque<Msg>> active_buf_;
+  // The rings of all threads that have written to this logger.
+  std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<MsgRing>> rings_;
 
-  // The buffer currently being flushed by the logger thread, cleared
-  // after a successful flush.
-  std::unique_ptr<std::deque<Msg>> flushing_buf_;
+  // Used by the logger thread only, kept to reuse their memory.
+  std::vector<std::shared_ptr<MsgRing>> flushing_rings_;
+  std::vector<Msg*> flushing_msgs_;
+  std::string flushing_message_;
 
   // Trigger for the logger thread to stop.
   enum State { INITTED, RUNNING, STOPPED };
   std::atomic<State> state_ = {INITTED};
-  std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
   std::unordered_map<std::string, std::unique_ptr<LogFileObject>>
       module_logger_map_;
 
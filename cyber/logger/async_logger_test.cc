@@ -16,6 +16,12 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "glog/logging.h"
@@ -69,6 +75,63 @@ TEST(AsyncLoggerTest, SetLoggerToGlog) {
   google::ShutdownGoogleLogging();
 }
 
+std::string TestMessage(const std::string& module) {
+  std::string message = "I0909 99:99:99.999999 99999 logger_test.cc:999] ";
+  message.append(LEFT_BRACKET);
+  message.append(module);
+  message.append(RIGHT_BRACKET);
+  message.append("async logger test message\n");
+  return message;
+}
+
+TEST(AsyncLoggerTest, WriteFromThreads) {
+  AsyncLogger logger(google::base::GetLogger(google::INFO));
+  logger.Start();
+  const std::string message = TestMessage("AsyncLoggerTest3");
+  // fewer messages per thread than its ring holds, none can be dropped
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 16; ++i) {
+    threads.emplace_back([&logger, &message]() {
+      for (int j = 0; j < 1000; ++j) {
+        logger.Write(false, std::chrono::system_clock::now(), message.c_str(),
+                     message.length());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  logger.Stop();
+  EXPECT_EQ(0, logger.DropCount());
+}
+
+TEST(AsyncLoggerTest, WriteBenchmark) {
+  const int kThreadNum = 16;
+  const int kWriteNum = 10000;
+  AsyncLogger logger(google::base::GetLogger(google::INFO));
+  logger.Start();
+  const std::string message = TestMessage("AsyncLoggerTest4");
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&logger, &message]() {
+      for (int j = 0; j < kWriteNum; ++j) {
+        logger.Write(false, std::chrono::system_clock::now(), message.c_str(),
+                     message.length());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+  logger.Stop();
+  std::cout << kThreadNum << " threads: "
+            << kThreadNum * kWriteNum / cost.count() << " log calls/sec, "
+            << logger.DropCount() << " of " << kThreadNum * kWriteNum
+            << " dropped" << std::endl;
+}
+
 }  // namespace logger
 }  // namespace cyber
 }  // namespace apollo
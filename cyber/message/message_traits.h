@@ -17,6 +17,7 @@
 #ifndef CYBER_MESSAGE_MESSAGE_TRAITS_H_
 #define CYBER_MESSAGE_MESSAGE_TRAITS_H_
 
+#include <memory>
 #include <string>
 
 #include "cyber/base/macros.h"
@@ -40,6 +41,7 @@ DEFINE_TYPE_TRAIT(HasSerializeToString, SerializeToString)
 DEFINE_TYPE_TRAIT(HasParseFromString, ParseFromString)
 DEFINE_TYPE_TRAIT(HasSerializeToArray, SerializeToArray)
 DEFINE_TYPE_TRAIT(HasParseFromArray, ParseFromArray)
+DEFINE_TYPE_TRAIT(HasParseFromLeasedArray, ParseFromLeasedArray)
 
 template <typename T>
 class HasSerializer {
@@ -153,6 +155,23 @@ ParseFromArray(const void* data, int size, T* message) {
   return false;
 }
 
+// Messages that can reference a lent buffer keep `lease` alive instead of
+// copying, all the others are parsed as usual.
+template <typename T>
+typename std::enable_if<HasParseFromLeasedArray<T>::value, bool>::type
+ParseFromLeasedArray(const void* data, int size,
+                     const std::shared_ptr<const void>& lease, T* message) {
+  return message->ParseFromLeasedArray(data, size, lease);
+}
+
+template <typename T>
+typename std::enable_if<!HasParseFromLeasedArray<T>::value, bool>::type
+ParseFromLeasedArray(const void* data, int size,
+                     const std::shared_ptr<const void>& lease, T* message) {
+  (void)lease;
+  return ParseFromArray(data, size, message);
+}
+
 template <typename T>
 typename std::enable_if<HasParseFromString<T>::value, bool>::type
 ParseFromString(const std::string& str, T* message) {
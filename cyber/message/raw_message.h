@@ -21,6 +21,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "cyber/message/protobuf_factory.h"
 
@@ -36,9 +37,19 @@ struct RawMessage {
   RawMessage(const std::string &data, uint64_t ts)
       : message(data), timestamp(ts) {}
 
+  // take over the payload instead of copying it
+  explicit RawMessage(std::string &&data)
+      : message(std::move(data)), timestamp(0) {}
+
+  RawMessage(std::string &&data, uint64_t ts)
+      : message(std::move(data)), timestamp(ts) {}
+
   RawMessage(const RawMessage &raw_msg)
       : message(raw_msg.message), timestamp(raw_msg.timestamp) {}
 
+  RawMessage(RawMessage &&raw_msg) noexcept
+      : message(std::move(raw_msg.message)), timestamp(raw_msg.timestamp) {}
+
   RawMessage &operator=(const RawMessage &raw_msg) {
     if (this != &raw_msg) {
       this->message = raw_msg.message;
@@ -47,6 +58,14 @@ struct RawMessage {
     return *this;
   }
 
+  RawMessage &operator=(RawMessage &&raw_msg) noexcept {
+    if (this != &raw_msg) {
+      this->message = std::move(raw_msg.message);
+      this->timestamp = raw_msg.timestamp;
+    }
+    return *this;
+  }
+
   ~RawMessage() {}
 
   class Descriptor {
@@ -96,6 +115,13 @@ struct RawMessage {
     return true;
   }
 
+  // a name of its own, an overload would hide ParseFromString from the
+  // HasParseFromString trait
+  bool ParseFromMovedString(std::string &&str) {
+    message = std::move(str);
+    return true;
+  }
+
   int ByteSize() const { return static_cast<int>(message.size()); }
 
   static std::string TypeName() { return "apollo.cyber.message.RawMessage"; }
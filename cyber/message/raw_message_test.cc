@@ -18,6 +18,7 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
 
 #include "gtest/gtest.h"
 
@@ -33,6 +34,31 @@ TEST(RawMessageTest, constructor) {
   EXPECT_EQ(msg_b.message, "raw");
 }
 
+TEST(RawMessageTest, move) {
+  std::string payload(1024, 'x');
+  const char* payload_data = payload.data();
+  RawMessage msg_a(std::move(payload), 1);
+  EXPECT_EQ(msg_a.message.data(), payload_data);
+  EXPECT_EQ(msg_a.timestamp, 1);
+
+  RawMessage msg_b(std::move(msg_a));
+  EXPECT_EQ(msg_b.message.data(), payload_data);
+  EXPECT_EQ(msg_b.timestamp, 1);
+
+  RawMessage msg_c;
+  msg_c = std::move(msg_b);
+  EXPECT_EQ(msg_c.message.data(), payload_data);
+
+  RawMessage msg_d(msg_c);
+  EXPECT_NE(msg_d.message.data(), payload_data);
+  EXPECT_EQ(msg_d.message, msg_c.message);
+
+  std::string other(512, 'y');
+  const char* other_data = other.data();
+  EXPECT_TRUE(msg_d.ParseFromMovedString(std::move(other)));
+  EXPECT_EQ(msg_d.message.data(), other_data);
+}
+
 TEST(RawMessageTest, serialize_to_array) {
   RawMessage msg("serialize_to_array");
   EXPECT_FALSE(msg.SerializeToArray(nullptr, 128));
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "cyber/message/raw_message.h"
+#include "cyber/message/raw_message_view.h"
 
 namespace apollo {
 namespace cyber {
@@ -38,6 +39,21 @@ inline bool ParseFromArray(const void* data, int size, RawMessage* message) {
 
 inline int ByteSize(const RawMessage& message) { return message.ByteSize(); }
 
+// Template specialization for RawMessageView
+inline bool SerializeToArray(const RawMessageView& message, void* data,
+                             int size) {
+  return message.SerializeToArray(data, size);
+}
+
+inline bool ParseFromArray(const void* data, int size,
+                           RawMessageView* message) {
+  return message->ParseFromArray(data, size);
+}
+
+inline int ByteSize(const RawMessageView& message) {
+  return message.ByteSize();
+}
+
 }  // namespace message
 }  // namespace cyber
 }  // namespace apollo
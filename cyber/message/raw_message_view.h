@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_RAW_MESSAGE_VIEW_H_
+#define CYBER_MESSAGE_RAW_MESSAGE_VIEW_H_
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "cyber/message/protobuf_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+/**
+ * @brief Read-only serialized payload that may point into memory it does not
+ * own, e.g. a shared memory block received by ShmDispatcher. `lease` keeps
+ * that memory valid (for shm: holds the block's read lock) for as long as
+ * any copy of the view is alive, so drop views of large messages as soon as
+ * they are no longer needed.
+ *
+ * Transports that cannot lend their buffer fall back to ParseFromArray,
+ * which copies the payload into storage owned by the view.
+ */
+struct RawMessageView {
+  RawMessageView() : timestamp(0) {}
+
+  explicit RawMessageView(const std::string &data) : timestamp(0) {
+    ParseFromString(data);
+  }
+
+  explicit RawMessageView(std::string &&data) : timestamp(0) {
+    ParseFromMovedString(std::move(data));
+  }
+
+  const char *data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // true if the payload lives in a lent buffer instead of a private copy
+  bool is_leased() const { return leased_; }
+
+  class Descriptor {
+   public:
+    std::string full_name() const {
+      return "apollo.cyber.message.RawMessageView";
+    }
+    std::string name() const { return "apollo.cyber.message.RawMessageView"; }
+  };
+
+  static const Descriptor *descriptor() {
+    static Descriptor desc;
+    return &desc;
+  }
+
+  static void GetDescriptorString(const std::string &type,
+                                  std::string *desc_str) {
+    ProtobufFactory::Instance()->GetDescriptorString(type, desc_str);
+  }
+
+  bool SerializeToArray(void *data, int size) const {
+    if (data == nullptr || size < ByteSize()) {
+      return false;
+    }
+
+    if (size_ > 0) {
+      memcpy(data, data_, size_);
+    }
+    return true;
+  }
+
+  bool SerializeToString(std::string *str) const {
+    if (str == nullptr) {
+      return false;
+    }
+    str->assign(data_ == nullptr ? "" : data_, size_);
+    return true;
+  }
+
+  bool ParseFromArray(const void *data, int size) {
+    if (data == nullptr || size <= 0) {
+      return false;
+    }
+
+    auto copy = std::make_shared<std::string>(
+        reinterpret_cast<const char *>(data), size);
+    data_ = copy->data();
+    size_ = copy->size();
+    lease_ = copy;
+    leased_ = false;
+    return true;
+  }
+
+  bool ParseFromString(const std::string &str) {
+    auto copy = std::make_shared<std::string>(str);
+    data_ = copy->data();
+    size_ = copy->size();
+    lease_ = copy;
+    leased_ = false;
+    return true;
+  }
+
+  // take over `str`, copies of the view then share it without copying. Not
+  // an overload of ParseFromString, which would hide it from the
+  // HasParseFromString trait
+  bool ParseFromMovedString(std::string &&str) {
+    auto buffer = std::make_shared<std::string>(std::move(str));
+    data_ = buffer->data();
+    size_ = buffer->size();
+    lease_ = buffer;
+    leased_ = false;
+    return true;
+  }
+
+  // zero copy: share a buffer that nobody modifies any more
+  bool ParseFromSharedString(const std::shared_ptr<const std::string> &buffer) {
+    if (buffer == nullptr) {
+      return false;
+    }
+
+    data_ = buffer->data();
+    size_ = buffer->size();
+    lease_ = buffer;
+    leased_ = false;
+    return true;
+  }
+
+  // zero copy: reference `data` directly and keep `lease` until released
+  bool ParseFromLeasedArray(const void *data, int size,
+                            const std::shared_ptr<const void> &lease) {
+    if (data == nullptr || size <= 0 || lease == nullptr) {
+      return false;
+    }
+
+    data_ = reinterpret_cast<const char *>(data);
+    size_ = size;
+    lease_ = lease;
+    leased_ = true;
+    return true;
+  }
+
+  /**
+   * @brief View of `size` bytes from `offset` that shares the payload and its
+   * lease, e.g. one message of a record chunk held in memory. Returns an
+   * empty view if the range is out of bounds.
+   */
+  RawMessageView Slice(std::size_t offset, std::size_t size) const {
+    RawMessageView slice;
+    if (offset > size_ || size > size_ - offset) {
+      return slice;
+    }
+    slice.data_ = data_ + offset;
+    slice.size_ = size;
+    slice.lease_ = lease_;
+    slice.leased_ = leased_;
+    slice.timestamp = timestamp;
+    return slice;
+  }
+
+  // drop the payload, and with it the lease, before the view is destroyed
+  void Release() {
+    data_ = nullptr;
+    size_ = 0;
+    lease_ = nullptr;
+    leased_ = false;
+  }
+
+  int ByteSize() const { return static_cast<int>(size_); }
+
+  static std::string TypeName() {
+    return "apollo.cyber.message.RawMessageView";
+  }
+
+  uint64_t timestamp;
+
+ private:
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::shared_ptr<const void> lease_;
+  bool leased_ = false;
+};
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_RAW_MESSAGE_VIEW_H_
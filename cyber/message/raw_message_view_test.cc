@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/raw_message_view.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/message_traits.h"
+#include "cyber/message/raw_message.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+TEST(RawMessageViewTest, parse_copies) {
+  RawMessageView view;
+  EXPECT_TRUE(view.empty());
+
+  std::string str("parse_from_array");
+  EXPECT_FALSE(view.ParseFromArray(nullptr, static_cast<int>(str.size())));
+  EXPECT_TRUE(view.ParseFromArray(str.data(), static_cast<int>(str.size())));
+  EXPECT_FALSE(view.is_leased());
+  EXPECT_NE(view.data(), str.data());
+  EXPECT_EQ(std::string(view.data(), view.size()), str);
+
+  RawMessageView from_string("parse_from_string");
+  std::string out;
+  EXPECT_TRUE(from_string.SerializeToString(&out));
+  EXPECT_EQ(out, "parse_from_string");
+}
+
+TEST(RawMessageViewTest, leased_array) {
+  auto buffer = std::make_shared<std::string>("leased");
+  std::weak_ptr<std::string> weak_buffer = buffer;
+
+  auto view = std::make_shared<RawMessageView>();
+  EXPECT_TRUE(ParseFromLeasedArray(buffer->data(),
+                                   static_cast<int>(buffer->size()), buffer,
+                                   view.get()));
+  buffer = nullptr;
+  EXPECT_FALSE(weak_buffer.expired());
+  EXPECT_TRUE(view->is_leased());
+  EXPECT_EQ(std::string(view->data(), view->size()), "leased");
+
+  char buf[16] = {0};
+  EXPECT_TRUE(view->SerializeToArray(buf, sizeof(buf)));
+  EXPECT_EQ(memcmp(buf, "leased", 6), 0);
+
+  // copies share the lease
+  RawMessageView copy = *view;
+  view = nullptr;
+  EXPECT_FALSE(weak_buffer.expired());
+  copy.Release();
+  EXPECT_TRUE(weak_buffer.expired());
+}
+
+TEST(RawMessageViewTest, shared_buffer) {
+  std::string payload(1024, 'x');
+  const char* payload_data = payload.data();
+  RawMessageView moved(std::move(payload));
+  EXPECT_EQ(moved.data(), payload_data);
+  EXPECT_EQ(moved.size(), 1024);
+
+  std::string other(512, 'y');
+  const char* other_data = other.data();
+  EXPECT_TRUE(moved.ParseFromMovedString(std::move(other)));
+  EXPECT_EQ(moved.data(), other_data);
+  EXPECT_EQ(moved.size(), 512);
+
+  auto buffer = std::make_shared<const std::string>("chunk:msg_a:msg_b");
+  RawMessageView view;
+  EXPECT_FALSE(view.ParseFromSharedString(nullptr));
+  EXPECT_TRUE(view.ParseFromSharedString(buffer));
+  EXPECT_EQ(view.data(), buffer->data());
+  EXPECT_FALSE(view.is_leased());
+
+  auto slice = view.Slice(12, 5);
+  EXPECT_EQ(std::string(slice.data(), slice.size()), "msg_b");
+  EXPECT_EQ(slice.data(), buffer->data() + 12);
+  EXPECT_TRUE(view.Slice(12, 6).empty());
+  EXPECT_TRUE(view.Slice(18, 1).empty());
+
+  // the slice keeps the whole buffer alive
+  std::weak_ptr<const std::string> weak_buffer = buffer;
+  buffer = nullptr;
+  view.Release();
+  EXPECT_FALSE(weak_buffer.expired());
+  slice.Release();
+  EXPECT_TRUE(weak_buffer.expired());
+}
+
+TEST(RawMessageViewTest, leased_fallback) {
+  auto buffer = std::make_shared<std::string>("fallback");
+  RawMessage msg;
+  EXPECT_TRUE(ParseFromLeasedArray(buffer->data(),
+                                   static_cast<int>(buffer->size()), buffer,
+                                   &msg));
+  EXPECT_EQ(msg.message, "fallback");
+  EXPECT_EQ(buffer.use_count(), 1);
+}
+
+TEST(RawMessageViewTest, message_type) {
+  EXPECT_EQ(RawMessageView::TypeName(), "apollo.cyber.message.RawMessageView");
+  EXPECT_EQ(RawMessageView::descriptor()->full_name(),
+            "apollo.cyber.message.RawMessageView");
+  EXPECT_TRUE(HasSerializer<RawMessageView>::value);
+
+  std::string str("parse_from_string");
+  RawMessageView view;
+  EXPECT_TRUE(ParseFromString(str, &view));
+  EXPECT_EQ(std::string(view.data(), view.size()), str);
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
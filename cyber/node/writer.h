@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/proto/topology_change.pb.h"
@@ -75,6 +76,16 @@ class Writer : public WriterBase {
    */
   virtual bool Write(const MessageT& msg);
 
+  /**
+   * @brief Write a MessageT instance that is no longer needed, it is moved
+   * instead of copied into the published message
+   *
+   * @param msg the message we want to write
+   * @return true if write successfully
+   * @return false if write failed
+   */
+  virtual bool Write(MessageT&& msg);
+
   /**
    * @brief Write a shared ptr of MessageT
    *
@@ -163,6 +174,13 @@ bool Writer<MessageT>::Write(const MessageT& msg) {
   return Write(msg_ptr);
 }
 
+template <typename MessageT>
+bool Writer<MessageT>::Write(MessageT&& msg) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  auto msg_ptr = std::make_shared<MessageT>(std::move(msg));
+  return Write(msg_ptr);
+}
+
 template <typename MessageT>
 bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   RETURN_VAL_IF(!WriterBase::IsInit(), false);
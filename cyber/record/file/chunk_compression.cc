@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_compression.h"
+
+#include <limits>
+
+#include "lz4.h"
+#include "zstd.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::CompressType;
+
+namespace {
+
+// fast levels, recording must keep up with the sensors
+const int kZstdLevel = 1;
+
+}  // namespace
+
+bool IsCompressSupported(CompressType type) {
+  return type == CompressType::COMPRESS_NONE ||
+         type == CompressType::COMPRESS_LZ4 ||
+         type == CompressType::COMPRESS_ZSTD;
+}
+
+bool CompressChunk(CompressType type, const std::string& raw,
+                   std::string* compressed) {
+  switch (type) {
+    case CompressType::COMPRESS_LZ4: {
+      if (raw.size() > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+        AERROR << "chunk of " << raw.size() << " bytes is too large for lz4.";
+        return false;
+      }
+      int bound = LZ4_compressBound(static_cast<int>(raw.size()));
+      compressed->resize(bound);
+      int size = LZ4_compress_default(raw.data(), &(*compressed)[0],
+                                      static_cast<int>(raw.size()), bound);
+      if (size <= 0) {
+        AERROR << "lz4 compress chunk failed.";
+        return false;
+      }
+      compressed->resize(size);
+      return true;
+    }
+    case CompressType::COMPRESS_ZSTD: {
+      compressed->resize(ZSTD_compressBound(raw.size()));
+      size_t size = ZSTD_compress(&(*compressed)[0], compressed->size(),
+                                  raw.data(), raw.size(), kZstdLevel);
+      if (ZSTD_isError(size)) {
+        AERROR << "zstd compress chunk failed: " << ZSTD_getErrorName(size);
+        return false;
+      }
+      compressed->resize(size);
+      return true;
+    }
+    default:
+      AERROR << "unsupported chunk compress type: " << type;
+      return false;
+  }
+}
+
+bool DecompressChunk(CompressType type, const char* data, size_t size,
+                     size_t raw_size, std::string* raw) {
+  raw->resize(raw_size);
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      if (size != raw_size) {
+        AERROR << "chunk size mismatch, expect: " << raw_size
+               << ", actual: " << size;
+        return false;
+      }
+      raw->assign(data, size);
+      return true;
+    case CompressType::COMPRESS_LZ4: {
+      if (size > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+          raw_size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        AERROR << "chunk is too large for lz4.";
+        return false;
+      }
+      int ret = LZ4_decompress_safe(data, &(*raw)[0], static_cast<int>(size),
+                                    static_cast<int>(raw_size));
+      if (ret < 0 || static_cast<size_t>(ret) != raw_size) {
+        AERROR << "lz4 decompress chunk failed, ret: " << ret;
+        return false;
+      }
+      return true;
+    }
+    case CompressType::COMPRESS_ZSTD: {
+      size_t ret = ZSTD_decompress(&(*raw)[0], raw_size, data, size);
+      if (ZSTD_isError(ret) || ret != raw_size) {
+        AERROR << "zstd decompress chunk failed: "
+               << (ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch");
+        return false;
+      }
+      return true;
+    }
+    default:
+      AERROR << "unsupported chunk compress type: " << type;
+      return false;
+  }
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
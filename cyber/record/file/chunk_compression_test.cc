@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_compression.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::CompressType;
+
+namespace {
+
+// A chunk shaped like a lidar + camera recording: 10 point clouds of
+// x/y/z/intensity floats, 10 already-compressed camera images and 100
+// localization poses.
+std::string SampleChunk() {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+  ChunkBody body;
+  uint64_t time = 1000000000ULL;
+  for (int frame = 0; frame < 10; ++frame) {
+    std::string cloud(120000 * 4 * sizeof(float), '\0');
+    auto points = reinterpret_cast<float*>(&cloud[0]);
+    for (int i = 0; i < 120000; ++i) {
+      float angle = static_cast<float>(i % 1800) * 0.0035f;
+      float range = 10.0f + static_cast<float>(i / 1800) * 0.5f + noise(gen);
+      points[i * 4] = range * std::cos(angle);
+      points[i * 4 + 1] = range * std::sin(angle);
+      points[i * 4 + 2] = -1.7f + static_cast<float>(i / 1800) * 0.05f;
+      points[i * 4 + 3] = static_cast<float>(i % 97);
+    }
+    auto msg = body.add_messages();
+    msg->set_channel_name("/apollo/sensor/lidar/PointCloud2");
+    msg->set_time(time + frame * 100000000ULL);
+    msg->set_content(cloud);
+
+    std::string image(300 * 1024, '\0');
+    for (auto& c : image) {
+      c = static_cast<char>(gen());
+    }
+    msg = body.add_messages();
+    msg->set_channel_name("/apollo/sensor/camera/front_6mm/image/compressed");
+    msg->set_time(time + frame * 100000000ULL + 1000);
+    msg->set_content(image);
+  }
+  for (int i = 0; i < 100; ++i) {
+    auto msg = body.add_messages();
+    msg->set_channel_name("/apollo/localization/pose");
+    msg->set_time(time + i * 10000000ULL);
+    msg->set_content("header { timestamp_sec: " + std::to_string(1.0 + i * 0.01) +
+                     " module_name: \"localization\" sequence_num: " +
+                     std::to_string(i) + " } pose { position { x: " +
+                     std::to_string(587000.0 + i * 0.1) + " y: " +
+                     std::to_string(4141000.0 + i * 0.05) + " z: 0 } }");
+  }
+  std::string raw;
+  body.SerializeToString(&raw);
+  return raw;
+}
+
+}  // namespace
+
+TEST(ChunkCompressionTest, round_trip) {
+  std::string raw = SampleChunk();
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    ASSERT_TRUE(IsCompressSupported(type));
+    std::string compressed;
+    ASSERT_TRUE(CompressChunk(type, raw, &compressed));
+    EXPECT_LT(compressed.size(), raw.size());
+    std::string restored;
+    ASSERT_TRUE(DecompressChunk(type, compressed.data(), compressed.size(),
+                                raw.size(), &restored));
+    EXPECT_EQ(restored, raw);
+
+    // truncated or mis-sized input is rejected
+    EXPECT_FALSE(DecompressChunk(type, compressed.data(),
+                                 compressed.size() / 2, raw.size(), &restored));
+    EXPECT_FALSE(DecompressChunk(type, compressed.data(), compressed.size(),
+                                 raw.size() + 1, &restored));
+  }
+  EXPECT_FALSE(IsCompressSupported(CompressType::COMPRESS_BZ2));
+  std::string compressed;
+  EXPECT_FALSE(CompressChunk(CompressType::COMPRESS_BZ2, raw, &compressed));
+}
+
+TEST(ChunkCompressionTest, throughput_benchmark) {
+  const int kRounds = 5;
+  std::string raw = SampleChunk();
+  double raw_mb = static_cast<double>(raw.size()) / (1024 * 1024);
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    std::string compressed;
+    std::string restored;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+      ASSERT_TRUE(CompressChunk(type, raw, &compressed));
+    }
+    std::chrono::duration<double> compress_s =
+        std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+      ASSERT_TRUE(DecompressChunk(type, compressed.data(), compressed.size(),
+                                  raw.size(), &restored));
+    }
+    std::chrono::duration<double> decompress_s =
+        std::chrono::steady_clock::now() - start;
+    std::cout << proto::CompressType_Name(type) << ": " << raw_mb
+              << "MB chunk, ratio "
+              << static_cast<double>(raw.size()) / compressed.size()
+              << ", compress " << raw_mb * kRounds / compress_s.count()
+              << "MB/s, decompress "
+              << raw_mb * kRounds / decompress_s.count() << "MB/s"
+              << std::endl;
+  }
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -14,8 +14,13 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <atomic>
 #include <chrono>
+#include <iostream>
+#include <string>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -109,6 +114,98 @@ TEST(RecordFileTest, SmallMessageHighThroughputOKThreadJitter) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+// Reads a multi-GB record cold from disk through read() and through the
+// mapping, dropping the page cache of the file before each run.
+TEST(RecordFileTest, MmapReadThroughput) {
+  static constexpr int64_t kFileSize = 2LL * 1024 * 1024 * 1024;
+  static const std::string kContent(1024 * 1024, 'x');
+  {
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile));
+    proto::Header hdr =
+        HeaderBuilder::GetHeaderWithChunkParams(0, 8 * 1024 * 1024);
+    hdr.set_segment_interval(0);
+    hdr.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw.WriteHeader(hdr));
+    proto::SingleMessage msg;
+    msg.set_channel_name("pointcloud");
+    msg.set_content(kContent);
+    for (int64_t i = 1; i <= kFileSize / static_cast<int64_t>(kContent.size());
+         ++i) {
+      msg.set_time(i * 100000000);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+  }
+
+  for (bool use_mmap : {false, true}) {
+    int fd = open(kTestFile, O_RDONLY);
+    ASSERT_GE(fd, 0);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+
+    RecordFileReader reader(use_mmap);
+    ASSERT_TRUE(reader.Open(kTestFile));
+    auto start = std::chrono::steady_clock::now();
+    proto::ChunkHeader chdr;
+    proto::ChunkBody body;
+    uint64_t bytes = 0;
+    Section section;
+    while (reader.ReadSection(&section)) {
+      if (section.type == proto::SectionType::SECTION_CHUNK_HEADER) {
+        ASSERT_TRUE(reader.ReadSection<proto::ChunkHeader>(section.size, &chdr));
+      } else if (section.type == proto::SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(reader.ReadChunkBody(section.size, chdr, &body));
+        bytes += section.size;
+      } else {
+        ASSERT_TRUE(reader.SkipSection(section.size));
+      }
+    }
+    std::chrono::duration<double> cost =
+        std::chrono::steady_clock::now() - start;
+    std::cout << (use_mmap ? "mmap" : "read") << ": "
+              << bytes / (1024.0 * 1024.0) / cost.count() << "MB/s"
+              << std::endl;
+  }
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(RecordFileTest, ParallelFlushThroughput) {
+  static constexpr int64_t kFileSize = 1LL * 1024 * 1024 * 1024;
+  // lidar-like payload, compressible but not trivially
+  std::string content(1024 * 1024, '\0');
+  for (size_t i = 0; i < content.size(); ++i) {
+    content[i] = static_cast<char>((i * 2654435761u >> 7) % 61);
+  }
+  for (size_t threads : {1, 4}) {
+    RecordFileWriter rfw;
+    rfw.SetFlushThreads(threads);
+    ASSERT_TRUE(rfw.Open(kTestFile));
+    proto::Header hdr =
+        HeaderBuilder::GetHeaderWithChunkParams(0, 16 * 1024 * 1024);
+    hdr.set_segment_interval(0);
+    hdr.set_segment_raw_size(0);
+    hdr.set_compress(proto::CompressType::COMPRESS_LZ4);
+    ASSERT_TRUE(rfw.WriteHeader(hdr));
+    proto::SingleMessage msg;
+    msg.set_channel_name("pointcloud");
+    msg.set_content(content);
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 1; i <= kFileSize / static_cast<int64_t>(content.size());
+         ++i) {
+      msg.set_time(i * 10000000);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+    std::chrono::duration<double> cost =
+        std::chrono::steady_clock::now() - start;
+    std::cout << threads << " flush threads: "
+              << kFileSize / (1024.0 * 1024.0) / cost.count() << "MB/s"
+              << std::endl;
+    ASSERT_FALSE(remove(kTestFile));
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -16,12 +16,24 @@
 
 #include "cyber/record/file/record_file_reader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compression.h"
 
 namespace apollo {
 namespace cyber {
 namespace record {
 
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::SectionType;
 
 bool RecordFileReader::Open(const std::string& path) {
@@ -38,6 +50,24 @@ bool RecordFileReader::Open(const std::string& path) {
     return false;
   }
   end_of_file_ = false;
+  chunk_positions_.clear();
+  if (use_mmap_) {
+    struct stat file_stat;
+    void* addr = MAP_FAILED;
+    if (fstat(fd_, &file_stat) == 0 && file_stat.st_size > 0) {
+      addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd_, 0);
+    }
+    if (addr == MAP_FAILED) {
+      AWARN << "Map file failed, read it instead, file: " << path_
+            << ", errno: " << errno;
+    } else {
+      mapped_ = static_cast<const char*>(addr);
+      mapped_size_ = file_stat.st_size;
+      mapped_pos_ = 0;
+      advised_end_ = 0;
+      madvise(addr, mapped_size_, MADV_SEQUENTIAL);
+    }
+  }
   if (!ReadHeader()) {
     AERROR << "Read header section fail, file: " << path_;
     return false;
@@ -46,6 +76,10 @@ bool RecordFileReader::Open(const std::string& path) {
 }
 
 void RecordFileReader::Close() {
+  if (mapped_ != nullptr) {
+    munmap(const_cast<char*>(mapped_), mapped_size_);
+    mapped_ = nullptr;
+  }
   if (fd_ >= 0) {
     close(fd_);
     fd_ = -1;
@@ -110,11 +144,104 @@ bool RecordFileReader::ReadIndex() {
     AERROR << "Read index section fail.";
     return false;
   }
+
+  // chunks are not always flushed in time order, so keep them in file
+  // order with a running max of end times to search on
+  chunk_positions_.clear();
+  for (const auto& single_idx : index_.indexes()) {
+    if (single_idx.type() == SectionType::SECTION_CHUNK_HEADER &&
+        single_idx.has_chunk_header_cache()) {
+      chunk_positions_.push_back(
+          {static_cast<int64_t>(single_idx.position()),
+           single_idx.chunk_header_cache().end_time()});
+    }
+  }
+  std::sort(chunk_positions_.begin(), chunk_positions_.end(),
+            [](const ChunkPosition& lhs, const ChunkPosition& rhs) {
+              return lhs.position < rhs.position;
+            });
+  for (size_t i = 1; i < chunk_positions_.size(); ++i) {
+    chunk_positions_[i].end_time = std::max(chunk_positions_[i].end_time,
+                                            chunk_positions_[i - 1].end_time);
+  }
   Reset();
   return true;
 }
 
+bool RecordFileReader::SeekTime(uint64_t begin_time) {
+  if (chunk_positions_.empty()) {
+    return true;
+  }
+  auto it = std::lower_bound(
+      chunk_positions_.begin(), chunk_positions_.end(), begin_time,
+      [](const ChunkPosition& chunk, uint64_t time) {
+        return chunk.end_time < time;
+      });
+  // past the last chunk, go straight to the index section
+  int64_t position = it == chunk_positions_.end()
+                         ? static_cast<int64_t>(header_.index_position())
+                         : it->position;
+  if (position <= CurrentPosition()) {
+    return true;
+  }
+  return SetPosition(position);
+}
+
+int64_t RecordFileReader::CurrentPosition() {
+  if (mapped_ != nullptr) {
+    return mapped_pos_;
+  }
+  return RecordFileBase::CurrentPosition();
+}
+
+bool RecordFileReader::SetPosition(int64_t position) {
+  if (mapped_ == nullptr) {
+    return RecordFileBase::SetPosition(position);
+  }
+  if (position < 0 || position > mapped_size_) {
+    AERROR << "Position " << position << " out of file, file: " << path_
+           << ", size: " << mapped_size_;
+    return false;
+  }
+  // restart readahead from wherever we land outside the prefetched range
+  if (position < mapped_pos_ || position > advised_end_) {
+    advised_end_ = position;
+  }
+  mapped_pos_ = position;
+  return true;
+}
+
+void RecordFileReader::Readahead() {
+  if (readahead_ == 0 ||
+      mapped_pos_ + static_cast<int64_t>(readahead_ / 2) < advised_end_) {
+    return;
+  }
+  static const int64_t page_size = sysconf(_SC_PAGESIZE);
+  int64_t begin = std::max(mapped_pos_, advised_end_) / page_size * page_size;
+  int64_t end = std::min(mapped_pos_ + static_cast<int64_t>(readahead_),
+                         mapped_size_);
+  if (end > begin) {
+    madvise(const_cast<char*>(mapped_) + begin, end - begin, MADV_WILLNEED);
+  }
+  advised_end_ = end;
+}
+
 bool RecordFileReader::ReadSection(Section* section) {
+  if (mapped_ != nullptr) {
+    if (mapped_pos_ == mapped_size_) {
+      end_of_file_ = true;
+      AINFO << "Reach end of file.";
+      return false;
+    }
+    if (mapped_size_ - mapped_pos_ < static_cast<int64_t>(sizeof(Section))) {
+      AERROR << "Truncated section at " << mapped_pos_ << ", file: " << path_;
+      return false;
+    }
+    Readahead();
+    memcpy(section, mapped_ + mapped_pos_, sizeof(struct Section));
+    mapped_pos_ += sizeof(struct Section);
+    return true;
+  }
   ssize_t count = read(fd_, section, sizeof(struct Section));
   if (count < 0) {
     AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
@@ -132,6 +259,160 @@ bool RecordFileReader::ReadSection(Section* section) {
   return true;
 }
 
+bool RecordFileReader::ReadChunkBody(int64_t size,
+                                     const proto::ChunkHeader& chunk_header,
+                                     proto::ChunkBody* chunk_body) {
+  if (chunk_header.compress() == CompressType::COMPRESS_NONE) {
+    return ReadSection<proto::ChunkBody>(size, chunk_body);
+  }
+  if (size < 0) {
+    AERROR << "Invalid chunk body size: " << size;
+    return false;
+  }
+  std::string buffer;
+  const char* data = nullptr;
+  if (!ReadBytes(size, &buffer, &data)) {
+    AERROR << "Read chunk body failed.";
+    return false;
+  }
+  std::string raw;
+  if (!DecompressChunk(chunk_header.compress(), data, size,
+                       chunk_header.uncompressed_size(), &raw)) {
+    AERROR << "Decompress chunk body failed.";
+    return false;
+  }
+  if (!chunk_body->ParseFromString(raw)) {
+    AERROR << "Parse chunk body failed.";
+    return false;
+  }
+  return true;
+}
+
+bool RecordFileReader::ReadChunkBody(
+    int64_t size, const proto::ChunkHeader& chunk_header,
+    const proto::ChunkBodyCache& chunk_body_cache,
+    const std::set<std::string>& channels, proto::ChunkBody* chunk_body) {
+  if (size < 0) {
+    AERROR << "Invalid chunk body size: " << size;
+    return false;
+  }
+  uint64_t body_size = chunk_header.compress() == CompressType::COMPRESS_NONE
+                           ? static_cast<uint64_t>(size)
+                           : chunk_header.uncompressed_size();
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  for (const auto& cache : chunk_body_cache.channel_messages()) {
+    if (channels.count(cache.name()) == 0) {
+      continue;
+    }
+    if (cache.offsets_size() != cache.sizes_size()) {
+      AERROR << "Broken message index of channel " << cache.name();
+      return false;
+    }
+    for (int i = 0; i < cache.offsets_size(); ++i) {
+      if (cache.offsets(i) > body_size ||
+          cache.sizes(i) > body_size - cache.offsets(i)) {
+        AERROR << "Message index out of chunk body, offset: "
+               << cache.offsets(i) << ", size: " << cache.sizes(i);
+        return false;
+      }
+      ranges.emplace_back(cache.offsets(i), cache.sizes(i));
+    }
+  }
+  // keep the order messages were written in
+  std::sort(ranges.begin(), ranges.end());
+  chunk_body->mutable_messages()->Reserve(static_cast<int>(ranges.size()));
+
+  if (chunk_header.compress() != CompressType::COMPRESS_NONE) {
+    std::string buffer;
+    const char* data = nullptr;
+    std::string raw;
+    if (!ReadBytes(size, &buffer, &data) ||
+        !DecompressChunk(chunk_header.compress(), data, size, body_size,
+                         &raw)) {
+      AERROR << "Read compressed chunk body failed.";
+      return false;
+    }
+    for (const auto& range : ranges) {
+      if (!chunk_body->add_messages()->ParseFromArray(
+              raw.data() + range.first, static_cast<int>(range.second))) {
+        AERROR << "Parse message at offset " << range.first << " failed.";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // the payloads of other channels are never read from disk
+  int64_t body_pos = CurrentPosition();
+  if (mapped_ != nullptr) {
+    if (size > mapped_size_ - body_pos) {
+      AERROR << "Chunk body runs past the end of file.";
+      return false;
+    }
+    for (const auto& range : ranges) {
+      if (!chunk_body->add_messages()->ParseFromArray(
+              mapped_ + body_pos + range.first,
+              static_cast<int>(range.second))) {
+        AERROR << "Parse message at offset " << range.first << " failed.";
+        return false;
+      }
+    }
+    return SkipSection(size);
+  }
+  std::string data;
+  for (const auto& range : ranges) {
+    data.resize(range.second);
+    uint64_t done = 0;
+    while (done < range.second) {
+      ssize_t count = pread(fd_, &data[done], range.second - done,
+                            body_pos + range.first + done);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        AERROR << "Read message failed, fd_: " << fd_ << ", errno: " << errno;
+        return false;
+      }
+      done += count;
+    }
+    if (!chunk_body->add_messages()->ParseFromString(data)) {
+      AERROR << "Parse message at offset " << range.first << " failed.";
+      return false;
+    }
+  }
+  return SkipSection(size);
+}
+
+bool RecordFileReader::ReadBytes(int64_t size, std::string* buffer,
+                                 const char** data) {
+  if (mapped_ != nullptr) {
+    if (size > mapped_size_ - mapped_pos_) {
+      AERROR << "Read past the end of file, file: " << path_;
+      end_of_file_ = true;
+      return false;
+    }
+    *data = mapped_ + mapped_pos_;
+    mapped_pos_ += size;
+    return true;
+  }
+  buffer->resize(size);
+  *data = buffer->data();
+  int64_t offset = 0;
+  while (offset < size) {
+    ssize_t count = read(fd_, &(*buffer)[offset], size - offset);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
+      end_of_file_ = count == 0;
+      return false;
+    }
+    offset += count;
+  }
+  return true;
+}
+
 bool RecordFileReader::SkipSection(int64_t size) {
   int64_t pos = CurrentPosition();
   if (size > INT64_MAX - pos) {
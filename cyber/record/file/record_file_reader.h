@@ -19,13 +19,16 @@
 
 #include <fstream>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <limits>
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "google/protobuf/message.h"
 #include "google/protobuf/text_format.h"
 
@@ -38,27 +41,65 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+using google::protobuf::io::ArrayInputStream;
 using google::protobuf::io::CodedInputStream;
 using google::protobuf::io::FileInputStream;
 using google::protobuf::io::ZeroCopyInputStream;
 
 class RecordFileReader : public RecordFileBase {
  public:
-  RecordFileReader() = default;
+  // with use_mmap the file is mapped and sections are parsed straight from
+  // the mapping, falling back to read() if mapping fails
+  explicit RecordFileReader(bool use_mmap = false) : use_mmap_(use_mmap) {}
   virtual ~RecordFileReader();
   bool Open(const std::string& path) override;
   void Close() override;
+  int64_t CurrentPosition() override;
+  bool SetPosition(int64_t position) override;
+  bool IsMapped() const { return mapped_ != nullptr; }
+  // bytes of the mapping to prefetch ahead of the read position
+  void SetReadahead(uint64_t size) { readahead_ = size; }
   bool Reset();
   bool ReadSection(Section* section);
   bool SkipSection(int64_t size);
   template <typename T>
   bool ReadSection(int64_t size, T* message);
+  // reads a chunk body section, decompressing it as told by its chunk header
+  bool ReadChunkBody(int64_t size, const proto::ChunkHeader& chunk_header,
+                     proto::ChunkBody* chunk_body);
+  // reads only the messages of the given channels out of a chunk body
+  // section, locating them through the chunk body index entry
+  bool ReadChunkBody(int64_t size, const proto::ChunkHeader& chunk_header,
+                     const proto::ChunkBodyCache& chunk_body_cache,
+                     const std::set<std::string>& channels,
+                     proto::ChunkBody* chunk_body);
   bool ReadIndex();
+  // moves forward to the first chunk that may hold messages at or after
+  // begin_time, found by binary search over the chunks in the index; does
+  // nothing when the index has not been read
+  bool SeekTime(uint64_t begin_time);
   bool EndOfFile() { return end_of_file_; }
 
  private:
+  struct ChunkPosition {
+    int64_t position;
+    // the latest end time of this chunk and all chunks before it
+    uint64_t end_time;
+  };
+
   bool ReadHeader();
+  // points data at the next size bytes, copied into buffer unless mapped
+  bool ReadBytes(int64_t size, std::string* buffer, const char** data);
+  void Readahead();
   bool end_of_file_ = false;
+  std::vector<ChunkPosition> chunk_positions_;
+
+  bool use_mmap_ = false;
+  const char* mapped_ = nullptr;
+  int64_t mapped_size_ = 0;
+  int64_t mapped_pos_ = 0;
+  int64_t advised_end_ = 0;
+  uint64_t readahead_ = 32 * 1024 * 1024;
 };
 
 template <typename T>
@@ -68,6 +109,26 @@ bool RecordFileReader::ReadSection(int64_t size, T* message) {
     AERROR << "Size value greater than the range of int value.";
     return false;
   }
+  if (mapped_ != nullptr) {
+    if (size < 0 || size > mapped_size_ - mapped_pos_) {
+      AERROR << "Section of size " << size << " runs past the end of file.";
+      end_of_file_ = true;
+      return false;
+    }
+    ArrayInputStream array_input(mapped_ + mapped_pos_, static_cast<int>(size));
+    CodedInputStream coded_input(&array_input);
+    if (!message->ParseFromCodedStream(&coded_input)) {
+      AERROR << "Parse section message failed.";
+      return false;
+    }
+    mapped_pos_ += size;
+    if (static_cast<int64_t>(message->ByteSizeLong()) != size) {
+      AERROR << "Message size is not consistent in section header"
+             << ", expect: " << size << ", actual: " << message->ByteSizeLong();
+      return false;
+    }
+    return true;
+  }
   FileInputStream raw_input(fd_, static_cast<int>(size));
   CodedInputStream coded_input(&raw_input);
   CodedInputStream::Limit limit = coded_input.PushLimit(static_cast<int>(size));
@@ -308,6 +308,158 @@ TEST(RecordFileTest, TestIndex) {
   }
 }
 
+TEST(RecordFileTest, TestMmapReader) {
+  {
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 1024);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+    for (const auto& name : {kChan1, kChan2}) {
+      Channel chan;
+      chan.set_name(name);
+      chan.set_message_type(kMsgType);
+      chan.set_proto_desc(kStr10B);
+      ASSERT_TRUE(rfw.WriteChannel(chan));
+    }
+    for (int i = 1; i <= 100; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(i % 3 == 0 ? kChan2 : kChan1);
+      msg.set_content(std::string(100, 'a') + std::to_string(i));
+      msg.set_time(i * 1000);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+  }
+
+  // both backends see the same sections, chunks and seek positions
+  RecordFileReader fd_reader;
+  RecordFileReader mmap_reader(true);
+  ASSERT_TRUE(fd_reader.Open(kTestFile1));
+  ASSERT_TRUE(mmap_reader.Open(kTestFile1));
+  ASSERT_FALSE(fd_reader.IsMapped());
+  ASSERT_TRUE(mmap_reader.IsMapped());
+  ASSERT_TRUE(fd_reader.ReadIndex());
+  ASSERT_TRUE(mmap_reader.ReadIndex());
+  ASSERT_EQ(fd_reader.GetIndex().indexes_size(),
+            mmap_reader.GetIndex().indexes_size());
+
+  Section fd_sec;
+  Section mmap_sec;
+  ChunkHeader chdr;
+  int chunks = 0;
+  while (fd_reader.ReadSection(&fd_sec)) {
+    ASSERT_TRUE(mmap_reader.ReadSection(&mmap_sec));
+    ASSERT_EQ(fd_sec.type, mmap_sec.type);
+    ASSERT_EQ(fd_sec.size, mmap_sec.size);
+    if (fd_sec.type == SectionType::SECTION_CHUNK_HEADER) {
+      ASSERT_TRUE(fd_reader.ReadSection<ChunkHeader>(fd_sec.size, &chdr));
+      ASSERT_TRUE(mmap_reader.SkipSection(mmap_sec.size));
+    } else if (fd_sec.type == SectionType::SECTION_CHUNK_BODY) {
+      ChunkBody fd_body;
+      ChunkBody mmap_body;
+      ASSERT_TRUE(fd_reader.ReadChunkBody(fd_sec.size, chdr, &fd_body));
+      ASSERT_TRUE(mmap_reader.ReadChunkBody(mmap_sec.size, chdr, &mmap_body));
+      ASSERT_EQ(fd_body.SerializeAsString(), mmap_body.SerializeAsString());
+      ++chunks;
+    } else {
+      ASSERT_TRUE(fd_reader.SkipSection(fd_sec.size));
+      ASSERT_TRUE(mmap_reader.SkipSection(mmap_sec.size));
+    }
+    ASSERT_EQ(fd_reader.CurrentPosition(), mmap_reader.CurrentPosition());
+  }
+  ASSERT_FALSE(mmap_reader.ReadSection(&mmap_sec));
+  ASSERT_TRUE(mmap_reader.EndOfFile());
+  ASSERT_EQ(fd_reader.GetHeader().chunk_number(), chunks);
+
+  fd_reader.Reset();
+  mmap_reader.Reset();
+  ASSERT_TRUE(fd_reader.SeekTime(50000));
+  ASSERT_TRUE(mmap_reader.SeekTime(50000));
+  ASSERT_EQ(fd_reader.CurrentPosition(), mmap_reader.CurrentPosition());
+  ASSERT_FALSE(mmap_reader.SetPosition(mmap_reader.GetHeader().size() + 1));
+  ASSERT_FALSE(remove(kTestFile1));
+}
+
+TEST(RecordFileTest, TestParallelFlush) {
+  const uint64_t kMsgNum = 5000;
+  // blocking keeps every message, dropping keeps count of the lost ones
+  for (bool drop : {false, true}) {
+    uint64_t dropped = 0;
+    {
+      RecordFileWriter rfw;
+      rfw.SetFlushThreads(4);
+      rfw.SetMaxPendingChunks(drop ? 1 : 8);
+      rfw.SetDropWhenBehind(drop);
+      ASSERT_TRUE(rfw.Open(kTestFile1));
+      Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 4096);
+      header.set_segment_interval(0);
+      header.set_segment_raw_size(0);
+      header.set_compress(proto::CompressType::COMPRESS_LZ4);
+      ASSERT_TRUE(rfw.WriteHeader(header));
+      for (const auto& name : {kChan1, kChan2}) {
+        Channel chan;
+        chan.set_name(name);
+        chan.set_message_type(kMsgType);
+        chan.set_proto_desc(kStr10B);
+        ASSERT_TRUE(rfw.WriteChannel(chan));
+      }
+      for (uint64_t i = 1; i <= kMsgNum; ++i) {
+        SingleMessage msg;
+        msg.set_channel_name(i % 2 ? kChan1 : kChan2);
+        msg.set_content(std::string(i % 200, 'a') + std::to_string(i));
+        msg.set_time(i);
+        ASSERT_TRUE(rfw.WriteMessage(msg) || drop);
+      }
+      rfw.Close();
+      dropped = rfw.GetDroppedMessageNumber();
+    }
+    if (!drop) {
+      ASSERT_EQ(0, dropped);
+    }
+
+    // chunks flushed by different threads still land in time order, and
+    // the index points at the sections they were written to
+    RecordFileReader reader;
+    ASSERT_TRUE(reader.Open(kTestFile1));
+    ASSERT_TRUE(reader.ReadIndex());
+    ASSERT_EQ(kMsgNum, reader.GetHeader().message_number() + dropped);
+    ASSERT_GT(reader.GetHeader().chunk_number(), 1);
+    Section section;
+    for (const auto& single_index : reader.GetIndex().indexes()) {
+      if (single_index.type() == SectionType::SECTION_CHUNK_HEADER ||
+          single_index.type() == SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(reader.SetPosition(single_index.position()));
+        ASSERT_TRUE(reader.ReadSection(&section));
+        ASSERT_EQ(single_index.type(), section.type);
+      }
+    }
+    reader.Reset();
+    ChunkHeader chdr;
+    uint64_t last_time = 0;
+    uint64_t count = 0;
+    while (reader.ReadSection(&section)) {
+      if (section.type == SectionType::SECTION_CHUNK_HEADER) {
+        ASSERT_TRUE(reader.ReadSection<ChunkHeader>(section.size, &chdr));
+      } else if (section.type == SectionType::SECTION_CHUNK_BODY) {
+        ChunkBody body;
+        ASSERT_TRUE(reader.ReadChunkBody(section.size, chdr, &body));
+        ASSERT_EQ(chdr.message_number(), body.messages_size());
+        for (const auto& msg : body.messages()) {
+          ASSERT_LT(last_time, msg.time());
+          last_time = msg.time();
+          ++count;
+        }
+      } else {
+        ASSERT_TRUE(reader.SkipSection(section.size));
+      }
+    }
+    ASSERT_EQ(reader.GetHeader().message_number(), count);
+    ASSERT_FALSE(remove(kTestFile1));
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -17,8 +17,14 @@
 #include "cyber/record/file/record_file_writer.h"
 
 #include <fcntl.h>
+#include <unistd.h>
+
+#include <unordered_map>
+
+#include "google/protobuf/io/coded_stream.h"
 
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compression.h"
 #include "cyber/time/time.h"
 
 namespace apollo {
@@ -27,15 +33,79 @@ namespace record {
 
 using apollo::cyber::proto::Channel;
 using apollo::cyber::proto::ChannelCache;
+using apollo::cyber::proto::ChannelMessageCache;
 using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkBodyCache;
 using apollo::cyber::proto::ChunkHeader;
 using apollo::cyber::proto::ChunkHeaderCache;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleIndex;
+using google::protobuf::io::CodedOutputStream;
+
+namespace {
+
+constexpr size_t kDefaultFlushThreads = 2;
+constexpr size_t kDefaultMaxPendingChunks = 4;
+// the active chunk may grow to this many chunk raw sizes while the flush
+// threads are busy before messages wait or are dropped
+constexpr uint64_t kMaxActiveChunkFactor = 2;
+
+// Records where each message of the chunk lands in the serialized body.
+// Every message is a length-delimited field 1, a one byte tag followed by
+// the varint size and the message itself.
+void CacheChannelMessages(const ChunkBody& chunk_body,
+                          ChunkBodyCache* chunk_body_cache) {
+  std::unordered_map<std::string, ChannelMessageCache*> channels;
+  uint64_t offset = 0;
+  for (const auto& message : chunk_body.messages()) {
+    uint64_t size = message.ByteSizeLong();
+    offset += 1 + CodedOutputStream::VarintSize64(size);
+    auto& cache = channels[message.channel_name()];
+    if (cache == nullptr) {
+      cache = chunk_body_cache->add_channel_messages();
+      cache->set_name(message.channel_name());
+    }
+    cache->add_offsets(offset);
+    cache->add_sizes(size);
+    offset += size;
+  }
+}
+
+void AppendSection(SectionType type, int64_t size, std::string* data) {
+  Section section;
+  /// zero out whole struct even if padded
+  memset(&section, 0, sizeof(section));
+  section = {type, size};
+  data->append(reinterpret_cast<const char*>(&section), sizeof(section));
+}
 
-RecordFileWriter::RecordFileWriter() : is_writing_(false) {}
+// pwrite may write less than asked, loop until all of data is on the file
+bool WriteAt(int fd, const char* data, size_t size, int64_t offset) {
+  while (size > 0) {
+    ssize_t count = pwrite(fd, data, size, offset);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "pwrite fd failed, fd: " << fd << ", errno: " << errno;
+      return false;
+    }
+    data += count;
+    size -= count;
+    offset += count;
+  }
+  return true;
+}
+
+}  // namespace
+
+RecordFileWriter::RecordFileWriter()
+    : is_writing_(false),
+      flush_thread_num_(kDefaultFlushThreads),
+      max_pending_chunks_(kDefaultMaxPendingChunks),
+      dropped_message_number_(0) {}
 
 RecordFileWriter::~RecordFileWriter() { Close(); }
 
@@ -53,53 +123,36 @@ bool RecordFileWriter::Open(const std::string& path) {
     return false;
   }
   chunk_active_.reset(new Chunk());
-  chunk_flush_.reset(new Chunk());
+  chunk_queue_.clear();
+  pending_chunks_ = 0;
+  next_seq_ = 0;
+  reserve_seq_ = 0;
   is_writing_ = true;
-  flush_thread_ = std::make_shared<std::thread>([this]() { this->Flush(); });
-  if (flush_thread_ == nullptr) {
-    AERROR << "Init flush thread error.";
-    return false;
+  for (size_t i = 0; i < flush_thread_num_; ++i) {
+    flush_threads_.emplace_back([this]() { this->Flush(); });
   }
   return true;
 }
 
 void RecordFileWriter::Close() {
   if (is_writing_) {
-    // wait for the flush operation that may exist now
-    while (1) {
-      {
-        std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-        if (chunk_flush_->empty()) {
-          break;
-        }
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    // last swap
+    // queue the last chunk and wait for every pending chunk to be written
     {
       std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-      chunk_flush_.swap(chunk_active_);
-      flush_cv_.notify_one();
-    }
-
-    // wait for the last flush operation
-    while (1) {
-      {
-        std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-        if (chunk_flush_->empty()) {
-          break;
-        }
+      if (!chunk_active_->empty()) {
+        QueueActiveChunk();
+        flush_cv_.notify_all();
       }
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      flush_cv_.wait(flush_lock, [this] { return pending_chunks_ == 0; });
+      is_writing_ = false;
     }
-
-    is_writing_ = false;
     flush_cv_.notify_all();
-    if (flush_thread_ && flush_thread_->joinable()) {
-      flush_thread_->join();
-      flush_thread_ = nullptr;
+    for (auto& flush_thread : flush_threads_) {
+      if (flush_thread.joinable()) {
+        flush_thread.join();
+      }
     }
+    flush_threads_.clear();
 
     if (!WriteIndex()) {
       AERROR << "Write index section failed, file: " << path_;
@@ -120,6 +173,11 @@ void RecordFileWriter::Close() {
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
   header_ = header;
+  if (!IsCompressSupported(header_.compress())) {
+    AWARN << "Unsupported compress type " << header_.compress()
+          << ", write chunks uncompressed.";
+    header_.set_compress(CompressType::COMPRESS_NONE);
+  }
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
     return false;
@@ -168,14 +226,76 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
   return true;
 }
 
-bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
+bool RecordFileWriter::WriteChunk(uint64_t seq, const ChunkHeader& header,
                                   const ChunkBody& chunk_body) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  uint64_t pos = CurrentPosition();
-  if (!WriteSection<ChunkHeader>(chunk_header)) {
-    AERROR << "Write chunk header fail";
+  CompressType compress = CompressType::COMPRESS_NONE;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    compress = header_.compress();
+  }
+
+  // serialize and compress in parallel with the other flush threads, and
+  // keep the chunk uncompressed when compressing does not pay off
+  ChunkHeader chunk_header = header;
+  std::unique_ptr<ChunkBodyCache> chunk_body_cache(new ChunkBodyCache());
+  chunk_body_cache->set_message_number(chunk_body.messages_size());
+  CacheChannelMessages(chunk_body, chunk_body_cache.get());
+  std::string body;
+  bool serialized = chunk_body.SerializeToString(&body);
+  if (serialized && compress != CompressType::COMPRESS_NONE) {
+    std::string compressed;
+    if (CompressChunk(compress, body, &compressed) &&
+        compressed.size() < body.size()) {
+      chunk_header.set_compress(compress);
+      chunk_header.set_uncompressed_size(body.size());
+      body.swap(compressed);
+    }
+  }
+  // section, chunk header and the section of the body go out in one write
+  std::string head;
+  std::string header_data;
+  serialized = serialized && chunk_header.SerializeToString(&header_data);
+  AppendSection(SectionType::SECTION_CHUNK_HEADER, header_data.size(), &head);
+  head.append(header_data);
+  AppendSection(SectionType::SECTION_CHUNK_BODY, body.size(), &head);
+
+  // chunks take their file range in the order they were queued, so the
+  // file stays sorted by time however the flush threads are scheduled
+  {
+    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+    reserve_cv_.wait(flush_lock, [this, seq] { return reserve_seq_ == seq; });
+  }
+  int64_t pos = -1;
+  if (serialized) {
+    pos = ReserveChunk(chunk_header, sizeof(Section) + header_data.size(),
+                       body.size(), std::move(chunk_body_cache));
+  } else {
+    AERROR << "Serialize chunk failed.";
+  }
+  {
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    ++reserve_seq_;
+  }
+  reserve_cv_.notify_all();
+  if (pos < 0) {
     return false;
   }
+  return WriteAt(fd_, head.data(), head.size(), pos) &&
+         WriteAt(fd_, body.data(), body.size(), pos + head.size());
+}
+
+int64_t RecordFileWriter::ReserveChunk(
+    const ChunkHeader& chunk_header, int64_t header_size, int64_t body_size,
+    std::unique_ptr<ChunkBodyCache> chunk_body_cache) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t pos = CurrentPosition();
+  int64_t body_pos = pos + header_size;
+  int64_t end = body_pos + sizeof(Section) + body_size;
+  // sections written after this chunk start past its range
+  if (pos < 0 || !SetPosition(end)) {
+    AERROR << "Reserve chunk range failed, file: " << path_;
+    return -1;
+  }
   SingleIndex* single_index = index_.add_indexes();
   single_index->set_type(SectionType::SECTION_CHUNK_HEADER);
   single_index->set_position(pos);
@@ -186,28 +306,42 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   chunk_header_cache->set_raw_size(chunk_header.raw_size());
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
 
-  pos = CurrentPosition();
-  if (!WriteSection<ChunkBody>(chunk_body)) {
-    AERROR << "Write chunk body fail";
-    return false;
-  }
   header_.set_chunk_number(header_.chunk_number() + 1);
-  if (header_.begin_time() == 0) {
+  // chunks may be flushed out of time order
+  if (header_.begin_time() == 0 ||
+      header_.begin_time() > chunk_header.begin_time()) {
     header_.set_begin_time(chunk_header.begin_time());
   }
-  header_.set_end_time(chunk_header.end_time());
+  if (header_.end_time() < chunk_header.end_time()) {
+    header_.set_end_time(chunk_header.end_time());
+  }
   header_.set_message_number(header_.message_number() +
                              chunk_header.message_number());
+  header_.set_size(end);
   single_index = index_.add_indexes();
   single_index->set_type(SectionType::SECTION_CHUNK_BODY);
-  single_index->set_position(pos);
-  ChunkBodyCache* chunk_body_cache = new ChunkBodyCache();
-  chunk_body_cache->set_message_number(chunk_body.messages_size());
-  single_index->set_allocated_chunk_body_cache(chunk_body_cache);
-  return true;
+  single_index->set_position(body_pos);
+  single_index->set_allocated_chunk_body_cache(chunk_body_cache.release());
+  return pos;
 }
 
 bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
+  if (header_.chunk_raw_size() > 0 &&
+      chunk_active_->header_.raw_size() >=
+          kMaxActiveChunkFactor * header_.chunk_raw_size()) {
+    {
+      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      if (drop_when_behind_ && pending_chunks_ >= max_pending_chunks_) {
+        ++dropped_message_number_;
+        return false;
+      }
+      flush_cv_.wait(flush_lock, [this] {
+        return pending_chunks_ < max_pending_chunks_;
+      });
+      QueueActiveChunk();
+    }
+    flush_cv_.notify_all();
+  }
   chunk_active_->add(message);
   auto it = channel_message_number_map_.find(message.channel_name());
   if (it != channel_message_number_map_.end()) {
@@ -230,28 +364,47 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
     return true;
   }
   {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    chunk_flush_.swap(chunk_active_);
-    flush_cv_.notify_one();
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    // every flush slot is taken, keep filling the active chunk
+    if (pending_chunks_ >= max_pending_chunks_) {
+      return true;
+    }
+    QueueActiveChunk();
   }
+  flush_cv_.notify_all();
   return true;
 }
 
+void RecordFileWriter::QueueActiveChunk() {
+  chunk_queue_.emplace_back(next_seq_++, std::move(chunk_active_));
+  ++pending_chunks_;
+  chunk_active_.reset(new Chunk());
+}
+
 void RecordFileWriter::Flush() {
-  while (is_writing_) {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    flush_cv_.wait(flush_lock,
-                   [this] { return !chunk_flush_->empty() || !is_writing_; });
-    if (!is_writing_) {
-      break;
-    }
-    if (chunk_flush_->empty()) {
-      continue;
+  while (true) {
+    uint64_t seq = 0;
+    std::unique_ptr<Chunk> chunk;
+    {
+      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      flush_cv_.wait(flush_lock,
+                     [this] { return !chunk_queue_.empty() || !is_writing_; });
+      if (chunk_queue_.empty()) {
+        break;
+      }
+      seq = chunk_queue_.front().first;
+      chunk = std::move(chunk_queue_.front().second);
+      chunk_queue_.pop_front();
     }
-    if (!WriteChunk(chunk_flush_->header_, *(chunk_flush_->body_.get()))) {
+    if (!WriteChunk(seq, chunk->header_, *(chunk->body_.get()))) {
       AERROR << "Write chunk fail.";
     }
-    chunk_flush_->clear();
+    {
+      std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+      --pending_chunks_;
+    }
+    // Close waits on the same condition for the pending chunks to drain
+    flush_cv_.notify_all();
   }
 }
 
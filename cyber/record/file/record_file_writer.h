@@ -17,7 +17,12 @@
 #ifndef CYBER_RECORD_FILE_RECORD_FILE_WRITER_H_
 #define CYBER_RECORD_FILE_RECORD_FILE_WRITER_H_
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -25,6 +30,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 #include "google/protobuf/message.h"
@@ -74,6 +80,14 @@ struct Chunk {
   std::unique_ptr<proto::ChunkBody> body_ = nullptr;
 };
 
+/**
+ * Full chunks are queued to a pool of flush threads that serialize and
+ * compress them in parallel. Each one then reserves its file range in
+ * chunk order and writes it with pwrite. While max_pending_chunks are in
+ * flight the active chunk keeps growing. Once it holds twice the chunk raw
+ * size WriteMessage blocks for a free slot, or, for live recording, drops
+ * and counts the message instead.
+ */
 class RecordFileWriter : public RecordFileBase {
  public:
   RecordFileWriter();
@@ -82,22 +96,48 @@ class RecordFileWriter : public RecordFileBase {
   void Close() override;
   bool WriteHeader(const proto::Header& header);
   bool WriteChannel(const proto::Channel& channel);
+  // false if the message was dropped because the flush threads fell behind
   bool WriteMessage(const proto::SingleMessage& message);
+  void SetDropWhenBehind(bool drop) { drop_when_behind_ = drop; }
   uint64_t GetMessageNumber(const std::string& channel_name) const;
+  uint64_t GetDroppedMessageNumber() const { return dropped_message_number_; }
+  // both only take effect on the next Open
+  void SetFlushThreads(size_t num) {
+    flush_thread_num_ = std::max<size_t>(num, 1);
+  }
+  void SetMaxPendingChunks(size_t num) {
+    max_pending_chunks_ = std::max<size_t>(num, 1);
+  }
 
  private:
-  bool WriteChunk(const proto::ChunkHeader& chunk_header,
+  bool WriteChunk(uint64_t seq, const proto::ChunkHeader& chunk_header,
                   const proto::ChunkBody& chunk_body);
+  int64_t ReserveChunk(const proto::ChunkHeader& chunk_header,
+                       int64_t header_size, int64_t body_size,
+                       std::unique_ptr<proto::ChunkBodyCache> chunk_body_cache);
   template <typename T>
   bool WriteSection(const T& message);
   bool WriteIndex();
   void Flush();
+  // moves the active chunk to the flush queue, flush_mutex_ must be held
+  void QueueActiveChunk();
   std::atomic_bool is_writing_;
+  bool drop_when_behind_ = false;
   std::unique_ptr<Chunk> chunk_active_ = nullptr;
-  std::unique_ptr<Chunk> chunk_flush_ = nullptr;
-  std::shared_ptr<std::thread> flush_thread_ = nullptr;
+  // full chunks waiting for a flush thread, tagged with their sequence
+  std::deque<std::pair<uint64_t, std::unique_ptr<Chunk>>> chunk_queue_;
+  std::vector<std::thread> flush_threads_;
+  size_t flush_thread_num_;
+  size_t max_pending_chunks_;
+  // chunks queued or being written
+  size_t pending_chunks_ = 0;
+  uint64_t next_seq_ = 0;
+  // sequence of the chunk whose turn it is to reserve its file range
+  uint64_t reserve_seq_ = 0;
   std::mutex flush_mutex_;
   std::condition_variable flush_cv_;
+  std::condition_variable reserve_cv_;
+  std::atomic<uint64_t> dropped_message_number_;
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
 };
 
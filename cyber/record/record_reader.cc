@@ -29,8 +29,8 @@ using apollo::cyber::proto::SectionType;
 
 RecordReader::~RecordReader() {}
 
-RecordReader::RecordReader(const std::string& file) {
-  file_reader_.reset(new RecordFileReader());
+RecordReader::RecordReader(const std::string& file, bool use_mmap) {
+  file_reader_.reset(new RecordFileReader(use_mmap));
   if (!file_reader_->Open(file)) {
     AERROR << "Failed to open record file: " << file;
     return;
@@ -42,6 +42,13 @@ RecordReader::RecordReader(const std::string& file) {
     index_ = file_reader_->GetIndex();
     for (int i = 0; i < index_.indexes_size(); ++i) {
       auto single_idx = index_.mutable_indexes(i);
+      if (single_idx->type() == SectionType::SECTION_CHUNK_BODY &&
+          single_idx->has_chunk_body_cache() &&
+          single_idx->chunk_body_cache().channel_messages_size() > 0) {
+        chunk_body_cache_[single_idx->position()] =
+            &single_idx->chunk_body_cache();
+        continue;
+      }
       if (single_idx->type() != SectionType::SECTION_CHANNEL) {
         continue;
       }
@@ -64,6 +71,10 @@ void RecordReader::Reset() {
   chunk_.reset(new ChunkBody());
 }
 
+void RecordReader::SetChannelFilter(const std::set<std::string>& channels) {
+  channel_filter_ = channels;
+}
+
 std::set<std::string> RecordReader::GetChannelList() const {
   std::set<std::string> channel_list;
   for (auto& item : channel_info_) {
@@ -83,7 +94,7 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   }
 
   while (message_index_ < chunk_->messages_size()) {
-    const auto& next_message = chunk_->messages(message_index_);
+    auto& next_message = *chunk_->mutable_messages(message_index_);
     uint64_t time = next_message.time();
     if (time > end_time) {
       return false;
@@ -92,9 +103,14 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
     if (time < begin_time) {
       continue;
     }
+    if (!channel_filter_.empty() &&
+        channel_filter_.count(next_message.channel_name()) == 0) {
+      continue;
+    }
 
     message->channel_name = next_message.channel_name();
-    message->content = next_message.content();
+    // every message of the chunk is read once, so hand the payload over
+    message->content = std::move(*next_message.mutable_content());
     message->time = time;
     return true;
   }
@@ -110,8 +126,14 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
 }
 
 bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
+  if (!file_reader_->SeekTime(begin_time)) {
+    AERROR << "Failed to seek to time " << begin_time
+           << ", file: " << file_reader_->GetPath();
+    return false;
+  }
   bool skip_next_chunk_body = false;
   while (!reach_end_) {
+    uint64_t position = file_reader_->CurrentPosition();
     Section section;
     if (!file_reader_->ReadSection(&section)) {
       AERROR << "Failed to read section, file: " << file_reader_->GetPath();
@@ -134,15 +156,15 @@ bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
       }
       case SectionType::SECTION_CHUNK_HEADER: {
         ADEBUG << "Read chunk header section of size: " << section.size;
-        ChunkHeader header;
-        if (!file_reader_->ReadSection<ChunkHeader>(section.size, &header)) {
+        if (!file_reader_->ReadSection<ChunkHeader>(section.size,
+                                                    &chunk_header_)) {
           AERROR << "Failed to read chunk header section.";
           return false;
         }
-        if (header.end_time() < begin_time) {
+        if (chunk_header_.end_time() < begin_time) {
           skip_next_chunk_body = true;
         }
-        if (header.begin_time() > end_time) {
+        if (chunk_header_.begin_time() > end_time) {
           return false;
         }
         break;
@@ -155,7 +177,17 @@ bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
         }
 
         chunk_.reset(new ChunkBody());
-        if (!file_reader_->ReadSection<ChunkBody>(section.size, chunk_.get())) {
+        bool read = false;
+        auto cache = chunk_body_cache_.find(position);
+        if (!channel_filter_.empty() && cache != chunk_body_cache_.end()) {
+          read = file_reader_->ReadChunkBody(section.size, chunk_header_,
+                                             *cache->second, channel_filter_,
+                                             chunk_.get());
+        } else {
+          read = file_reader_->ReadChunkBody(section.size, chunk_header_,
+                                             chunk_.get());
+        }
+        if (!read) {
           AERROR << "Failed to read chunk body section.";
           return false;
         }
@@ -45,8 +45,9 @@ class RecordReader : public RecordBase {
    * @brief The constructor with record file path as parameter.
    *
    * @param file
+   * @param use_mmap Map the file instead of reading it.
    */
-  explicit RecordReader(const std::string& file);
+  explicit RecordReader(const std::string& file, bool use_mmap = false);
 
   /**
    * @brief The destructor.
@@ -77,6 +78,23 @@ class RecordReader : public RecordBase {
    */
   void Reset();
 
+  /**
+   * @brief Read only messages of these channels, all channels when empty.
+   * Files with a per-channel chunk index skip the other payloads without
+   * parsing them. Takes effect from the next chunk read.
+   *
+   * @param channels
+   */
+  void SetChannelFilter(const std::set<std::string>& channels);
+
+  /**
+   * @brief Set how many bytes ahead of the read position a mapped file is
+   * prefetched.
+   *
+   * @param size
+   */
+  void SetReadahead(uint64_t size) { file_reader_->SetReadahead(size); }
+
   /**
    * @brief Get message number by channel name.
    *
@@ -119,10 +137,15 @@ class RecordReader : public RecordBase {
   bool is_valid_ = false;
   bool reach_end_ = false;
   std::unique_ptr<proto::ChunkBody> chunk_ = nullptr;
+  proto::ChunkHeader chunk_header_;
   proto::Index index_;
   int message_index_ = 0;
   ChannelInfoMap channel_info_;
   FileReaderPtr file_reader_;
+  std::set<std::string> channel_filter_;
+  // chunk body index entries by section position
+  std::unordered_map<uint64_t, const proto::ChunkBodyCache*>
+      chunk_body_cache_;
 };
 
 }  // namespace record
@@ -16,6 +16,9 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <chrono>
+#include <iostream>
+#include <set>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -29,6 +32,7 @@ namespace record {
 using apollo::cyber::message::RawMessage;
 
 constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
 constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
 constexpr char kProtoDesc[] = "1234567890";
 constexpr char kStr10B[] = "1234567890";
@@ -88,6 +92,176 @@ TEST(RecordTest, TestSingleRecordFile) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+TEST(RecordTest, TestCompressedRecordFile) {
+  for (auto compress : {proto::CompressType::COMPRESS_LZ4,
+                        proto::CompressType::COMPRESS_ZSTD}) {
+    // small chunks, so the file holds several compressed chunks
+    auto header = HeaderBuilder::GetHeaderWithChunkParams(0, 4096);
+    header.set_compress(compress);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    RecordWriter writer(header);
+    writer.Open(kTestFile);
+    writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+    for (uint32_t i = 0; i < kMessageNum; ++i) {
+      auto msg = std::make_shared<RawMessage>(std::string(1024, 'a') +
+                                              std::to_string(i));
+      writer.WriteMessage(kChannelName1, msg, i);
+    }
+    writer.Close();
+
+    RecordReader reader(kTestFile);
+    ASSERT_EQ(compress, reader.GetHeader().compress());
+    ASSERT_LT(reader.GetHeader().size(), kMessageNum * 1024);
+    RecordMessage message;
+    uint32_t count = 0;
+    while (reader.ReadMessage(&message)) {
+      // chunks flushed back to back may land out of order
+      ASSERT_EQ(std::string(1024, 'a') + std::to_string(message.time),
+                message.content);
+      ++count;
+    }
+    ASSERT_EQ(kMessageNum, count);
+    ASSERT_FALSE(remove(kTestFile));
+  }
+}
+
+TEST(RecordTest, TestChannelFilter) {
+  for (auto compress : {proto::CompressType::COMPRESS_NONE,
+                        proto::CompressType::COMPRESS_LZ4}) {
+    auto header = HeaderBuilder::GetHeaderWithChunkParams(0, 64 * 1024);
+    header.set_compress(compress);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    RecordWriter writer(header);
+    writer.Open(kTestFile);
+    writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+    writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc);
+    for (uint32_t i = 1; i <= kMessageNum * 8; ++i) {
+      // a large payload on channel1 every tenth message
+      if (i % 10 == 0) {
+        auto msg = std::make_shared<RawMessage>(std::string(16 * 1024, 'x'));
+        writer.WriteMessage(kChannelName1, msg, i);
+      } else {
+        auto msg = std::make_shared<RawMessage>(std::to_string(i));
+        writer.WriteMessage(kChannelName2, msg, i);
+      }
+    }
+    writer.Close();
+
+    RecordReader reader(kTestFile);
+    RecordMessage message;
+    reader.SetChannelFilter({kChannelName2});
+    uint32_t count = 0;
+    while (reader.ReadMessage(&message)) {
+      ASSERT_EQ(kChannelName2, message.channel_name);
+      ASSERT_EQ(std::to_string(message.time), message.content);
+      ++count;
+    }
+    ASSERT_EQ(reader.GetMessageNumber(kChannelName2), count);
+
+    // time range still applies to the filtered messages
+    reader.Reset();
+    count = 0;
+    while (reader.ReadMessage(&message, 20, 29)) {
+      ASSERT_EQ(kChannelName2, message.channel_name);
+      ++count;
+    }
+    ASSERT_EQ(9, count);
+
+    reader.Reset();
+    reader.SetChannelFilter({kChannelName1});
+    count = 0;
+    while (reader.ReadMessage(&message)) {
+      ASSERT_EQ(kChannelName1, message.channel_name);
+      ASSERT_EQ(16 * 1024, message.content.size());
+      ++count;
+    }
+    ASSERT_EQ(reader.GetMessageNumber(kChannelName1), count);
+    ASSERT_FALSE(remove(kTestFile));
+  }
+}
+
+// Reads a 10Hz channel out of a record dominated by large payloads, with
+// and without the channel filter.
+TEST(RecordTest, TestChannelFilterBenchmark) {
+  auto header = HeaderBuilder::GetHeaderWithChunkParams(0, 8 * 1024 * 1024);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  RecordWriter writer(header);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc);
+  const std::string cloud(512 * 1024, 'x');
+  for (uint32_t i = 0; i < 200; ++i) {
+    writer.WriteMessage(kChannelName1, std::make_shared<RawMessage>(cloud),
+                        i * 10 + 1);
+    writer.WriteMessage(kChannelName2,
+                        std::make_shared<RawMessage>(std::string(200, 'p')),
+                        i * 10 + 2);
+  }
+  writer.Close();
+
+  RecordReader reader(kTestFile);
+  RecordMessage message;
+  for (bool filter : {false, true}) {
+    reader.Reset();
+    reader.SetChannelFilter(filter ? std::set<std::string>{kChannelName2}
+                                   : std::set<std::string>{});
+    uint32_t count = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (reader.ReadMessage(&message)) {
+      if (message.channel_name == kChannelName2) {
+        ++count;
+      }
+    }
+    std::chrono::duration<double, std::milli> cost =
+        std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(200, count);
+    std::cout << (filter ? "filtered" : "full") << " read of "
+              << reader.GetHeader().size() / (1024 * 1024) << "MB: "
+              << cost.count() << "ms" << std::endl;
+  }
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(RecordTest, TestSeekTime) {
+  // one chunk per ten messages
+  auto header = HeaderBuilder::GetHeaderWithChunkParams(0, 10 * 1024);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  RecordWriter writer(header);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  const uint64_t kNum = 1000;
+  for (uint64_t i = 1; i <= kNum; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::string(1024, 'a') +
+                                            std::to_string(i));
+    writer.WriteMessage(kChannelName1, msg, i * 100);
+  }
+  writer.Close();
+
+  RecordReader reader(kTestFile);
+  RecordMessage message;
+  const uint64_t kBeginTimes[] = {1, 150, 50000, 99901, kNum * 100};
+  for (uint64_t begin : kBeginTimes) {
+    reader.Reset();
+    uint64_t count = 0;
+    while (reader.ReadMessage(&message, begin)) {
+      ASSERT_GE(message.time, begin);
+      ASSERT_EQ(std::string(1024, 'a') + std::to_string(message.time / 100),
+                message.content);
+      ++count;
+    }
+    ASSERT_EQ(kNum - (begin - 1) / 100, count);
+  }
+
+  // seeking past the last chunk reads nothing
+  reader.Reset();
+  ASSERT_FALSE(reader.ReadMessage(&message, kNum * 100 + 1));
+  ASSERT_FALSE(remove(kTestFile));
+}
+
 TEST(RecordTest, TestReaderOrder) {
   RecordWriter writer;
   writer.SetSizeOfFileSegmentation(0);
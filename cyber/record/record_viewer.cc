@@ -17,7 +17,11 @@
 #include "cyber/record/record_viewer.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -26,6 +30,124 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+/**
+ * Decodes one reader on its own thread, one time window at a time, into a
+ * queue bounded by payload bytes. Messages come out sorted by time the same
+ * way FillBuffer sorts them.
+ */
+class ReaderPrefetch {
+ public:
+  ReaderPrefetch(const std::shared_ptr<RecordReader>& reader,
+                 uint64_t begin_time, uint64_t end_time, uint64_t step_time)
+      : reader_(reader),
+        begin_time_(begin_time),
+        end_time_(end_time),
+        step_time_(step_time) {
+    thread_ = std::thread([this]() { this->Run(); });
+  }
+
+  ~ReaderPrefetch() { Stop(); }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // blocks until the next message is decoded, false once the reader is done
+  bool Pop(std::shared_ptr<RecordMessage>* message) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !queue_.empty() || done_ || stopped_; });
+    if (queue_.empty()) {
+      return false;
+    }
+    *message = std::move(queue_.front());
+    queue_.pop_front();
+    bytes_ -= (*message)->content.size();
+    // wake the decoder only once half the queue is drained, so it refills
+    // a window at a time instead of one message per wakeup
+    if (producer_waiting_ && bytes_ <= kMaxQueueBytes / 2) {
+      cv_.notify_all();
+    }
+    return true;
+  }
+
+ private:
+  static constexpr std::size_t kMaxQueueBytes = 16 * 1024 * 1024;
+
+  void Run() {
+    const auto& header = reader_->GetHeader();
+    uint64_t this_begin_time = std::max(begin_time_, header.begin_time());
+    uint64_t end_time = std::min(end_time_, header.end_time());
+    std::vector<std::shared_ptr<RecordMessage>> window;
+    while (this_begin_time <= end_time) {
+      uint64_t this_end_time = this_begin_time + step_time_;
+      if (this_end_time > end_time || this_end_time < this_begin_time) {
+        this_end_time = end_time;
+      }
+      while (true) {
+        auto record_msg = std::make_shared<RecordMessage>();
+        if (!reader_->ReadMessage(record_msg.get(), this_begin_time,
+                                  this_end_time)) {
+          break;
+        }
+        window.emplace_back(std::move(record_msg));
+      }
+      std::stable_sort(window.begin(), window.end(),
+                       [](const std::shared_ptr<RecordMessage>& lhs,
+                          const std::shared_ptr<RecordMessage>& rhs) {
+                         return lhs->time < rhs->time;
+                       });
+      if (!Push(&window)) {
+        return;
+      }
+      if (this_end_time == end_time) {
+        break;
+      }
+      this_begin_time = this_end_time + 1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    cv_.notify_all();
+  }
+
+  // appends a whole window, so the queue may go over the bound by one window
+  bool Push(std::vector<std::shared_ptr<RecordMessage>>* window) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    producer_waiting_ = true;
+    cv_.wait(lock, [this] { return bytes_ < kMaxQueueBytes || stopped_; });
+    producer_waiting_ = false;
+    if (stopped_) {
+      return false;
+    }
+    for (auto& msg : *window) {
+      bytes_ += msg->content.size();
+      queue_.emplace_back(std::move(msg));
+    }
+    window->clear();
+    cv_.notify_all();
+    return true;
+  }
+
+  std::shared_ptr<RecordReader> reader_;
+  uint64_t begin_time_;
+  uint64_t end_time_;
+  uint64_t step_time_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<RecordMessage>> queue_;
+  std::size_t bytes_ = 0;
+  bool producer_waiting_ = false;
+  bool done_ = false;
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
 RecordViewer::RecordViewer(const RecordReaderPtr& reader, uint64_t begin_time,
                            uint64_t end_time,
                            const std::set<std::string>& channels)
@@ -58,6 +180,9 @@ bool RecordViewer::IsValid() const {
 }
 
 bool RecordViewer::Update(RecordMessage* message) {
+  if (!prefetches_.empty()) {
+    return Merge(message);
+  }
   bool find = false;
   do {
     if (msg_buffer_.empty() && !FillBuffer()) {
@@ -65,7 +190,7 @@ bool RecordViewer::Update(RecordMessage* message) {
     }
     auto& msg = msg_buffer_.begin()->second;
     if (channels_.empty() || channels_.count(msg->channel_name) == 1) {
-      *message = *msg;
+      *message = std::move(*msg);
       find = true;
     }
     msg_buffer_.erase(msg_buffer_.begin());
@@ -101,12 +226,59 @@ void RecordViewer::Init() {
 }
 
 void RecordViewer::Reset() {
+  StopPrefetch();
+  // readers may be shared by viewers of different channels, so the filter
+  // is set again for every iteration
   for (auto& reader : readers_) {
     reader->Reset();
+    reader->SetChannelFilter(channels_);
   }
   std::fill(readers_finished_.begin(), readers_finished_.end(), false);
   curr_begin_time_ = begin_time_;
   msg_buffer_.clear();
+  if (readers_.size() > 1 && begin_time_ <= end_time_) {
+    StartPrefetch();
+  }
+}
+
+void RecordViewer::StartPrefetch() {
+  for (auto& reader : readers_) {
+    prefetches_.emplace_back(std::make_shared<ReaderPrefetch>(
+        reader, begin_time_, end_time_, kStepTimeNanoSec));
+  }
+  merge_msgs_.resize(prefetches_.size());
+  for (std::size_t i = 0; i < prefetches_.size(); ++i) {
+    if (prefetches_[i]->Pop(&merge_msgs_[i])) {
+      merge_heap_.emplace(merge_msgs_[i]->time, i);
+    }
+  }
+}
+
+void RecordViewer::StopPrefetch() {
+  // copies of this viewer share the threads, stop them before the readers
+  // are touched again
+  for (auto& prefetch : prefetches_) {
+    prefetch->Stop();
+  }
+  prefetches_.clear();
+  merge_msgs_.clear();
+  merge_heap_ = decltype(merge_heap_)();
+}
+
+bool RecordViewer::Merge(RecordMessage* message) {
+  while (!merge_heap_.empty()) {
+    std::size_t i = merge_heap_.top().second;
+    merge_heap_.pop();
+    auto msg = std::move(merge_msgs_[i]);
+    if (prefetches_[i]->Pop(&merge_msgs_[i])) {
+      merge_heap_.emplace(merge_msgs_[i]->time, i);
+    }
+    if (channels_.empty() || channels_.count(msg->channel_name) == 1) {
+      *message = std::move(*msg);
+      return true;
+    }
+  }
+  return false;
 }
 
 void RecordViewer::UpdateTime() {
@@ -18,11 +18,14 @@
 #define CYBER_RECORD_RECORD_VIEWER_H_
 
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <queue>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/record/record_message.h"
@@ -32,8 +35,13 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+class ReaderPrefetch;
+
 /**
  * @brief The record viewer.
+ *
+ * With more than one reader, every reader is decoded on its own prefetch
+ * thread and the viewer merges their messages in time order.
  */
 class RecordViewer {
  public:
@@ -179,11 +187,17 @@ class RecordViewer {
  private:
   friend class Iterator;
 
+  // (time, reader index) of the next message of each prefetching reader
+  using MergeHead = std::pair<uint64_t, std::size_t>;
+
   void Init();
   void Reset();
   void UpdateTime();
   bool FillBuffer();
   bool Update(RecordMessage* message);
+  void StartPrefetch();
+  void StopPrefetch();
+  bool Merge(RecordMessage* message);
 
   uint64_t begin_time_ = 0;
   uint64_t end_time_ = std::numeric_limits<uint64_t>::max();
@@ -197,6 +211,12 @@ class RecordViewer {
   uint64_t curr_begin_time_ = 0;
   std::multimap<uint64_t, std::shared_ptr<RecordMessage>> msg_buffer_;
 
+  std::vector<std::shared_ptr<ReaderPrefetch>> prefetches_;
+  std::vector<std::shared_ptr<RecordMessage>> merge_msgs_;
+  std::priority_queue<MergeHead, std::vector<MergeHead>,
+                      std::greater<MergeHead>>
+      merge_heap_;
+
   const uint64_t kStepTimeNanoSec = 1000000000UL;  // 1 second
   const std::size_t kBufferMinSize = 128;
 };
@@ -20,8 +20,11 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -36,6 +39,7 @@ namespace record {
 using apollo::cyber::message::RawMessage;
 
 constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
 constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
 constexpr char kProtoDesc1[] = "1234567890";
 constexpr char kTestFile[] = "viewer_test.record";
@@ -59,6 +63,37 @@ static void ConstructRecord(uint64_t msg_num, uint64_t begin_time,
   writer.Close();
 }
 
+// Writes file_num files whose messages interleave in time: message i of
+// file f is at begin_time + time_step * (i * file_num + f), and every
+// other message of a file is on channel2.
+static std::vector<std::string> ConstructRecords(uint64_t file_num,
+                                                 uint64_t msg_num,
+                                                 uint64_t begin_time,
+                                                 uint64_t time_step,
+                                                 size_t msg_size) {
+  std::vector<std::string> files;
+  for (uint64_t f = 0; f < file_num; ++f) {
+    files.emplace_back("viewer_test_" + std::to_string(f) + ".record");
+    auto header = HeaderBuilder::GetHeaderWithChunkParams(
+        time_step * file_num * 50, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    RecordWriter writer(header);
+    writer.Open(files.back());
+    writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc1);
+    writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc1);
+    for (uint64_t i = 0; i < msg_num; ++i) {
+      uint64_t time = begin_time + time_step * (i * file_num + f);
+      auto content = std::to_string(time);
+      content.resize(std::max(msg_size, content.size()), ' ');
+      writer.WriteMessage(i % 2 ? kChannelName2 : kChannelName1,
+                          std::make_shared<RawMessage>(content), time);
+    }
+    writer.Close();
+  }
+  return files;
+}
+
 uint64_t CheckCount(RecordViewer viewer) {
   int i = 0;
   for (auto& msg : viewer) {
@@ -224,6 +259,106 @@ TEST(RecordTest, mult_iterator_test) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+TEST(RecordTest, mult_reader_merge_test) {
+  const uint64_t file_num = 4;
+  const uint64_t msg_num = 300;
+  const uint64_t begin_time = 100000000;
+  const uint64_t step_time = 10000000;  // 10ms
+  auto files =
+      ConstructRecords(file_num, msg_num, begin_time, step_time, 0);
+  std::vector<std::shared_ptr<RecordReader>> readers;
+  for (const auto& file : files) {
+    readers.emplace_back(std::make_shared<RecordReader>(file));
+  }
+
+  RecordViewer viewer(readers);
+  EXPECT_TRUE(viewer.IsValid());
+  EXPECT_EQ(begin_time, viewer.begin_time());
+  EXPECT_EQ(begin_time + step_time * (file_num * msg_num - 1),
+            viewer.end_time());
+  // iterate twice, the second pass restarts the prefetch threads
+  for (int pass = 0; pass < 2; ++pass) {
+    uint64_t i = 0;
+    for (auto& msg : viewer) {
+      EXPECT_EQ(begin_time + step_time * i, msg.time);
+      EXPECT_EQ(std::to_string(msg.time), msg.content);
+      i++;
+    }
+    EXPECT_EQ(file_num * msg_num, i);
+  }
+
+  // stop half way, then iterate a time range of one channel
+  for (auto& msg : viewer) {
+    if (msg.time > begin_time + step_time * 100) {
+      break;
+    }
+  }
+  uint64_t range_begin = begin_time + step_time * 400;
+  uint64_t range_end = begin_time + step_time * 799;
+  RecordViewer channel_viewer(readers, range_begin, range_end,
+                              {kChannelName2});
+  uint64_t last_time = 0;
+  uint64_t count = 0;
+  for (auto& msg : channel_viewer) {
+    EXPECT_EQ(kChannelName2, msg.channel_name);
+    EXPECT_GE(msg.time, range_begin);
+    EXPECT_LE(msg.time, range_end);
+    EXPECT_LT(last_time, msg.time);
+    last_time = msg.time;
+    count++;
+  }
+  EXPECT_EQ(200, count);
+
+  for (const auto& file : files) {
+    ASSERT_FALSE(remove(file.c_str()));
+  }
+}
+
+// Replays 8 files of 64KB messages through the viewer, against decoding
+// the same files one after another on the calling thread.
+TEST(RecordTest, mult_reader_benchmark) {
+  const uint64_t file_num = 8;
+  const uint64_t msg_num = 500;
+  auto files =
+      ConstructRecords(file_num, msg_num, 100000000, 10000000, 64 * 1024);
+
+  auto start = std::chrono::steady_clock::now();
+  uint64_t serial_count = 0;
+  for (const auto& file : files) {
+    RecordReader reader(file);
+    RecordMessage msg;
+    while (reader.ReadMessage(&msg)) {
+      serial_count++;
+    }
+  }
+  std::chrono::duration<double, std::milli> serial_cost =
+      std::chrono::steady_clock::now() - start;
+
+  std::vector<std::shared_ptr<RecordReader>> readers;
+  for (const auto& file : files) {
+    readers.emplace_back(std::make_shared<RecordReader>(file));
+  }
+  RecordViewer viewer(readers);
+  start = std::chrono::steady_clock::now();
+  uint64_t merged_count = 0;
+  for (auto& msg : viewer) {
+    if (!msg.content.empty()) {
+      merged_count++;
+    }
+  }
+  std::chrono::duration<double, std::milli> merged_cost =
+      std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(file_num * msg_num, serial_count);
+  EXPECT_EQ(file_num * msg_num, merged_count);
+  std::cout << file_num << " files, serial decode " << serial_cost.count()
+            << "ms, prefetched merge " << merged_cost.count() << "ms"
+            << std::endl;
+  for (const auto& file : files) {
+    ASSERT_FALSE(remove(file.c_str()));
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
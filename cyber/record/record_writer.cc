@@ -46,6 +46,7 @@ bool RecordWriter::Open(const std::string& file) {
     path_ = file_;
   }
   file_writer_.reset(new RecordFileWriter());
+  file_writer_->SetDropWhenBehind(drop_when_behind_);
   if (!file_writer_->Open(path_)) {
     AERROR << "Failed to open output record file: " << path_;
     return false;
@@ -60,6 +61,9 @@ bool RecordWriter::Open(const std::string& file) {
 }
 
 void RecordWriter::Close() {
+  if (close_thread_.joinable()) {
+    close_thread_.join();
+  }
   if (is_opened_) {
     file_writer_->Close();
     is_opened_ = false;
@@ -68,6 +72,7 @@ void RecordWriter::Close() {
 
 bool RecordWriter::SplitOutfile() {
   file_writer_.reset(new RecordFileWriter());
+  file_writer_->SetDropWhenBehind(drop_when_behind_);
   if (file_index_ > 99999) {
     AWARN << "More than 99999 record files had been recored, will restart "
           << "counting from 0.";
@@ -123,11 +128,14 @@ bool RecordWriter::WriteChannel(const std::string& channel_name,
 
 bool RecordWriter::WriteMessage(const SingleMessage& message) {
   std::lock_guard<std::mutex> lg(mutex_);
-  OnNewMessage(message.channel_name());
   if (!file_writer_->WriteMessage(message)) {
-    AERROR << "Write message is failed.";
+    channel_dropped_number_map_[message.channel_name()]++;
+    dropped_message_number_++;
+    AERROR_EVERY(100) << "Write message is failed, " << dropped_message_number_
+                      << " messages dropped.";
     return false;
   }
+  OnNewMessage(message.channel_name());
 
   segment_raw_size_ += message.content().size();
   if (segment_begin_time_ == 0) {
@@ -141,8 +149,13 @@ bool RecordWriter::WriteMessage(const SingleMessage& message) {
        message.time() - segment_begin_time_ > header_.segment_interval()) ||
       (header_.segment_raw_size() > 0 &&
        segment_raw_size_ > header_.segment_raw_size())) {
+    // the finished segment still has chunks to flush, close it on its own
+    // thread so that writing does not stall on the disk
+    if (close_thread_.joinable()) {
+      close_thread_.join();
+    }
     file_writer_backup_.swap(file_writer_);
-    file_writer_backup_->Close();
+    close_thread_ = std::thread([this]() { file_writer_backup_->Close(); });
     if (!SplitOutfile()) {
       AERROR << "Split out file is failed.";
       return false;
@@ -169,6 +182,15 @@ bool RecordWriter::SetIntervalOfFileSegmentation(uint64_t time_sec) {
   return true;
 }
 
+bool RecordWriter::SetDropWhenBehind(bool drop) {
+  if (is_opened_) {
+    AWARN << "Please call this interface before opening file.";
+    return false;
+  }
+  drop_when_behind_ = drop;
+  return true;
+}
+
 bool RecordWriter::IsNewChannel(const std::string& channel_name) const {
   return channel_message_number_map_.find(channel_name) ==
          channel_message_number_map_.end();
@@ -215,6 +237,15 @@ const std::string& RecordWriter::GetProtoDesc(
   return kEmptyString;
 }
 
+uint64_t RecordWriter::GetDroppedMessageNumber(
+    const std::string& channel_name) const {
+  auto search = channel_dropped_number_map_.find(channel_name);
+  if (search != channel_dropped_number_map_.end()) {
+    return search->second;
+  }
+  return 0;
+}
+
 std::set<std::string> RecordWriter::GetChannelList() const {
   std::set<std::string> channel_list;
   for (const auto& item : channel_message_number_map_) {
@@ -17,12 +17,14 @@
 #ifndef CYBER_RECORD_RECORD_WRITER_H_
 #define CYBER_RECORD_RECORD_WRITER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "cyber/proto/record.pb.h"
@@ -126,6 +128,16 @@ class RecordWriter : public RecordBase {
    */
   bool SetIntervalOfFileSegmentation(uint64_t time_sec);
 
+  /**
+   * @brief Drop messages instead of blocking when chunks are produced faster
+   * than they can be written, for live recording.
+   *
+   * @param drop
+   *
+   * @return True for success, false for fail.
+   */
+  bool SetDropWhenBehind(bool drop);
+
   /**
    * @brief Get message number by channel name.
    *
@@ -162,6 +174,24 @@ class RecordWriter : public RecordBase {
    */
   std::set<std::string> GetChannelList() const override;
 
+  /**
+   * @brief Get the number of messages of a channel dropped because the file
+   * writer could not flush chunks fast enough.
+   *
+   * @param channel_name
+   *
+   * @return Dropped message number.
+   */
+  uint64_t GetDroppedMessageNumber(const std::string& channel_name) const;
+
+  /**
+   * @brief Get the number of dropped messages of all channels, safe to call
+   * while writing.
+   *
+   * @return Dropped message number.
+   */
+  uint64_t GetDroppedMessageNumber() const { return dropped_message_number_; }
+
   /**
    * @brief Is a new channel recording or not.
    *
@@ -182,10 +212,15 @@ class RecordWriter : public RecordBase {
   uint64_t segment_begin_time_ = 0;
   uint32_t file_index_ = 0;
   MessageNumberMap channel_message_number_map_;
+  MessageNumberMap channel_dropped_number_map_;
+  std::atomic<uint64_t> dropped_message_number_{0};
+  bool drop_when_behind_ = false;
   MessageTypeMap channel_message_type_map_;
   MessageProtoDescMap channel_proto_desc_map_;
   FileWriterPtr file_writer_ = nullptr;
   FileWriterPtr file_writer_backup_ = nullptr;
+  // closes file_writer_backup_ while the next segment is written
+  std::thread close_thread_;
   std::mutex mutex_;
   std::stringstream sstream_;
 };
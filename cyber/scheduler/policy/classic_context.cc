@@ -28,11 +28,11 @@ using apollo::cyber::base::WriteLockGuard;
 using apollo::cyber::croutine::CRoutine;
 using apollo::cyber::croutine::RoutineState;
 
-alignas(CACHELINE_SIZE) GRP_WQ_MUTEX ClassicContext::mtx_wq_;
-alignas(CACHELINE_SIZE) GRP_WQ_CV ClassicContext::cv_wq_;
 alignas(CACHELINE_SIZE) RQ_LOCK_GROUP ClassicContext::rq_locks_;
 alignas(CACHELINE_SIZE) CR_GROUP ClassicContext::cr_group_;
-alignas(CACHELINE_SIZE) NOTIFY_GRP ClassicContext::notify_grp_;
+alignas(CACHELINE_SIZE) GROUP_NOTIFIERS ClassicContext::notifiers_;
+std::mutex ClassicContext::group_ids_mtx_;
+GROUP_ID_MAP ClassicContext::group_ids_ = {{DEFAULT_GROUP_NAME, 0}};
 
 ClassicContext::ClassicContext() { InitGroup(DEFAULT_GROUP_NAME); }
 
@@ -43,12 +43,30 @@ ClassicContext::ClassicContext(const std::string& group_name) {
 void ClassicContext::InitGroup(const std::string& group_name) {
   multi_pri_rq_ = &cr_group_[group_name];
   lq_ = &rq_locks_[group_name];
-  mtx_wrapper_ = &mtx_wq_[group_name];
-  cw_ = &cv_wq_[group_name];
-  notify_grp_[group_name] = 0;
+  auto group_id = GroupId(group_name);
+  ACHECK(group_id != INVALID_GROUP_ID)
+      << "no notifier left for group " << group_name;
+  notifier_ = &notifiers_[group_id];
+  notifier_->pending.store(0);
   current_grp = group_name;
 }
 
+uint32_t ClassicContext::GroupId(const std::string& group_name) {
+  std::lock_guard<std::mutex> lk(group_ids_mtx_);
+  auto it = group_ids_.find(group_name);
+  if (it != group_ids_.end()) {
+    return it->second;
+  }
+  uint32_t id = static_cast<uint32_t>(group_ids_.size());
+  if (id >= MAX_GROUP_NUM) {
+    AERROR << "group number exceeds " << MAX_GROUP_NUM << ", group "
+           << group_name << " can not be notified.";
+    return INVALID_GROUP_ID;
+  }
+  group_ids_[group_name] = id;
+  return id;
+}
+
 std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
   if (cyber_unlikely(stop_.load())) {
     return nullptr;
@@ -73,27 +91,54 @@ std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
 }
 
 void ClassicContext::Wait() {
-  std::unique_lock<std::mutex> lk(mtx_wrapper_->Mutex());
-  cw_->Cv().wait_for(lk, std::chrono::milliseconds(1000),
-                     [&]() { return notify_grp_[current_grp] > 0; });
-  if (notify_grp_[current_grp] > 0) {
-    notify_grp_[current_grp]--;
+  if (TryConsume(notifier_)) {
+    return;
   }
+
+  // waiters is raised before pending is checked under the mutex, and
+  // Notify raises pending before it checks waiters, so no wake-up is lost
+  notifier_->waiters.fetch_add(1);
+  {
+    std::unique_lock<std::mutex> lk(notifier_->mtx);
+    notifier_->cv.wait_for(lk, std::chrono::milliseconds(1000), [this]() {
+      return notifier_->pending.load() > 0;
+    });
+  }
+  notifier_->waiters.fetch_sub(1);
+  TryConsume(notifier_);
 }
 
 void ClassicContext::Shutdown() {
   stop_.store(true);
-  mtx_wrapper_->Mutex().lock();
-  notify_grp_[current_grp] = std::numeric_limits<unsigned char>::max();
-  mtx_wrapper_->Mutex().unlock();
-  cw_->Cv().notify_all();
+  notifier_->pending.store(std::numeric_limits<unsigned char>::max());
+  notifier_->mtx.lock();
+  notifier_->mtx.unlock();
+  notifier_->cv.notify_all();
+}
+
+void ClassicContext::Notify(uint32_t group_id) {
+  if (cyber_unlikely(group_id >= MAX_GROUP_NUM)) {
+    return;
+  }
+  auto& notifier = notifiers_[group_id];
+  notifier.pending.fetch_add(1);
+  if (notifier.waiters.load() == 0) {
+    return;
+  }
+  // pairs with the predicate check of Wait
+  notifier.mtx.lock();
+  notifier.mtx.unlock();
+  notifier.cv.notify_one();
 }
 
-void ClassicContext::Notify(const std::string& group_name) {
-  (&mtx_wq_[group_name])->Mutex().lock();
-  notify_grp_[group_name]++;
-  (&mtx_wq_[group_name])->Mutex().unlock();
-  cv_wq_[group_name].Cv().notify_one();
+bool ClassicContext::TryConsume(GroupNotifier* notifier) {
+  int pending = notifier->pending.load();
+  while (pending > 0) {
+    if (notifier->pending.compare_exchange_weak(pending, pending - 1)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 bool ClassicContext::RemoveCRoutine(const std::shared_ptr<CRoutine>& cr) {
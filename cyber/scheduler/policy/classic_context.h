@@ -18,6 +18,8 @@
 #define CYBER_SCHEDULER_POLICY_CLASSIC_CONTEXT_H_
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -27,8 +29,6 @@
 
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/croutine/croutine.h"
-#include "cyber/scheduler/common/cv_wrapper.h"
-#include "cyber/scheduler/common/mutex_wrapper.h"
 #include "cyber/scheduler/processor_context.h"
 
 namespace apollo {
@@ -36,6 +36,8 @@ namespace cyber {
 namespace scheduler {
 
 static constexpr uint32_t MAX_PRIO = 20;
+static constexpr uint32_t MAX_GROUP_NUM = 256;
+static constexpr uint32_t INVALID_GROUP_ID = MAX_GROUP_NUM;
 
 #define DEFAULT_GROUP_NAME "default_grp"
 
@@ -45,9 +47,17 @@ using CR_GROUP = std::unordered_map<std::string, MULTI_PRIO_QUEUE>;
 using LOCK_QUEUE = std::array<base::AtomicRWLock, MAX_PRIO>;
 using RQ_LOCK_GROUP = std::unordered_map<std::string, LOCK_QUEUE>;
 
-using GRP_WQ_MUTEX = std::unordered_map<std::string, MutexWrapper>;
-using GRP_WQ_CV = std::unordered_map<std::string, CvWrapper>;
-using NOTIFY_GRP = std::unordered_map<std::string, int>;
+using GROUP_ID_MAP = std::unordered_map<std::string, uint32_t>;
+
+// Wake-up state of one group, indexed by the interned group id. Notify only
+// takes the mutex when a processor of the group is sleeping on cv.
+struct GroupNotifier {
+  alignas(CACHELINE_SIZE) std::atomic<int> pending = {0};
+  std::atomic<int> waiters = {0};
+  std::mutex mtx;
+  std::condition_variable cv;
+};
+using GROUP_NOTIFIERS = std::array<GroupNotifier, MAX_GROUP_NUM>;
 
 class ClassicContext : public ProcessorContext {
  public:
@@ -58,25 +68,33 @@ class ClassicContext : public ProcessorContext {
   void Wait() override;
   void Shutdown() override;
 
-  static void Notify(const std::string &group_name);
+  // Resolves a group name to a dense id once, so the per-message Notify
+  // needs no string lookup. DEFAULT_GROUP_NAME is always 0. Groups beyond
+  // MAX_GROUP_NUM get INVALID_GROUP_ID instead of sharing an id.
+  static uint32_t GroupId(const std::string &group_name);
+  static void Notify(uint32_t group_id);
+  static void Notify(const std::string &group_name) {
+    Notify(GroupId(group_name));
+  }
   static bool RemoveCRoutine(const std::shared_ptr<CRoutine> &cr);
 
   alignas(CACHELINE_SIZE) static CR_GROUP cr_group_;
   alignas(CACHELINE_SIZE) static RQ_LOCK_GROUP rq_locks_;
-  alignas(CACHELINE_SIZE) static GRP_WQ_CV cv_wq_;
-  alignas(CACHELINE_SIZE) static GRP_WQ_MUTEX mtx_wq_;
-  alignas(CACHELINE_SIZE) static NOTIFY_GRP notify_grp_;
+  alignas(CACHELINE_SIZE) static GROUP_NOTIFIERS notifiers_;
 
  private:
   void InitGroup(const std::string &group_name);
+  static bool TryConsume(GroupNotifier *notifier);
+
+  static std::mutex group_ids_mtx_;
+  static GROUP_ID_MAP group_ids_;
 
   std::chrono::steady_clock::time_point wake_time_;
   bool need_sleep_ = false;
 
   MULTI_PRIO_QUEUE *multi_pri_rq_ = nullptr;
   LOCK_QUEUE *lq_ = nullptr;
-  MutexWrapper *mtx_wrapper_ = nullptr;
-  CvWrapper *cw_ = nullptr;
+  GroupNotifier *notifier_ = nullptr;
 
   std::string current_grp;
 };
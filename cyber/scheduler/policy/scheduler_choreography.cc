@@ -57,6 +57,10 @@ SchedulerChoreography::SchedulerChoreography()
       ProcessLevelResourceControl();
     }
 
+    if (cfg.scheduler_conf().has_stack_size_kb()) {
+      default_stack_size_ = cfg.scheduler_conf().stack_size_kb() * 1024;
+    }
+
     const apollo::cyber::proto::ChoreographyConf& choreography_conf =
         cfg.scheduler_conf().choreography_conf();
     proc_num_ = choreography_conf.choreography_processor_num();
@@ -76,6 +80,9 @@ SchedulerChoreography::SchedulerChoreography()
 
     for (const auto& task : choreography_conf.tasks()) {
       cr_confs_[task.name()] = task;
+      if (task.has_stack_size_kb()) {
+        cr_stack_sizes_[task.name()] = task.stack_size_kb() * 1024;
+      }
     }
   }
 
@@ -166,6 +173,7 @@ bool SchedulerChoreography::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
     }
 
     cr->set_group_name(DEFAULT_GROUP_NAME);
+    cr->set_group_id(ClassicContext::GroupId(DEFAULT_GROUP_NAME));
 
     // Enqueue task to pool runqueue.
     {
@@ -254,7 +262,7 @@ bool SchedulerChoreography::NotifyProcessor(uint64_t crid) {
   if (pid < proc_num_) {
     static_cast<ChoreographyContext*>(pctxs_[pid].get())->Notify();
   } else {
-    ClassicContext::Notify(cr->group_name());
+    ClassicContext::Notify(cr->group_id());
   }
 
   return true;
@@ -54,12 +54,19 @@ SchedulerClassic::SchedulerClassic() {
       ProcessLevelResourceControl();
     }
 
+    if (cfg.scheduler_conf().has_stack_size_kb()) {
+      default_stack_size_ = cfg.scheduler_conf().stack_size_kb() * 1024;
+    }
+
     classic_conf_ = cfg.scheduler_conf().classic_conf();
     for (auto& group : classic_conf_.groups()) {
       auto& group_name = group.name();
       for (auto task : group.tasks()) {
         task.set_group_name(group_name);
         cr_confs_[task.name()] = task;
+        if (task.has_stack_size_kb()) {
+          cr_stack_sizes_[task.name()] = task.stack_size_kb() * 1024;
+        }
       }
     }
   } else {
@@ -146,6 +153,7 @@ bool SchedulerClassic::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
           << "].";
     cr->set_priority(MAX_PRIO - 1);
   }
+  cr->set_group_id(ClassicContext::GroupId(cr->group_name()));
 
   // Enqueue task.
   {
@@ -156,7 +164,7 @@ bool SchedulerClassic::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
         .emplace_back(cr);
   }
 
-  ClassicContext::Notify(cr->group_name());
+  ClassicContext::Notify(cr->group_id());
   return true;
 }
 
@@ -174,7 +182,7 @@ bool SchedulerClassic::NotifyProcessor(uint64_t crid) {
         cr->SetUpdateFlag();
       }
 
-      ClassicContext::Notify(cr->group_name());
+      ClassicContext::Notify(cr->group_id());
       return true;
     }
   }
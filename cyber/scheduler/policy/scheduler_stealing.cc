@@ -0,0 +1,254 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/scheduler_stealing.h"
+
+#include <memory>
+#include <utility>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/file.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::common::GetAbsolutePath;
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::common::PathExists;
+using apollo::cyber::common::WorkRoot;
+
+SchedulerStealing::SchedulerStealing() {
+  std::string conf("conf/");
+  conf.append(GlobalData::Instance()->ProcessGroup()).append(".conf");
+  auto cfg_file = GetAbsolutePath(WorkRoot(), conf);
+
+  apollo::cyber::proto::CyberConfig cfg;
+  if (PathExists(cfg_file) && GetProtoFromFile(cfg_file, &cfg)) {
+    for (auto& thr : cfg.scheduler_conf().threads()) {
+      inner_thr_confs_[thr.name()] = thr;
+    }
+
+    if (cfg.scheduler_conf().has_process_level_cpuset()) {
+      process_level_cpuset_ = cfg.scheduler_conf().process_level_cpuset();
+      ProcessLevelResourceControl();
+    }
+
+    if (cfg.scheduler_conf().has_stack_size_kb()) {
+      default_stack_size_ = cfg.scheduler_conf().stack_size_kb() * 1024;
+    }
+
+    classic_conf_ = cfg.scheduler_conf().classic_conf();
+    for (auto& group : classic_conf_.groups()) {
+      auto& group_name = group.name();
+      for (auto task : group.tasks()) {
+        task.set_group_name(group_name);
+        cr_confs_[task.name()] = task;
+        if (task.has_stack_size_kb()) {
+          cr_stack_sizes_[task.name()] = task.stack_size_kb() * 1024;
+        }
+      }
+    }
+  }
+
+  if (classic_conf_.groups_size() == 0) {
+    uint32_t proc_num = 2;
+    auto& global_conf = GlobalData::Instance()->Config();
+    if (global_conf.has_scheduler_conf() &&
+        global_conf.scheduler_conf().has_default_proc_num()) {
+      proc_num = global_conf.scheduler_conf().default_proc_num();
+    }
+    task_pool_size_ = proc_num;
+
+    auto sched_group = classic_conf_.add_groups();
+    sched_group->set_name(DEFAULT_GROUP_NAME);
+    sched_group->set_processor_num(proc_num);
+  }
+
+  CreateProcessor();
+}
+
+void SchedulerStealing::CreateProcessor() {
+  for (auto& group : classic_conf_.groups()) {
+    auto& group_name = group.name();
+    auto proc_num = group.processor_num();
+    if (task_pool_size_ == 0) {
+      task_pool_size_ = proc_num;
+    }
+
+    auto& affinity = group.affinity();
+    auto& processor_policy = group.processor_policy();
+    auto processor_prio = group.processor_prio();
+    std::vector<int> cpuset;
+    ParseCpuset(group.cpuset(), &cpuset);
+
+    // siblings must be known before any processor of the group runs
+    std::vector<std::shared_ptr<StealingContext>> ctxs;
+    auto& group_ctxs = group_ctxs_[group_name];
+    for (uint32_t i = 0; i < proc_num; i++) {
+      auto ctx = std::make_shared<StealingContext>();
+      ctxs.emplace_back(ctx);
+      group_ctxs.emplace_back(ctx.get());
+    }
+    for (auto& ctx : ctxs) {
+      ctx->SetSiblings(group_ctxs);
+    }
+    group_next_ctx_[group_name] = 0;
+
+    for (uint32_t i = 0; i < proc_num; i++) {
+      pctxs_.emplace_back(ctxs[i]);
+
+      auto proc = std::make_shared<Processor>();
+      proc->BindContext(ctxs[i]);
+      SetSchedAffinity(proc->Thread(), cpuset, affinity, i);
+      SetSchedPolicy(proc->Thread(), processor_policy, processor_prio,
+                     proc->Tid());
+      processors_.emplace_back(proc);
+    }
+  }
+}
+
+bool SchedulerStealing::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  MutexWrapper* wrapper = nullptr;
+  if (!id_map_mutex_.Get(cr->id(), &wrapper)) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (!id_map_mutex_.Get(cr->id(), &wrapper)) {
+        wrapper = new MutexWrapper();
+        id_map_mutex_.Set(cr->id(), wrapper);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(wrapper->Mutex());
+
+  if (cr_confs_.find(cr->name()) != cr_confs_.end()) {
+    ClassicTask task = cr_confs_[cr->name()];
+    cr->set_priority(task.prio());
+    cr->set_group_name(task.group_name());
+  } else {
+    // croutine that not exist in conf
+    cr->set_group_name(classic_conf_.groups(0).name());
+  }
+
+  if (cr->priority() >= MAX_PRIO) {
+    AWARN << cr->name() << " prio is greater than MAX_PRIO[ << " << MAX_PRIO
+          << "].";
+    cr->set_priority(MAX_PRIO - 1);
+  }
+
+  // a group configured with no processors would never run the croutine
+  auto ctxs_itr = group_ctxs_.find(cr->group_name());
+  if (ctxs_itr == group_ctxs_.end() || ctxs_itr->second.empty()) {
+    AERROR << "group[" << cr->group_name() << "] of " << cr->name()
+           << " has no processor.";
+    return false;
+  }
+
+  auto task = std::make_shared<StealingTask>(cr);
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(cr->id()) != id_cr_.end()) {
+      return false;
+    }
+    id_cr_[cr->id()] = cr;
+
+    // spread croutines over the processors of the group, notifications go
+    // to the home processor, others steal when it is busy
+    auto& ctxs = ctxs_itr->second;
+    auto& next = group_next_ctx_[cr->group_name()];
+    task->home = ctxs[next++ % ctxs.size()];
+    id_task_[cr->id()] = task;
+  }
+
+  StealingContext::Dispatch(task);
+  return true;
+}
+
+bool SchedulerStealing::NotifyProcessor(uint64_t crid) {
+  if (cyber_unlikely(stop_)) {
+    return true;
+  }
+
+  StealingTaskPtr task = nullptr;
+  {
+    ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    auto it = id_task_.find(crid);
+    if (it == id_task_.end()) {
+      return false;
+    }
+    task = it->second;
+  }
+  StealingContext::Notify(task);
+  return true;
+}
+
+bool SchedulerStealing::RemoveTask(const std::string& name) {
+  if (cyber_unlikely(stop_)) {
+    return true;
+  }
+
+  auto crid = GlobalData::GenerateHashId(name);
+  return RemoveCRoutine(crid);
+}
+
+bool SchedulerStealing::RemoveCRoutine(uint64_t crid) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  MutexWrapper* wrapper = nullptr;
+  if (!id_map_mutex_.Get(crid, &wrapper)) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (!id_map_mutex_.Get(crid, &wrapper)) {
+        wrapper = new MutexWrapper();
+        id_map_mutex_.Set(crid, wrapper);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(wrapper->Mutex());
+
+  StealingTaskPtr task = nullptr;
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    auto it = id_task_.find(crid);
+    if (it == id_task_.end()) {
+      return false;
+    }
+    task = it->second;
+    id_task_.erase(it);
+    id_cr_.erase(crid);
+  }
+
+  // a queued copy of the task is dropped by the processor popping it
+  task->removed.store(true);
+  auto cr = task->cr;
+  cr->Stop();
+  while (!cr->Acquire()) {
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+    AINFO_EVERY(1000) << "waiting for task " << cr->name() << " completion";
+  }
+  cr->Release();
+  return true;
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/stealing_context.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::RoutineState;
+
+void StealingContext::SetSiblings(
+    const std::vector<StealingContext*>& siblings) {
+  siblings_.clear();
+  // start stealing from the next processor, so thieves spread out
+  auto self = std::find(siblings.begin(), siblings.end(), this);
+  if (self == siblings.end()) {
+    siblings_ = siblings;
+    return;
+  }
+  siblings_.insert(siblings_.end(), self + 1, siblings.end());
+  siblings_.insert(siblings_.end(), siblings.begin(), self);
+}
+
+void StealingContext::Dispatch(const StealingTaskPtr& task) {
+  task->scheduled.store(true);
+  task->home->Push(task);
+}
+
+void StealingContext::Notify(const StealingTaskPtr& task) {
+  task->cr->SetUpdateFlag();
+  if (!task->scheduled.exchange(true)) {
+    task->home->Push(task);
+  }
+}
+
+std::shared_ptr<CRoutine> StealingContext::NextRoutine() {
+  if (cyber_unlikely(stop_.load())) {
+    return nullptr;
+  }
+
+  if (running_ != nullptr) {
+    AfterRun(running_);
+    running_ = nullptr;
+  }
+  WakeSleepers();
+
+  while (true) {
+    StealingTaskPtr task = nullptr;
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      task = PopLocked();
+    }
+    if (task == nullptr) {
+      task = Steal();
+    }
+    if (task == nullptr) {
+      return nullptr;
+    }
+
+    auto& cr = task->cr;
+    if (!cr->Acquire()) {
+      if (!task->removed.load()) {
+        // briefly held by a processor rechecking it in Unschedule
+        Push(task);
+      }
+      continue;
+    }
+    if (task->removed.load()) {
+      cr->Release();
+      continue;
+    }
+    if (cr->UpdateState() == RoutineState::READY) {
+      running_ = task;
+      return cr;
+    }
+    cr->Release();
+    Unschedule(task);
+  }
+}
+
+void StealingContext::Wait() {
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+  if (!sleepers_.empty() && sleepers_.begin()->first < deadline) {
+    deadline = sleepers_.begin()->first;
+  }
+
+  std::unique_lock<std::mutex> lk(mtx_);
+  idle_.store(true);
+  cv_.wait_until(lk, deadline, [this]() {
+    return stop_.load() || ready_mask_ != 0 || notified_;
+  });
+  notified_ = false;
+  idle_.store(false);
+}
+
+void StealingContext::Shutdown() {
+  stop_.store(true);
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    notified_ = true;
+  }
+  cv_.notify_all();
+}
+
+void StealingContext::Push(const StealingTaskPtr& task) {
+  auto prio = task->cr->priority();
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    rq_[prio].push_back(task);
+    ready_mask_ |= 1u << prio;
+  }
+  if (idle_.load()) {
+    cv_.notify_one();
+    return;
+  }
+  // busy, hand the work to an idle sibling instead of letting it wait
+  for (auto sibling : siblings_) {
+    if (sibling->idle_.load()) {
+      sibling->WakeUp();
+      return;
+    }
+  }
+}
+
+StealingTaskPtr StealingContext::PopLocked() {
+  if (ready_mask_ == 0) {
+    return nullptr;
+  }
+  uint32_t prio = 31 - __builtin_clz(ready_mask_);
+  auto& queue = rq_[prio];
+  auto task = queue.front();
+  queue.pop_front();
+  if (queue.empty()) {
+    ready_mask_ &= ~(1u << prio);
+  }
+  return task;
+}
+
+StealingTaskPtr StealingContext::Steal() {
+  for (auto sibling : siblings_) {
+    std::unique_lock<std::mutex> lk(sibling->mtx_, std::try_to_lock);
+    if (!lk.owns_lock()) {
+      continue;
+    }
+    auto task = sibling->PopLocked();
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void StealingContext::WakeUp() {
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    notified_ = true;
+  }
+  cv_.notify_one();
+}
+
+void StealingContext::AfterRun(const StealingTaskPtr& task) {
+  switch (task->cr->state()) {
+    case RoutineState::READY:
+      Push(task);
+      break;
+    case RoutineState::SLEEP:
+      sleepers_.emplace(task->cr->wake_time(), task);
+      break;
+    case RoutineState::FINISHED:
+      // stays scheduled, so it is never queued again
+      break;
+    default:
+      Unschedule(task);
+      break;
+  }
+}
+
+void StealingContext::WakeSleepers() {
+  auto now = std::chrono::steady_clock::now();
+  while (!sleepers_.empty() && sleepers_.begin()->first <= now) {
+    auto task = sleepers_.begin()->second;
+    sleepers_.erase(sleepers_.begin());
+    task->cr->Wake();
+    Push(task);
+  }
+}
+
+void StealingContext::Unschedule(const StealingTaskPtr& task) {
+  task->scheduled.store(false);
+  // a notification may have come in before scheduled was cleared
+  auto& cr = task->cr;
+  if (!cr->Acquire()) {
+    return;
+  }
+  auto state = cr->UpdateState();
+  cr->Release();
+  if (state == RoutineState::READY && !task->scheduled.exchange(true)) {
+    task->home->Push(task);
+  }
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
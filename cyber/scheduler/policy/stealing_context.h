@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_STEALING_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_STEALING_CONTEXT_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+class StealingContext;
+
+// A croutine as seen by the stealing scheduler. scheduled is set while the
+// croutine sits in a ready queue, runs, or sleeps, so it is queued at most
+// once however often it gets notified.
+struct StealingTask {
+  explicit StealingTask(const std::shared_ptr<CRoutine>& routine)
+      : cr(routine) {}
+
+  std::shared_ptr<CRoutine> cr;
+  StealingContext* home = nullptr;
+  std::atomic<bool> scheduled = {false};
+  std::atomic<bool> removed = {false};
+};
+using StealingTaskPtr = std::shared_ptr<StealingTask>;
+
+// Per-processor ready queues. Croutines are pushed when they are notified
+// instead of being polled, and a processor that runs out of work steals
+// from the other processors of its group.
+class StealingContext : public ProcessorContext {
+ public:
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+  // must be set before the processor bound to this context starts
+  void SetSiblings(const std::vector<StealingContext*>& siblings);
+
+  // queues a croutine that has just been created
+  static void Dispatch(const StealingTaskPtr& task);
+  // wakes up a croutine waiting for data or io
+  static void Notify(const StealingTaskPtr& task);
+
+ private:
+  using ReadyQueue = std::array<std::deque<StealingTaskPtr>, MAX_PRIO>;
+
+  void Push(const StealingTaskPtr& task);
+  StealingTaskPtr PopLocked();
+  StealingTaskPtr Steal();
+  void WakeUp();
+  void AfterRun(const StealingTaskPtr& task);
+  void WakeSleepers();
+  // clears scheduled unless the croutine became ready meanwhile
+  void Unschedule(const StealingTaskPtr& task);
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  ReadyQueue rq_;
+  // bit i is set when rq_[i] is not empty
+  uint32_t ready_mask_ = 0;
+  bool notified_ = false;
+  std::atomic<bool> idle_ = {false};
+
+  // only touched by the processor thread
+  StealingTaskPtr running_ = nullptr;
+  std::multimap<std::chrono::steady_clock::time_point, StealingTaskPtr>
+      sleepers_;
+  std::vector<StealingContext*> siblings_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_STEALING_CONTEXT_H_
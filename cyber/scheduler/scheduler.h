@@ -96,6 +96,9 @@ class Scheduler {
   std::vector<std::shared_ptr<Processor>> processors_;
 
   std::unordered_map<std::string, InnerThread> inner_thr_confs_;
+  // croutine stack sizes from scheduler conf, by task name
+  std::unordered_map<std::string, size_t> cr_stack_sizes_;
+  size_t default_stack_size_ = croutine::STACK_SIZE;
 
   std::string process_level_cpuset_;
   uint32_t proc_num_ = 0;
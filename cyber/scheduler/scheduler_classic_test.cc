@@ -16,6 +16,11 @@
 
 #include "cyber/scheduler/policy/scheduler_classic.h"
 
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+
 #include "gtest/gtest.h"
 
 #include "cyber/base/for_each.h"
@@ -60,6 +65,41 @@ TEST(SchedulerClassicTest, classic) {
   processor->Stop();
 }
 
+TEST(SchedulerClassicTest, group_id) {
+  EXPECT_EQ(ClassicContext::GroupId(DEFAULT_GROUP_NAME), 0);
+  auto id = ClassicContext::GroupId("group_id_test");
+  EXPECT_NE(id, 0);
+  EXPECT_EQ(ClassicContext::GroupId("group_id_test"), id);
+}
+
+TEST(SchedulerClassicTest, notify_benchmark) {
+  const int kNotifyNum = 1000000;
+  const std::string group = "notify_bench";
+  auto group_id = ClassicContext::GroupId(group);
+  auto processor = std::make_shared<Processor>();
+  auto ctx = std::make_shared<ClassicContext>(group);
+  processor->BindContext(ctx);
+
+  auto start = std::chrono::steady_clock::now();
+  FOR_EACH(i, 0, kNotifyNum) { ClassicContext::Notify(group); }
+  auto by_name = std::chrono::steady_clock::now() - start;
+  start = std::chrono::steady_clock::now();
+  FOR_EACH(i, 0, kNotifyNum) { ClassicContext::Notify(group_id); }
+  auto by_id = std::chrono::steady_clock::now() - start;
+  std::cout << "notify by group name: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(by_name)
+                       .count() /
+                   kNotifyNum
+            << "ns, by group id: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(by_id)
+                       .count() /
+                   kNotifyNum
+            << "ns" << std::endl;
+
+  ctx->Shutdown();
+  processor->Stop();
+}
+
 TEST(SchedulerClassicTest, sched_classic) {
   // read example_sched_classic.conf
   GlobalData::Instance()->SetProcessGroup("example_sched_classic");
@@ -103,6 +143,24 @@ TEST(SchedulerClassicTest, sched_classic) {
   sched3->Shutdown();
 }
 
+// uses up the group ids, so it runs last
+TEST(SchedulerClassicTest, group_id_limit) {
+  std::unordered_set<uint32_t> ids;
+  uint32_t id = 0;
+  for (uint32_t i = 0; i <= MAX_GROUP_NUM; ++i) {
+    id = ClassicContext::GroupId("group_id_limit_" + std::to_string(i));
+    if (id == INVALID_GROUP_ID) {
+      break;
+    }
+    EXPECT_LT(id, MAX_GROUP_NUM);
+    EXPECT_TRUE(ids.insert(id).second);
+  }
+  EXPECT_EQ(id, INVALID_GROUP_ID);
+  EXPECT_EQ(ClassicContext::GroupId("group_id_limit_more"), INVALID_GROUP_ID);
+  EXPECT_EQ(ClassicContext::GroupId(DEFAULT_GROUP_NAME), 0);
+  ClassicContext::Notify(INVALID_GROUP_ID);
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
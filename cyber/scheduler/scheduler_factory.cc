@@ -29,6 +29,7 @@
 #include "cyber/common/util.h"
 #include "cyber/scheduler/policy/scheduler_choreography.h"
 #include "cyber/scheduler/policy/scheduler_classic.h"
+#include "cyber/scheduler/policy/scheduler_stealing.h"
 #include "cyber/scheduler/scheduler.h"
 
 namespace apollo {
@@ -67,6 +68,8 @@ Scheduler* Instance() {
         obj = new SchedulerClassic();
       } else if (!policy.compare("choreography")) {
         obj = new SchedulerChoreography();
+      } else if (!policy.compare("stealing")) {
+        obj = new SchedulerStealing();
       } else {
         AWARN << "Invalid scheduler policy: " << policy;
         obj = new SchedulerClassic();
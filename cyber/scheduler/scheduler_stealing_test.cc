@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/scheduler_stealing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/cyber.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/policy/stealing_context.h"
+#include "cyber/scheduler/processor.h"
+#include "cyber/scheduler/scheduler_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::RoutineState;
+
+namespace {
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// croutines that run once per notification and record when they ran
+struct WaitingRoutines {
+  explicit WaitingRoutines(int num) : runs(num), run_time(num) {
+    for (int i = 0; i < num; ++i) {
+      auto cr = std::make_shared<CRoutine>([this, i]() {
+        for (;;) {
+          run_time[i].store(NowNs());
+          runs[i].fetch_add(1);
+          CRoutine::Yield(RoutineState::DATA_WAIT);
+        }
+      });
+      cr->set_id(i);
+      cr->set_name("waiting_" + std::to_string(i));
+      crs.emplace_back(cr);
+    }
+  }
+
+  bool WaitRuns(int i, uint64_t num) {
+    auto deadline = NowNs() + 1000000000ULL;
+    while (runs[i].load() < num) {
+      if (NowNs() > deadline) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  std::vector<std::atomic<uint64_t>> runs;
+  std::vector<std::atomic<uint64_t>> run_time;
+};
+
+// wakes up croutines one at a time and returns the mean wake-to-run latency
+template <typename NotifyFunc>
+uint64_t MeasureWakeLatency(WaitingRoutines* routines, const NotifyFunc& notify,
+                            int rounds) {
+  const int num = static_cast<int>(routines->crs.size());
+  for (int i = 0; i < num; ++i) {
+    EXPECT_TRUE(routines->WaitRuns(i, 1));
+  }
+  uint64_t total = 0;
+  for (int round = 0; round < rounds; ++round) {
+    int i = (round * 7919) % num;
+    auto expected = routines->runs[i].load() + 1;
+    auto start = NowNs();
+    notify(i);
+    EXPECT_TRUE(routines->WaitRuns(i, expected));
+    total += routines->run_time[i].load() - start;
+  }
+  return total / rounds;
+}
+
+}  // namespace
+
+TEST(SchedulerStealingTest, notify_and_steal) {
+  const int kProcNum = 2;
+  std::vector<std::shared_ptr<StealingContext>> ctxs;
+  std::vector<StealingContext*> group;
+  for (int i = 0; i < kProcNum; ++i) {
+    ctxs.emplace_back(std::make_shared<StealingContext>());
+    group.emplace_back(ctxs.back().get());
+  }
+  for (auto& ctx : ctxs) {
+    ctx->SetSiblings(group);
+  }
+  std::vector<std::shared_ptr<Processor>> procs;
+  for (auto& ctx : ctxs) {
+    procs.emplace_back(std::make_shared<Processor>());
+    procs.back()->BindContext(ctx);
+  }
+
+  // every croutine lives on the first processor, the second one steals
+  WaitingRoutines routines(20);
+  std::vector<StealingTaskPtr> tasks;
+  for (auto& cr : routines.crs) {
+    tasks.emplace_back(std::make_shared<StealingTask>(cr));
+    tasks.back()->home = ctxs[0].get();
+    StealingContext::Dispatch(tasks.back());
+  }
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(routines.WaitRuns(i, 1));
+  }
+
+  // repeated notifications before it runs queue a croutine only once
+  for (int round = 2; round < 10; ++round) {
+    for (auto& task : tasks) {
+      StealingContext::Notify(task);
+      StealingContext::Notify(task);
+    }
+    for (int i = 0; i < 20; ++i) {
+      EXPECT_TRUE(routines.WaitRuns(i, round));
+    }
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_LE(routines.runs[i].load(), 18);
+  }
+
+  for (auto& ctx : ctxs) {
+    ctx->Shutdown();
+  }
+  for (auto& proc : procs) {
+    proc->Stop();
+  }
+}
+
+TEST(SchedulerStealingTest, sched_stealing) {
+  GlobalData::Instance()->SetProcessGroup("example_sched_stealing");
+  auto sched = dynamic_cast<SchedulerStealing*>(scheduler::Instance());
+  ASSERT_NE(sched, nullptr);
+
+  std::atomic<int> count = {0};
+  auto cr = std::make_shared<CRoutine>([&count]() { count++; });
+  auto task_id = GlobalData::RegisterTaskName("ABC");
+  cr->set_id(task_id);
+  cr->set_name("ABC");
+  EXPECT_TRUE(sched->DispatchTask(cr));
+  // dispatch the same task
+  EXPECT_FALSE(sched->DispatchTask(cr));
+  auto deadline = NowNs() + 1000000000ULL;
+  while (count.load() == 0 && NowNs() < deadline) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(count.load(), 1);
+  EXPECT_TRUE(sched->RemoveTask("ABC"));
+  EXPECT_FALSE(sched->NotifyTask(task_id));
+
+  // group3 has no processor to run its tasks
+  auto orphan = std::make_shared<CRoutine>([]() {});
+  orphan->set_id(GlobalData::RegisterTaskName("F"));
+  orphan->set_name("F");
+  EXPECT_FALSE(sched->DispatchTask(orphan));
+  sched->Shutdown();
+}
+
+// Wake-to-run latency of one croutine out of 10 or 500 in a group, with the
+// classic context scanning the whole group and the stealing context popping
+// its ready queue.
+TEST(SchedulerStealingTest, wake_latency_benchmark) {
+  const int kProcNum = 2;
+  const int kRounds = 2000;
+  for (int num : {10, 500}) {
+    uint64_t classic_ns = 0;
+    {
+      std::string group = "wake_bench_" + std::to_string(num);
+      std::vector<std::shared_ptr<ClassicContext>> ctxs;
+      std::vector<std::shared_ptr<Processor>> procs;
+      for (int i = 0; i < kProcNum; ++i) {
+        ctxs.emplace_back(std::make_shared<ClassicContext>(group));
+        procs.emplace_back(std::make_shared<Processor>());
+        procs.back()->BindContext(ctxs.back());
+      }
+      WaitingRoutines routines(num);
+      for (auto& cr : routines.crs) {
+        cr->set_group_name(group);
+        base::WriteLockGuard<base::AtomicRWLock> lk(
+            ClassicContext::rq_locks_[group].at(0));
+        ClassicContext::cr_group_[group].at(0).emplace_back(cr);
+      }
+      ClassicContext::Notify(group);
+      classic_ns = MeasureWakeLatency(
+          &routines,
+          [&](int i) {
+            auto& cr = routines.crs[i];
+            if (cr->state() == RoutineState::DATA_WAIT) {
+              cr->SetUpdateFlag();
+            }
+            ClassicContext::Notify(group);
+          },
+          kRounds);
+      for (auto& ctx : ctxs) {
+        ctx->Shutdown();
+      }
+      for (auto& proc : procs) {
+        proc->Stop();
+      }
+      for (auto& cr : routines.crs) {
+        ClassicContext::RemoveCRoutine(cr);
+      }
+    }
+
+    uint64_t stealing_ns = 0;
+    {
+      std::vector<std::shared_ptr<StealingContext>> ctxs;
+      std::vector<StealingContext*> group;
+      for (int i = 0; i < kProcNum; ++i) {
+        ctxs.emplace_back(std::make_shared<StealingContext>());
+        group.emplace_back(ctxs.back().get());
+      }
+      std::vector<std::shared_ptr<Processor>> procs;
+      for (auto& ctx : ctxs) {
+        ctx->SetSiblings(group);
+        procs.emplace_back(std::make_shared<Processor>());
+        procs.back()->BindContext(ctx);
+      }
+      WaitingRoutines routines(num);
+      std::vector<StealingTaskPtr> tasks;
+      for (int i = 0; i < num; ++i) {
+        tasks.emplace_back(std::make_shared<StealingTask>(routines.crs[i]));
+        tasks.back()->home = group[i % kProcNum];
+        StealingContext::Dispatch(tasks.back());
+      }
+      stealing_ns = MeasureWakeLatency(
+          &routines, [&](int i) { StealingContext::Notify(tasks[i]); },
+          kRounds);
+      for (auto& ctx : ctxs) {
+        ctx->Shutdown();
+      }
+      for (auto& proc : procs) {
+        proc->Stop();
+      }
+    }
+
+    std::cout << num << " croutines, wake-to-run latency: classic "
+              << classic_ns / 1000.0 << "us, stealing "
+              << stealing_ns / 1000.0 << "us" << std::endl;
+  }
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::Clear();
+  return res;
+}
@@ -16,9 +16,8 @@
 
 #include "cyber/timer/timer.h"
 
-#include <cmath>
-
 #include "cyber/common/global_data.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -61,68 +60,46 @@ bool Timer::InitTimerTask() {
 
   task_.reset(new TimerTask(timer_id_));
   task_->interval_ms = timer_opt_.period;
-  task_->next_fire_duration_ms = task_->interval_ms;
-  if (timer_opt_.oneshot) {
-    std::weak_ptr<TimerTask> task_weak_ptr = task_;
-    task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
-      auto task = task_weak_ptr.lock();
-      if (task) {
-        std::lock_guard<std::mutex> lg(task->mutex);
-        callback();
-      }
-    };
-  } else {
-    std::weak_ptr<TimerTask> task_weak_ptr = task_;
-    task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
-      auto task = task_weak_ptr.lock();
-      if (!task) {
-        return;
-      }
-      std::lock_guard<std::mutex> lg(task->mutex);
-      auto start = Time::MonoTime().ToNanosecond();
-      callback();
-      auto end = Time::MonoTime().ToNanosecond();
-      uint64_t execute_time_ns = end - start;
-      uint64_t execute_time_ms =
-#if defined(__aarch64__)
-          ::llround(static_cast<double>(execute_time_ns) / 1e6);
-#else
-          std::llround(static_cast<double>(execute_time_ns) / 1e6);
-#endif
-      if (task->last_execute_time_ns == 0) {
-        task->last_execute_time_ns = start;
-      } else {
-        task->accumulated_error_ns +=
-            start - task->last_execute_time_ns - task->interval_ms * 1000000;
-      }
-      ADEBUG << "start: " << start << "\t last: " << task->last_execute_time_ns
-             << "\t execut time:" << execute_time_ms
-             << "\t accumulated_error_ns: " << task->accumulated_error_ns;
-      task->last_execute_time_ns = start;
-      if (execute_time_ms >= task->interval_ms) {
-        task->next_fire_duration_ms = TIMER_RESOLUTION_MS;
-      } else {
-#if defined(__aarch64__)
-        int64_t accumulated_error_ms = ::llround(
-#else
-        int64_t accumulated_error_ms = std::llround(
-#endif
-            static_cast<double>(task->accumulated_error_ns) / 1e6);
-        if (static_cast<int64_t>(task->interval_ms - execute_time_ms -
-                                 TIMER_RESOLUTION_MS) >= accumulated_error_ms) {
-          task->next_fire_duration_ms =
-              task->interval_ms - execute_time_ms - accumulated_error_ms;
-        } else {
-          task->next_fire_duration_ms = TIMER_RESOLUTION_MS;
-        }
-        ADEBUG << "error ms: " << accumulated_error_ms
-               << "  execute time: " << execute_time_ms
-               << " next fire: " << task->next_fire_duration_ms
-               << " error ns: " << task->accumulated_error_ns;
-      }
-      TimingWheel::Instance()->AddTask(task);
-    };
-  }
+  task_->deadline_ns =
+      Time::MonoTime().ToNanosecond() + task_->interval_ms * 1000000;
+  std::weak_ptr<TimerTask> task_weak_ptr = task_;
+  bool oneshot = timer_opt_.oneshot;
+  task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr,
+                     oneshot]() {
+    auto task = task_weak_ptr.lock();
+    if (!task) {
+      return;
+    }
+    std::lock_guard<std::mutex> lg(task->mutex);
+    auto start = Time::MonoTime().ToNanosecond();
+    callback();
+    auto end = Time::MonoTime().ToNanosecond();
+
+    auto& statistics = task->statistics;
+    ++statistics.fire_num;
+    statistics.lateness.Add(
+        start > task->deadline_ns ? start - task->deadline_ns : 0);
+    statistics.callback.Add(end - start);
+    ADEBUG << "timer [" << task->timer_id_ << "] late "
+           << static_cast<int64_t>(start - task->deadline_ns)
+           << "ns, execute time " << end - start << "ns";
+    if (oneshot) {
+      return;
+    }
+
+    // deadlines stay on the grid of the first one, so neither the lateness
+    // nor the execute time of one fire delays the following ones
+    uint64_t interval_ns = task->interval_ms * 1000000;
+    task->deadline_ns += interval_ns;
+    if (task->deadline_ns <= end) {
+      // the callback overran the next deadline, skip the missed fires
+      // instead of firing them back to back
+      uint64_t missed = (end - task->deadline_ns) / interval_ns + 1;
+      statistics.overrun_num += missed;
+      task->deadline_ns += missed * interval_ns;
+    }
+    TimingWheel::Instance()->AddTask(task);
+  };
   return true;
 }
 
@@ -151,6 +128,16 @@ void Timer::Stop() {
   }
 }
 
+bool Timer::GetStatistics(TimerStatistics* statistics) {
+  auto task = task_;
+  if (task == nullptr || statistics == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lg(task->mutex);
+  *statistics = task->statistics;
+  return true;
+}
+
 Timer::~Timer() {
   if (task_) {
     Stop();
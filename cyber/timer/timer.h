@@ -20,6 +20,7 @@
 #include <atomic>
 #include <memory>
 
+#include "cyber/timer/timer_statistics.h"
 #include "cyber/timer/timing_wheel.h"
 
 namespace apollo {
@@ -109,6 +110,15 @@ class Timer {
    */
   void Stop();
 
+  /**
+   * @brief Get the lateness and execute time histograms of the callback
+   * since the last Start
+   *
+   * @param statistics Filled with a copy of the statistics
+   * @return false if the timer is not started
+   */
+  bool GetStatistics(TimerStatistics* statistics);
+
  private:
   bool InitTimerTask();
   uint64_t timer_id_;
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIMER_TIMER_STATISTICS_H_
+#define CYBER_TIMER_TIMER_STATISTICS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief Histogram of durations in power of two microsecond buckets.
+ * bucket 0 counts durations below 1us, bucket i counts [2^(i-1), 2^i) us
+ * and the last bucket everything from about half a second up.
+ */
+struct TimerHistogram {
+  static constexpr size_t kBucketNum = 21;
+
+  void Add(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    size_t index = 0;
+    while (us != 0 && index < kBucketNum - 1) {
+      us >>= 1;
+      ++index;
+    }
+    ++buckets[index];
+    ++count;
+    total_ns += ns;
+    if (ns > max_ns) {
+      max_ns = ns;
+    }
+  }
+
+  /**
+   * @brief Upper bound of the bucket holding the given quantile, in us.
+   * Returns 0 if nothing was recorded.
+   */
+  uint64_t QuantileUs(double quantile) const {
+    if (count == 0) {
+      return 0;
+    }
+    auto target = static_cast<uint64_t>(quantile * static_cast<double>(count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      seen += buckets[i];
+      if (seen > target) {
+        return uint64_t(1) << i;
+      }
+    }
+    return uint64_t(1) << (kBucketNum - 1);
+  }
+
+  uint64_t MeanNs() const { return count == 0 ? 0 : total_ns / count; }
+
+  uint64_t buckets[kBucketNum] = {0};
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+};
+
+struct TimerStatistics {
+  uint64_t fire_num = 0;
+  // fires skipped because the callback overran the following deadline
+  uint64_t overrun_num = 0;
+  // from the deadline until the callback starts
+  TimerHistogram lateness;
+  // time spent in the callback
+  TimerHistogram callback;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_TIMER_STATISTICS_H_
@@ -20,6 +20,8 @@
 #include <functional>
 #include <mutex>
 
+#include "cyber/timer/timer_statistics.h"
+
 namespace apollo {
 namespace cyber {
 
@@ -30,10 +32,11 @@ struct TimerTask {
   uint64_t timer_id_ = 0;
   std::function<void()> callback;
   uint64_t interval_ms = 0;
-  uint64_t remainder_interval_ms = 0;
-  uint64_t next_fire_duration_ms = 0;
-  int64_t accumulated_error_ns = 0;
-  uint64_t last_execute_time_ns = 0;
+  // monotonic time the task is due at
+  uint64_t deadline_ns = 0;
+  // tick of the timing wheel the task is due at
+  uint64_t expire_tick = 0;
+  TimerStatistics statistics;
   std::mutex mutex;
 };
 
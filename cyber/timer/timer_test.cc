@@ -18,6 +18,7 @@
 
 #include "cyber/timer/timer.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -26,13 +27,16 @@
 #include "cyber/common/util.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 namespace timer {
 
+using cyber::Time;
 using cyber::Timer;
 using cyber::TimerOption;
+using cyber::TimerStatistics;
 
 TEST(TimerTest, one_shot) {
   int count = 0;
@@ -48,6 +52,41 @@ TEST(TimerTest, one_shot) {
   timer.Stop();
 }
 
+TEST(TimerTest, long_one_shot) {
+  // due after a whole turn of the first wheel level, fires after a cascade
+  std::atomic<uint64_t> fire_time = {0};
+  auto start = Time::MonoTime().ToNanosecond();
+  Timer timer(
+      1200, [&fire_time] { fire_time = Time::MonoTime().ToNanosecond(); },
+      true);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1700));
+  timer.Stop();
+  ASSERT_NE(0, fire_time.load());
+  EXPECT_GE(fire_time - start, 1200 * 1000000UL);
+}
+
+TEST(TimerTest, statistics) {
+  Timer timer(
+      5, [] { std::this_thread::sleep_for(std::chrono::microseconds(100)); },
+      false);
+  TimerStatistics statistics;
+  EXPECT_FALSE(timer.GetStatistics(&statistics));
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_TRUE(timer.GetStatistics(&statistics));
+  timer.Stop();
+
+  // deadlines do not drift, every 5ms is either fired or counted as overrun
+  EXPECT_GE(statistics.fire_num + statistics.overrun_num, 90);
+  EXPECT_LE(statistics.fire_num + statistics.overrun_num, 101);
+  EXPECT_EQ(statistics.fire_num, statistics.lateness.count);
+  EXPECT_EQ(statistics.fire_num, statistics.callback.count);
+  EXPECT_GE(statistics.callback.MeanNs(), 100000);
+  EXPECT_GE(statistics.callback.QuantileUs(0.5), 128);
+  EXPECT_FALSE(timer.GetStatistics(&statistics));
+}
+
 TEST(TimerTest, cycle) {
   using TimerPtr = std::shared_ptr<Timer>;
   int count = 0;
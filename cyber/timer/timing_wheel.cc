@@ -16,9 +16,13 @@
 
 #include "cyber/timer/timing_wheel.h"
 
-#include <cmath>
+#include <time.h>
 
+#include <cerrno>
+
+#include "cyber/common/global_data.h"
 #include "cyber/task/task.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -27,6 +31,12 @@ void TimingWheel::Start() {
   std::lock_guard<std::mutex> lock(running_mutex_);
   if (!running_) {
     ADEBUG << "TimeWheel start ok";
+    {
+      // keep the deadlines of tasks left from a previous run in place
+      std::lock_guard<std::mutex> wheel_lock(wheel_mutex_);
+      start_time_ns_ =
+          Time::MonoTime().ToNanosecond() - current_tick_ * resolution_ns_;
+    }
     running_ = true;
     tick_thread_ = std::thread([this]() { this->TickFunc(); });
     scheduler::Instance()->SetInnerThreadAttr("timer", &tick_thread_);
@@ -44,104 +54,124 @@ void TimingWheel::Shutdown() {
 }
 
 void TimingWheel::Tick() {
-  auto& bucket = work_wheel_[current_work_wheel_index_];
+  std::list<std::weak_ptr<TimerTask>> expired;
   {
-    std::lock_guard<std::mutex> lock(bucket.mutex());
-    auto ite = bucket.task_list().begin();
-    while (ite != bucket.task_list().end()) {
-      auto task = ite->lock();
-      if (task) {
-        ADEBUG << "index: " << current_work_wheel_index_
-               << " timer id: " << task->timer_id_;
-        auto* callback =
-            reinterpret_cast<std::function<void()>*>(&(task->callback));
-        cyber::Async([this, callback] {
-          if (this->running_) {
-            (*callback)();
-          }
-        });
+    std::lock_guard<std::mutex> lock(wheel_mutex_);
+    auto index = GetIndex(current_tick_, 0);
+    if (index == 0) {
+      // a turn of level 0 is done, spread the next bucket of every level
+      // whose lower levels have all wrapped
+      for (uint64_t level = 1; level < WHEEL_LEVEL_NUM; ++level) {
+        auto level_index = GetIndex(current_tick_, level);
+        Cascade(level, level_index);
+        if (level_index != 0) {
+          break;
+        }
       }
-      ite = bucket.task_list().erase(ite);
     }
+    auto& bucket = wheel_[0][index];
+    std::lock_guard<std::mutex> bucket_lock(bucket.mutex());
+    expired.swap(bucket.task_list());
+    ++current_tick_;
+  }
+  for (auto& weak_task : expired) {
+    auto task = weak_task.lock();
+    if (!task) {
+      continue;
+    }
+    ADEBUG << "tick: " << tick_count_ << " timer id: " << task->timer_id_;
+    cyber::Async([this, weak_task] {
+      auto task = weak_task.lock();
+      if (task && this->running_) {
+        task->callback();
+      }
+    });
   }
+  ++tick_count_;
 }
 
 void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
-  AddTask(task, current_work_wheel_index_);
-}
-
-void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task,
-                          const uint64_t current_work_wheel_index) {
   if (!running_) {
     Start();
   }
-  auto work_wheel_index = current_work_wheel_index +
-                          static_cast<uint64_t>(std::ceil(
-                              static_cast<double>(task->next_fire_duration_ms) /
-                              TIMER_RESOLUTION_MS));
-  if (work_wheel_index >= WORK_WHEEL_SIZE) {
-    auto real_work_wheel_index = GetWorkWheelIndex(work_wheel_index);
-    task->remainder_interval_ms = real_work_wheel_index;
-    auto assistant_ticks = work_wheel_index / WORK_WHEEL_SIZE;
-    if (assistant_ticks == 1 &&
-        real_work_wheel_index < current_work_wheel_index_) {
-      work_wheel_[real_work_wheel_index].AddTask(task);
-      ADEBUG << "add task to work wheel. index :" << real_work_wheel_index;
-    } else {
-      auto assistant_wheel_index = 0;
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        assistant_wheel_index = GetAssistantWheelIndex(
-            current_assistant_wheel_index_ + assistant_ticks);
-        assistant_wheel_[assistant_wheel_index].AddTask(task);
-      }
-      ADEBUG << "add task to assistant wheel. index : "
-             << assistant_wheel_index;
-    }
+  std::lock_guard<std::mutex> lock(wheel_mutex_);
+  if (task->deadline_ns > start_time_ns_) {
+    task->expire_tick =
+        (task->deadline_ns - start_time_ns_ + resolution_ns_ - 1) /
+        resolution_ns_;
   } else {
-    work_wheel_[work_wheel_index].AddTask(task);
-    ADEBUG << "add task [" << task->timer_id_
-           << "] to work wheel. index :" << work_wheel_index;
+    task->expire_tick = 0;
   }
+  AddTaskLocked(task);
 }
 
-void TimingWheel::Cascade(const uint64_t assistant_wheel_index) {
-  auto& bucket = assistant_wheel_[assistant_wheel_index];
-  std::lock_guard<std::mutex> lock(bucket.mutex());
-  auto ite = bucket.task_list().begin();
-  while (ite != bucket.task_list().end()) {
-    auto task = ite->lock();
+void TimingWheel::AddTaskLocked(const std::shared_ptr<TimerTask>& task) {
+  static const uint64_t kMaxDelta =
+      (uint64_t(1) << (WHEEL_LEVEL_NUM * WHEEL_BITS)) - 1;
+  if (task->expire_tick < current_tick_) {
+    task->expire_tick = current_tick_;
+  } else if (task->expire_tick - current_tick_ > kMaxDelta) {
+    task->expire_tick = current_tick_ + kMaxDelta;
+  }
+  auto delta = task->expire_tick - current_tick_;
+  uint64_t level = 0;
+  while (level + 1 < WHEEL_LEVEL_NUM &&
+         delta >= (uint64_t(1) << ((level + 1) * WHEEL_BITS))) {
+    ++level;
+  }
+  auto index = GetIndex(task->expire_tick, level);
+  wheel_[level][index].AddTask(task);
+  ADEBUG << "add task [" << task->timer_id_ << "] to wheel level " << level
+         << " index " << index;
+}
+
+void TimingWheel::Cascade(const uint64_t level, const uint64_t index) {
+  std::list<std::weak_ptr<TimerTask>> tasks;
+  {
+    auto& bucket = wheel_[level][index];
+    std::lock_guard<std::mutex> lock(bucket.mutex());
+    tasks.swap(bucket.task_list());
+  }
+  for (auto& weak_task : tasks) {
+    auto task = weak_task.lock();
     if (task) {
-      work_wheel_[task->remainder_interval_ms].AddTask(task);
+      AddTaskLocked(task);
     }
-    ite = bucket.task_list().erase(ite);
   }
 }
 
 void TimingWheel::TickFunc() {
-  Rate rate(TIMER_RESOLUTION_MS * 1000000);  // ms to ns
   while (running_) {
-    Tick();
-    // AINFO_EVERY(1000) << "Tick " << TickCount();
-    tick_count_++;
-    rate.Sleep();
-    {
-      std::lock_guard<std::mutex> lock(current_work_wheel_index_mutex_);
-      current_work_wheel_index_ =
-          GetWorkWheelIndex(current_work_wheel_index_ + 1);
+    auto now = Time::MonoTime().ToNanosecond();
+    // catch up on the ticks missed while this thread was not running
+    while (running_ && start_time_ns_ + current_tick_ * resolution_ns_ <= now) {
+      Tick();
     }
-    if (current_work_wheel_index_ == 0) {
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        current_assistant_wheel_index_ =
-            GetAssistantWheelIndex(current_assistant_wheel_index_ + 1);
-      }
-      Cascade(current_assistant_wheel_index_);
+    // sleep to the absolute time of the next tick, so the time spent ticking
+    // does not add up into drift
+    auto next_ns = start_time_ns_ + current_tick_ * resolution_ns_;
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(next_ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(next_ns % 1000000000);  // NOLINT
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR) {
     }
   }
 }
 
-TimingWheel::TimingWheel() {}
+TimingWheel::TimingWheel() {
+  auto& global_conf = common::GlobalData::Instance()->Config();
+  if (global_conf.has_timer_conf() &&
+      global_conf.timer_conf().has_resolution_us()) {
+    auto resolution_us = global_conf.timer_conf().resolution_us();
+    if (resolution_us < TIMER_MIN_RESOLUTION_US) {
+      AWARN << "timer resolution " << resolution_us << "us is too fine, use "
+            << TIMER_MIN_RESOLUTION_US << "us";
+      resolution_us = TIMER_MIN_RESOLUTION_US;
+    }
+    resolution_ns_ = static_cast<uint64_t>(resolution_us) * 1000;
+  }
+}
 
 }  // namespace cyber
 }  // namespace apollo
@@ -17,15 +17,16 @@
 #ifndef CYBER_TIMER_TIMING_WHEEL_H_
 #define CYBER_TIMER_TIMING_WHEEL_H_
 
+#include <atomic>
 #include <future>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/scheduler/scheduler_factory.h"
-#include "cyber/time/rate.h"
 #include "cyber/timer/timer_bucket.h"
 
 namespace apollo {
@@ -33,11 +34,15 @@ namespace cyber {
 
 struct TimerTask;
 
-static const uint64_t WORK_WHEEL_SIZE = 512;
-static const uint64_t ASSISTANT_WHEEL_SIZE = 64;
-static const uint64_t TIMER_RESOLUTION_MS = 2;
-static const uint64_t TIMER_MAX_INTERVAL_MS =
-    WORK_WHEEL_SIZE * ASSISTANT_WHEEL_SIZE * TIMER_RESOLUTION_MS;
+// Each level of the wheel has WHEEL_SIZE buckets and one bucket of a level
+// spans a whole turn of the level below, so WHEEL_LEVEL_NUM levels cover
+// WHEEL_SIZE^WHEEL_LEVEL_NUM ticks.
+static const uint64_t WHEEL_BITS = 8;
+static const uint64_t WHEEL_SIZE = 1 << WHEEL_BITS;
+static const uint64_t WHEEL_LEVEL_NUM = 4;
+static const uint64_t TIMER_RESOLUTION_US = 2000;
+static const uint64_t TIMER_MIN_RESOLUTION_US = 50;
+static const uint64_t TIMER_MAX_INTERVAL_MS = 512 * 64 * 2;
 
 class TimingWheel {
  public:
@@ -53,34 +58,37 @@ class TimingWheel {
 
   void Tick();
 
+  /**
+   * @brief Schedule the task to fire at task->deadline_ns. Deadlines already
+   * passed fire on the next tick.
+   */
   void AddTask(const std::shared_ptr<TimerTask>& task);
 
-  void AddTask(const std::shared_ptr<TimerTask>& task,
-               const uint64_t current_work_wheel_index);
-
-  void Cascade(const uint64_t assistant_wheel_index);
+  void Cascade(const uint64_t level, const uint64_t index);
 
   void TickFunc();
 
   inline uint64_t TickCount() const { return tick_count_; }
 
+  inline uint64_t ResolutionNs() const { return resolution_ns_; }
+
  private:
-  inline uint64_t GetWorkWheelIndex(const uint64_t index) {
-    return index & (WORK_WHEEL_SIZE - 1);
-  }
-  inline uint64_t GetAssistantWheelIndex(const uint64_t index) {
-    return index & (ASSISTANT_WHEEL_SIZE - 1);
+  inline uint64_t GetIndex(const uint64_t tick, const uint64_t level) {
+    return (tick >> (level * WHEEL_BITS)) & (WHEEL_SIZE - 1);
   }
+  void AddTaskLocked(const std::shared_ptr<TimerTask>& task);
 
-  bool running_ = false;
-  uint64_t tick_count_ = 0;
+  std::atomic<bool> running_ = {false};
+  std::atomic<uint64_t> tick_count_ = {0};
   std::mutex running_mutex_;
-  TimerBucket work_wheel_[WORK_WHEEL_SIZE];
-  TimerBucket assistant_wheel_[ASSISTANT_WHEEL_SIZE];
-  uint64_t current_work_wheel_index_ = 0;
-  std::mutex current_work_wheel_index_mutex_;
-  uint64_t current_assistant_wheel_index_ = 0;
-  std::mutex current_assistant_wheel_index_mutex_;
+  uint64_t resolution_ns_ = TIMER_RESOLUTION_US * 1000;
+  // monotonic time of tick 0
+  uint64_t start_time_ns_ = 0;
+  // guards the wheel and current_tick_
+  std::mutex wheel_mutex_;
+  TimerBucket wheel_[WHEEL_LEVEL_NUM][WHEEL_SIZE];
+  // the next tick to be processed
+  uint64_t current_tick_ = 0;
   std::thread tick_thread_;
 
   DECLARE_SINGLETON(TimingWheel)
@@ -72,6 +72,10 @@ bool Info::Display(const std::string& file) {
   }
   std::cout << std::endl;
 
+  // compress
+  std::cout << std::setw(w) << "compress: "
+            << proto::CompressType_Name(hdr.compress()) << std::endl;
+
   // is_complete
   std::cout << std::setw(w) << "is_complete:";
   if (hdr.is_complete()) {
@@ -33,6 +33,7 @@
 using apollo::cyber::common::GetFileName;
 using apollo::cyber::common::StringToUnixSeconds;
 using apollo::cyber::common::UnixSecondsToString;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::record::HeaderBuilder;
 using apollo::cyber::record::Info;
 using apollo::cyber::record::Player;
@@ -42,7 +43,7 @@ using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
 const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:k:i:m:h";
+const char RECORD_OPTIONS[] = "o:ac:k:i:m:z:h";
 const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:h";
 const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
@@ -145,6 +146,10 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-m, --segment-size <MB>\t\t\t" << command
                   << " segmented every n megabyte(s)" << std::endl;
         break;
+      case 'z':
+        std::cout << "\t-z, --compress <lz4|zstd>\t\t" << command
+                  << " with chunks compressed" << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -170,7 +175,7 @@ int main(int argc, char** argv) {
   }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:h";
+  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:z:h";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
@@ -186,6 +191,7 @@ int main(int argc, char** argv) {
       {"preload", required_argument, nullptr, 'p'},
       {"segment-interval", required_argument, nullptr, 'i'},
       {"segment-size", required_argument, nullptr, 'm'},
+      {"compress", required_argument, nullptr, 'z'},
       {"help", no_argument, nullptr, 'h'}};
 
   std::vector<std::string> opt_file_vec;
@@ -346,6 +352,19 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'z': {
+        std::string compress(optarg);
+        if (compress == "lz4") {
+          opt_header.set_compress(CompressType::COMPRESS_LZ4);
+        } else if (compress == "zstd") {
+          opt_header.set_compress(CompressType::COMPRESS_ZSTD);
+        } else if (compress != "none") {
+          std::cout << "Invalid argument: -z/--compress " << compress
+                    << std::endl;
+          return -1;
+        }
+        break;
+      }
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -16,8 +16,10 @@
 
 #include "cyber/tools/cyber_recorder/player/play_task_producer.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
+#include <utility>
 
 #include "cyber/common/log.h"
 #include "cyber/common/time_conversion.h"
@@ -32,6 +34,7 @@ namespace record {
 const uint32_t PlayTaskProducer::kMinTaskBufferSize = 500;
 const uint32_t PlayTaskProducer::kPreloadTimeSec = 3;
 const uint64_t PlayTaskProducer::kSleepIntervalNanoSec = 1000000;
+const uint64_t PlayTaskProducer::kMinReadaheadBytes = 4 * 1024 * 1024;
 
 PlayTaskProducer::PlayTaskProducer(const TaskBufferPtr& task_buffer,
                                    const PlayParam& play_param)
@@ -95,7 +98,7 @@ bool PlayTaskProducer::ReadRecordInfo() {
 
   // loop each file
   for (auto& file : play_param_.files_to_play) {
-    auto record_reader = std::make_shared<RecordReader>(file);
+    auto record_reader = std::make_shared<RecordReader>(file, true);
     if (!record_reader->IsValid()) {
       continue;
     }
@@ -184,6 +187,20 @@ bool PlayTaskProducer::UpdatePlayParam() {
           << kPreloadTimeSec << " seconds.";
     play_param_.preload_time_s = kPreloadTimeSec;
   }
+
+  // prefetch each record about one preload window ahead of playback
+  for (auto& reader : record_readers_) {
+    const auto& header = reader->GetHeader();
+    if (header.end_time() <= header.begin_time()) {
+      continue;
+    }
+    double bytes_per_sec = static_cast<double>(header.size()) * 1e9 /
+                           static_cast<double>(header.end_time() -
+                                               header.begin_time());
+    reader->SetReadahead(std::max(
+        kMinReadaheadBytes,
+        static_cast<uint64_t>(bytes_per_sec * play_param_.preload_time_s)));
+  }
   return true;
 }
 
@@ -262,7 +279,9 @@ void PlayTaskProducer::ThreadFunc() {
           continue;
         }
 
-        auto raw_msg = std::make_shared<message::RawMessage>(itr->content);
+        // the iterator overwrites its message on the next step
+        auto raw_msg =
+            std::make_shared<message::RawMessage>(std::move(itr->content));
         auto task = std::make_shared<PlayTask>(
             raw_msg, search->second, itr->time, itr->time + plus_time_ns);
         task_buffer_->Push(task);
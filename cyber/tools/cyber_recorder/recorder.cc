@@ -55,6 +55,9 @@ bool Recorder::Start() {
   }
 
   writer_.reset(new RecordWriter(header_));
+  // blocking here would only move the loss into the reader queues, where
+  // it cannot be counted
+  writer_->SetDropWhenBehind(true);
   if (!writer_->Open(output_)) {
     AERROR << "Datafile open file error.";
     return false;
@@ -91,6 +94,13 @@ bool Recorder::Stop() {
     return false;
   }
   writer_->Close();
+  for (const auto& item : channel_reader_map_) {
+    uint64_t dropped = writer_->GetDroppedMessageNumber(item.first);
+    if (dropped > 0) {
+      AWARN << "Dropped " << dropped << " messages of channel " << item.first
+            << ", the disk could not keep up.";
+    }
+  }
   node_.reset();
   if (display_thread_ && display_thread_->joinable()) {
     display_thread_->join();
@@ -223,8 +233,8 @@ void Recorder::ReaderCallback(const std::shared_ptr<RawMessage>& message,
   }
 
   message_time_ = Time::Now().ToNanosecond();
+  // failures are counted and logged by the writer
   if (!writer_->WriteMessage(channel_name, message, message_time_)) {
-    AERROR << "write data fail, channel: " << channel_name;
     return;
   }
 
@@ -236,7 +246,8 @@ void Recorder::ShowProgress() {
     std::cout << "\r[RUNNING]  Record Time: " << std::setprecision(3)
               << message_time_ / 1000000000
               << "    Progress: " << channel_reader_map_.size() << " channels, "
-              << message_count_ << " messages";
+              << message_count_ << " messages, "
+              << writer_->GetDroppedMessageNumber() << " dropped";
     std::cout.flush();
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
@@ -41,6 +41,7 @@ bool Recoverer::Proc() {
 
   // open output file
   proto::Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(reader_.GetHeader().compress());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
@@ -73,6 +74,7 @@ bool Recoverer::Proc() {
 
   // read through record file
   reader_.Reset();
+  ChunkHeader chdr;
   while (!reader_.EndOfFile()) {
     Section section;
     if (!reader_.ReadSection(&section)) {
@@ -97,15 +99,15 @@ bool Recoverer::Proc() {
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
         if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
           AINFO << "one chunk header section broken, skip it.";
+          chdr.Clear();
         }
         break;
       }
       case SectionType::SECTION_CHUNK_BODY: {
         ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
+        if (!reader_.ReadChunkBody(section.size, chdr, &cbd)) {
           AINFO << "one chunk body section broken, skip it";
           break;
         }
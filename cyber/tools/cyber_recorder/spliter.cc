@@ -68,6 +68,7 @@ bool Spliter::Proc() {
 
   // open output file
   Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(header.compress());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
@@ -77,9 +78,33 @@ bool Spliter::Proc() {
     return false;
   }
 
+  // with an index, write all channels up front and jump to the first chunk
+  // in range instead of reading through the file
+  bool channels_from_index = reader_.ReadIndex();
+  if (channels_from_index) {
+    for (const auto& single_idx : reader_.GetIndex().indexes()) {
+      if (single_idx.type() != SectionType::SECTION_CHANNEL) {
+        continue;
+      }
+      const ChannelCache& cache = single_idx.channel_cache();
+      if (IsChannelWanted(cache.name())) {
+        Channel chan;
+        chan.set_name(cache.name());
+        chan.set_message_type(cache.message_type());
+        chan.set_proto_desc(cache.proto_desc());
+        writer_.WriteChannel(chan);
+      }
+    }
+  }
+
   // read through record file
   bool skip_next_chunk_body(false);
+  ChunkHeader chdr;
   reader_.Reset();
+  if (!reader_.SeekTime(begin_time_)) {
+    AERROR << "seek to begin time failed.";
+    return false;
+  }
   while (!reader_.EndOfFile()) {
     Section section;
     if (!reader_.ReadSection(&section)) {
@@ -91,23 +116,21 @@ bool Spliter::Proc() {
     }
     switch (section.type) {
       case SectionType::SECTION_CHANNEL: {
+        if (channels_from_index) {
+          reader_.SkipSection(section.size);
+          break;
+        }
         Channel chan;
         if (!reader_.ReadSection<Channel>(section.size, &chan)) {
           AERROR << "read channel section fail.";
           return false;
         }
-        if (white_channels_.empty() ||
-            std::find(white_channels_.begin(), white_channels_.end(),
-                      chan.name()) != white_channels_.end()) {
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        chan.name()) == black_channels_.end()) {
-            writer_.WriteChannel(chan);
-          }
+        if (IsChannelWanted(chan.name())) {
+          writer_.WriteChannel(chan);
         }
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
         if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
           AERROR << "read chunk header section fail.";
           return false;
@@ -124,20 +147,12 @@ bool Spliter::Proc() {
           break;
         }
         ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
+        if (!reader_.ReadChunkBody(section.size, chdr, &cbd)) {
           AERROR << "read chunk body section fail.";
           return false;
         }
         for (int idx = 0; idx < cbd.messages_size(); ++idx) {
-          if (!white_channels_.empty() &&
-              std::find(white_channels_.begin(), white_channels_.end(),
-                        cbd.messages(idx).channel_name()) ==
-                  white_channels_.end()) {
-            continue;
-          }
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        cbd.messages(idx).channel_name()) !=
-              black_channels_.end()) {
+          if (!IsChannelWanted(cbd.messages(idx).channel_name())) {
             continue;
           }
           if (cbd.messages(idx).time() < begin_time_ ||
@@ -162,6 +177,16 @@ bool Spliter::Proc() {
   return true;
 }  // end for Proc()
 
+bool Spliter::IsChannelWanted(const std::string& channel_name) const {
+  if (!white_channels_.empty() &&
+      std::find(white_channels_.begin(), white_channels_.end(),
+                channel_name) == white_channels_.end()) {
+    return false;
+  }
+  return std::find(black_channels_.begin(), black_channels_.end(),
+                   channel_name) == black_channels_.end();
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -49,6 +49,8 @@ class Spliter {
   bool Proc();
 
  private:
+  bool IsChannelWanted(const std::string& channel_name) const;
+
   RecordFileReader reader_;
   RecordFileWriter writer_;
   std::string input_file_;
@@ -15,6 +15,9 @@
  *****************************************************************************/
 
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
+
+#include <chrono>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/scheduler/scheduler_factory.h"
@@ -26,6 +29,24 @@ namespace transport {
 
 using common::GlobalData;
 
+namespace {
+
+uint64_t SteadyNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void UpdateMax(std::atomic<uint64_t>* max, uint64_t value) {
+  uint64_t current = max->load();
+  while (value > current && !max->compare_exchange_weak(current, value)) {
+  }
+}
+
+}  // namespace
+
+const size_t ShmDispatcher::kMaxPendingTasks = 4096;
+
 ShmDispatcher::ShmDispatcher() : host_id_(0) { Init(); }
 
 ShmDispatcher::~ShmDispatcher() { Shutdown(); }
@@ -39,12 +60,43 @@ void ShmDispatcher::Shutdown() {
     thread_.join();
   }
 
+  for (auto& shard : shards_) {
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->cv.notify_all();
+    }
+    if (shard->thread.joinable()) {
+      shard->thread.join();
+    }
+  }
+
   {
-    ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+    WriteLockGuard<AtomicRWLock> lock(segments_lock_);
     segments_.clear();
   }
 }
 
+bool ShmDispatcher::GetDispatchStatistics(uint64_t channel_id,
+                                          DispatchStatistics* statistics) {
+  RETURN_VAL_IF_NULL(statistics, false);
+  DispatchCounterPtr counter = nullptr;
+  {
+    ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+    auto it = counters_.find(channel_id);
+    if (it == counters_.end()) {
+      return false;
+    }
+    counter = it->second;
+  }
+  statistics->msg_num = counter->msg_num.load();
+  statistics->total_wait_ns = counter->total_wait_ns.load();
+  statistics->max_wait_ns = counter->max_wait_ns.load();
+  statistics->total_handle_ns = counter->total_handle_ns.load();
+  statistics->max_handle_ns = counter->max_handle_ns.load();
+  statistics->drop_num = counter->drop_num.load();
+  return true;
+}
+
 void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
   uint64_t channel_id = self_attr.channel_id();
   WriteLockGuard<AtomicRWLock> lock(segments_lock_);
@@ -54,32 +106,57 @@ void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
   auto segment = SegmentFactory::CreateSegment(channel_id);
   segments_[channel_id] = segment;
   previous_indexes_[channel_id] = UINT32_MAX;
+  counters_[channel_id] = std::make_shared<DispatchCounter>();
+  notifier_->Subscribe(channel_id);
 }
 
-void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
+void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index,
+                                DeliveredMessages* delivered) {
   ADEBUG << "Reading sharedmem message: "
          << GlobalData::GetChannelById(channel_id)
          << " from block: " << block_index;
-  auto rb = std::make_shared<ReadableBlock>();
-  rb->index = block_index;
-  if (!segments_[channel_id]->AcquireBlockToRead(rb.get())) {
+  SegmentPtr segment = nullptr;
+  {
+    ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+    auto it = segments_.find(channel_id);
+    if (it == segments_.end()) {
+      return;
+    }
+    segment = it->second;
+  }
+
+  ReadableBlock acquired_block;
+  acquired_block.index = block_index;
+  if (!segment->AcquireBlockToRead(&acquired_block)) {
     AWARN << "fail to acquire block, channel: "
           << GlobalData::GetChannelById(channel_id)
           << " index: " << block_index;
     return;
   }
+  // the read lock is held until every message parsed from the block in
+  // place has been released
+  auto rb = segment->LeaseReadBlock(acquired_block);
 
   MessageInfo msg_info;
-  const char* msg_info_addr =
-      reinterpret_cast<char*>(rb->buf) + rb->block->msg_size();
-
-  if (msg_info.DeserializeFrom(msg_info_addr, rb->block->msg_info_size())) {
-    OnMessage(channel_id, rb, msg_info);
-  } else {
+  if (!msg_info.DeserializeFrom(rb->block->msg_info(),
+                                rb->block->msg_info_size())) {
     AERROR << "error msg info of channel:"
            << GlobalData::GetChannelById(channel_id);
+    return;
+  }
+
+  // the block may be written again after its notification was taken, then it
+  // is read here once for the notification of each write
+  auto& block_msgs = (*delivered)[channel_id];
+  if (block_msgs.size() <= block_index) {
+    block_msgs.resize(block_index + 1);
+  }
+  if (block_msgs[block_index] == msg_info) {
+    ADEBUG << "message of block " << block_index << " already delivered";
+    return;
   }
-  segments_[channel_id]->ReleaseReadBlock(*rb);
+  block_msgs[block_index] = msg_info;
+  OnMessage(channel_id, rb, msg_info);
 }
 
 void ShmDispatcher::OnMessage(uint64_t channel_id,
@@ -99,6 +176,38 @@ void ShmDispatcher::OnMessage(uint64_t channel_id,
   }
 }
 
+void ShmDispatcher::Dispatch(const DispatchTask& task,
+                             DeliveredMessages* delivered) {
+  uint64_t start_ns = SteadyNanoseconds();
+  ReadMessage(task.channel_id, task.block_index, delivered);
+  uint64_t end_ns = SteadyNanoseconds();
+
+  DispatchCounterPtr counter = nullptr;
+  {
+    ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+    auto it = counters_.find(task.channel_id);
+    if (it == counters_.end()) {
+      return;
+    }
+    counter = it->second;
+  }
+  uint64_t wait_ns = start_ns - task.listen_time_ns;
+  uint64_t handle_ns = end_ns - start_ns;
+  counter->msg_num.fetch_add(1);
+  counter->total_wait_ns.fetch_add(wait_ns);
+  counter->total_handle_ns.fetch_add(handle_ns);
+  UpdateMax(&counter->max_wait_ns, wait_ns);
+  UpdateMax(&counter->max_handle_ns, handle_ns);
+}
+
+void ShmDispatcher::CountDrop(uint64_t channel_id) {
+  ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+  auto it = counters_.find(channel_id);
+  if (it != counters_.end()) {
+    it->second->drop_num.fetch_add(1);
+  }
+}
+
 void ShmDispatcher::ThreadFunc() {
   ReadableInfo readable_info;
   while (!is_shutdown_.load()) {
@@ -112,23 +221,26 @@ void ShmDispatcher::ThreadFunc() {
       continue;
     }
 
-    uint64_t channel_id = readable_info.channel_id();
-    uint32_t block_index = readable_info.block_index();
+    DispatchTask task;
+    task.channel_id = readable_info.channel_id();
+    task.block_index = readable_info.block_index();
+    task.listen_time_ns = SteadyNanoseconds();
 
     {
       ReadLockGuard<AtomicRWLock> lock(segments_lock_);
-      if (segments_.count(channel_id) == 0) {
+      if (segments_.count(task.channel_id) == 0) {
         continue;
       }
       // check block index
-      if (previous_indexes_.count(channel_id) == 0) {
-        previous_indexes_[channel_id] = UINT32_MAX;
+      if (previous_indexes_.count(task.channel_id) == 0) {
+        previous_indexes_[task.channel_id] = UINT32_MAX;
       }
-      uint32_t& previous_index = previous_indexes_[channel_id];
+      uint32_t& previous_index = previous_indexes_[task.channel_id];
+      uint32_t block_index = task.block_index;
       if (block_index != 0 && previous_index != UINT32_MAX) {
         if (block_index == previous_index) {
           ADEBUG << "Receive SAME index " << block_index << " of channel "
-                 << channel_id;
+                 << task.channel_id;
         } else if (block_index < previous_index) {
           ADEBUG << "Receive PREVIOUS message. last: " << previous_index
                  << ", now: " << block_index;
@@ -138,15 +250,96 @@ void ShmDispatcher::ThreadFunc() {
         }
       }
       previous_index = block_index;
+    }
+
+    if (shards_.empty()) {
+      Dispatch(task, &delivered_);
+      continue;
+    }
 
-      ReadMessage(channel_id, block_index);
+    // a channel always goes to the same shard to keep its messages in order
+    auto& shard = shards_[task.channel_id % shards_.size()];
+    auto prio_it = channel_prios_.find(task.channel_id);
+    if (prio_it != channel_prios_.end()) {
+      task.prio = prio_it->second;
     }
+    task.seq = task_seq_++;
+    bool dropped = false;
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      if (shard->tasks.size() >= kMaxPendingTasks) {
+        AWARN_EVERY(100) << "too many pending shm messages, drop message of "
+                         << GlobalData::GetChannelById(task.channel_id);
+        dropped = true;
+      } else {
+        // a task of the same block still queued now points at this message
+        shard->block_task_seqs[task.channel_id][task.block_index] = task.seq;
+        shard->tasks.push(task);
+      }
+    }
+    if (dropped) {
+      CountDrop(task.channel_id);
+      continue;
+    }
+    shard->cv.notify_one();
+  }
+}
+
+void ShmDispatcher::ShardThreadFunc(DispatchShard* shard) {
+  while (!is_shutdown_.load()) {
+    DispatchTask task;
+    bool stale = false;
+    {
+      std::unique_lock<std::mutex> lock(shard->mutex);
+      shard->cv.wait(lock, [this, shard]() {
+        return is_shutdown_.load() || !shard->tasks.empty();
+      });
+      if (is_shutdown_.load()) {
+        return;
+      }
+      task = shard->tasks.top();
+      shard->tasks.pop();
+      auto& block_seqs = shard->block_task_seqs[task.channel_id];
+      auto it = block_seqs.find(task.block_index);
+      stale = it == block_seqs.end() || it->second != task.seq;
+      if (!stale) {
+        block_seqs.erase(it);
+      }
+    }
+    if (stale) {
+      // the message it was queued for is overwritten, the block goes out
+      // with the task of its latest write
+      ADEBUG << "drop stale task of block " << task.block_index
+             << " of channel " << GlobalData::GetChannelById(task.channel_id);
+      CountDrop(task.channel_id);
+      continue;
+    }
+    Dispatch(task, &shard->delivered);
   }
 }
 
 bool ShmDispatcher::Init() {
   host_id_ = common::Hash(GlobalData::Instance()->HostIp());
   notifier_ = NotifierFactory::CreateNotifier();
+
+  uint32_t dispatch_thread_num = 0;
+  auto& g_conf = GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf()) {
+    auto& shm_conf = g_conf.transport_conf().shm_conf();
+    dispatch_thread_num = shm_conf.dispatch_thread_num();
+    for (auto& channel_conf : shm_conf.channel_conf()) {
+      channel_prios_[common::Hash(channel_conf.name())] = channel_conf.prio();
+    }
+  }
+
+  for (uint32_t i = 0; i < dispatch_thread_num; ++i) {
+    shards_.emplace_back(new DispatchShard());
+    auto shard = shards_.back().get();
+    shard->thread = std::thread(&ShmDispatcher::ShardThreadFunc, this, shard);
+    scheduler::Instance()->SetInnerThreadAttr("shm_disp_worker",
+                                              &shard->thread);
+  }
+
   thread_ = std::thread(&ShmDispatcher::ThreadFunc, this);
   scheduler::Instance()->SetInnerThreadAttr("shm_disp", &thread_);
   return true;
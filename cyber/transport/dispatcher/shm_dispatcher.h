@@ -17,11 +17,16 @@
 #ifndef CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCHER_H_
 #define CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCHER_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/common/global_data.h"
@@ -42,6 +47,20 @@ using apollo::cyber::base::AtomicRWLock;
 using apollo::cyber::base::ReadLockGuard;
 using apollo::cyber::base::WriteLockGuard;
 
+struct DispatchStatistics {
+  uint64_t msg_num = 0;
+  // from the notification being taken by the listening thread until a
+  // dispatch thread starts handling it
+  uint64_t total_wait_ns = 0;
+  uint64_t max_wait_ns = 0;
+  // reading the block and running all the listeners
+  uint64_t total_handle_ns = 0;
+  uint64_t max_handle_ns = 0;
+  // notifications dropped before being handled, either because too many are
+  // pending or because the block was written again while they were queued
+  uint64_t drop_num = 0;
+};
+
 class ShmDispatcher : public Dispatcher {
  public:
   // key: channel_id
@@ -51,6 +70,9 @@ class ShmDispatcher : public Dispatcher {
 
   void Shutdown() override;
 
+  bool GetDispatchStatistics(uint64_t channel_id,
+                             DispatchStatistics* statistics);
+
   template <typename MessageT>
   void AddListener(const RoleAttributes& self_attr,
                    const MessageListener<MessageT>& listener);
@@ -61,20 +83,80 @@ class ShmDispatcher : public Dispatcher {
                    const MessageListener<MessageT>& listener);
 
  private:
+  struct DispatchCounter {
+    std::atomic<uint64_t> msg_num = {0};
+    std::atomic<uint64_t> total_wait_ns = {0};
+    std::atomic<uint64_t> max_wait_ns = {0};
+    std::atomic<uint64_t> total_handle_ns = {0};
+    std::atomic<uint64_t> max_handle_ns = {0};
+    std::atomic<uint64_t> drop_num = {0};
+  };
+  using DispatchCounterPtr = std::shared_ptr<DispatchCounter>;
+
+  struct DispatchTask {
+    uint64_t channel_id = 0;
+    uint32_t block_index = 0;
+    uint32_t prio = 0;
+    uint64_t seq = 0;
+    uint64_t listen_time_ns = 0;
+  };
+
+  struct DispatchTaskCompare {
+    bool operator()(const DispatchTask& lhs, const DispatchTask& rhs) const {
+      if (lhs.prio != rhs.prio) {
+        return lhs.prio < rhs.prio;
+      }
+      return lhs.seq > rhs.seq;
+    }
+  };
+
+  // key: channel_id, value: info of the message last delivered from each
+  // block, indexed by block_index
+  using DeliveredMessages =
+      std::unordered_map<uint64_t, std::vector<MessageInfo>>;
+
+  struct DispatchShard {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::priority_queue<DispatchTask, std::vector<DispatchTask>,
+                        DispatchTaskCompare>
+        tasks;
+    // key: channel_id, value: seq of the latest pending task of each block,
+    // a queued task of a block written again is stale
+    std::unordered_map<uint64_t, std::unordered_map<uint32_t, uint64_t>>
+        block_task_seqs;
+    DeliveredMessages delivered;
+    std::thread thread;
+  };
+
   void AddSegment(const RoleAttributes& self_attr);
-  void ReadMessage(uint64_t channel_id, uint32_t block_index);
+  void ReadMessage(uint64_t channel_id, uint32_t block_index,
+                   DeliveredMessages* delivered);
   void OnMessage(uint64_t channel_id, const std::shared_ptr<ReadableBlock>& rb,
                  const MessageInfo& msg_info);
+  void Dispatch(const DispatchTask& task, DeliveredMessages* delivered);
+  void CountDrop(uint64_t channel_id);
   void ThreadFunc();
+  void ShardThreadFunc(DispatchShard* shard);
   bool Init();
 
   uint64_t host_id_;
   SegmentContainer segments_;
   std::unordered_map<uint64_t, uint32_t> previous_indexes_;
+  std::unordered_map<uint64_t, DispatchCounterPtr> counters_;
+  // messages dispatched by the listening thread itself
+  DeliveredMessages delivered_;
   AtomicRWLock segments_lock_;
   std::thread thread_;
   NotifierPtr notifier_;
 
+  // key: channel_id, value: prio from shm_conf
+  std::unordered_map<uint64_t, uint32_t> channel_prios_;
+  std::vector<std::unique_ptr<DispatchShard>> shards_;
+  uint64_t task_seq_ = 0;
+
+  static const size_t kMaxPendingTasks;
+
   DECLARE_SINGLETON(ShmDispatcher)
 };
 
@@ -85,8 +167,8 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
   auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
                                      const MessageInfo& msg_info) {
     auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+    RETURN_IF(!message::ParseFromLeasedArray(
+        rb->buf, static_cast<int>(rb->block->msg_size()), rb, msg.get()));
     listener(msg, msg_info);
   };
 
@@ -102,8 +184,8 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
   auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
                                      const MessageInfo& msg_info) {
     auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+    RETURN_IF(!message::ParseFromLeasedArray(
+        rb->buf, static_cast<int>(rb->block->msg_size()), rb, msg.get()));
     listener(msg, msg_info);
   };
 
@@ -93,6 +93,15 @@ TEST(ShmDispatcherTest, on_message) {
 
   sleep(1);
   EXPECT_EQ(recv_msg->message, send_msg->message);
+
+  DispatchStatistics statistics;
+  EXPECT_TRUE(dispatcher->GetDispatchStatistics(self_attr.channel_id(),
+                                                &statistics));
+  EXPECT_GE(statistics.msg_num, 1);
+  EXPECT_GE(statistics.total_handle_ns, statistics.max_handle_ns);
+  EXPECT_EQ(statistics.drop_num, 0);
+  EXPECT_FALSE(dispatcher->GetDispatchStatistics(common::Hash("not_exist"),
+                                                 &statistics));
 }
 
 TEST(ShmDispatcherTest, shutdown) {
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_MESSAGE_SERIALIZED_PAYLOAD_H_
+#define CYBER_TRANSPORT_MESSAGE_SERIALIZED_PAYLOAD_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "cyber/message/message_traits.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class SerializedPayload;
+using SerializedPayloadPtr = std::shared_ptr<SerializedPayload>;
+
+// Wire bytes of one published message. HybridTransmitter serializes the
+// message into a payload once and hands it to every transport that needs
+// the bytes, instead of letting each of them serialize on its own.
+class SerializedPayload {
+ public:
+  template <typename M>
+  static SerializedPayloadPtr Create(const M& msg);
+
+  const std::string& data() const { return data_; }
+  std::size_t size() const { return data_.size(); }
+
+  // Lets a transport lend the buffer to an api that takes ownership of a
+  // string for the duration of a call, it must be handed back afterwards.
+  std::string* mutable_data() { return &data_; }
+
+ private:
+  SerializedPayload() = default;
+
+  std::string data_;
+};
+
+template <typename M>
+SerializedPayloadPtr SerializedPayload::Create(const M& msg) {
+  SerializedPayloadPtr payload(new SerializedPayload());
+  if (!message::SerializeToString(msg, &payload->data_)) {
+    return nullptr;
+  }
+  return payload;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_MESSAGE_SERIALIZED_PAYLOAD_H_
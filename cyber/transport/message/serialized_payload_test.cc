@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/message/serialized_payload.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/benchmark.pb.h"
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::proto::BenchmarkPointCloud;
+using apollo::cyber::proto::Chatter;
+
+TEST(SerializedPayloadTest, create) {
+  Chatter chatter;
+  chatter.set_seq(1);
+  chatter.set_content("payload");
+  auto payload = SerializedPayload::Create(chatter);
+  ASSERT_NE(payload, nullptr);
+  EXPECT_EQ(payload->size(), chatter.ByteSizeLong());
+
+  Chatter parsed;
+  EXPECT_TRUE(parsed.ParseFromString(payload->data()));
+  EXPECT_EQ(parsed.content(), "payload");
+
+  RawMessage raw("raw");
+  payload = SerializedPayload::Create(raw);
+  ASSERT_NE(payload, nullptr);
+  EXPECT_EQ(payload->data(), "raw");
+}
+
+TEST(SerializedPayloadTest, lend_buffer) {
+  RawMessage raw("lent");
+  auto payload = SerializedPayload::Create(raw);
+  ASSERT_NE(payload, nullptr);
+  std::string borrowed;
+  borrowed.swap(*payload->mutable_data());
+  EXPECT_EQ(borrowed, "lent");
+  borrowed.swap(*payload->mutable_data());
+  EXPECT_EQ(payload->data(), "lent");
+}
+
+// Publishing to shm and rtps subscribers at once used to serialize the
+// message for each of them, compare that with serializing once and copying
+// the bytes into the shm block.
+TEST(SerializedPayloadTest, fan_out_benchmark) {
+  // roughly one velodyne-64 sweep
+  const int kPointNum = 120000;
+  const int kRounds = 20;
+  BenchmarkPointCloud cloud;
+  cloud.set_stamp(1);
+  for (int i = 0; i < kPointNum; ++i) {
+    auto point = cloud.add_point();
+    point->set_x(static_cast<float>(i) * 0.01f);
+    point->set_y(static_cast<float>(i) * 0.02f);
+    point->set_z(static_cast<float>(i) * 0.03f);
+    point->set_intensity(i % 256);
+    point->set_timestamp(1000000000ULL + i);
+  }
+  std::vector<char> block(cloud.ByteSizeLong());
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    int size = static_cast<int>(message::ByteSize(cloud));
+    ASSERT_TRUE(message::SerializeToArray(cloud, block.data(), size));
+    std::string rtps_data;
+    ASSERT_TRUE(message::SerializeToString(cloud, &rtps_data));
+  }
+  auto twice = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    auto payload = SerializedPayload::Create(cloud);
+    ASSERT_NE(payload, nullptr);
+    std::memcpy(block.data(), payload->data().data(), payload->size());
+    std::string rtps_data;
+    rtps_data.swap(*payload->mutable_data());
+    rtps_data.swap(*payload->mutable_data());
+  }
+  auto once = std::chrono::steady_clock::now() - start;
+
+  auto us = [kRounds](std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count() /
+           kRounds;
+  };
+  std::cout << "payload " << block.size() << " bytes, serialize per transport "
+            << us(twice) << "us, serialize once " << us(once) << "us"
+            << std::endl;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
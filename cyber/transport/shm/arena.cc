@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/arena.h"
+
+#include <cstring>
+#include <thread>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+const uint64_t kNullOffset = UINT64_MAX;
+// order map entries, indexed by min-sized chunk
+const uint8_t kFreeFlag = 0x80;
+const uint8_t kNotHead = 0x7F;
+
+uint32_t OrderOf(uint64_t size) {
+  uint32_t order = kArenaMinOrder;
+  while ((uint64_t(1) << order) < size) {
+    ++order;
+  }
+  return order;
+}
+
+uint64_t AlignUp(uint64_t size) { return (size + 63) & ~uint64_t(63); }
+
+uint64_t AlignCapacity(uint64_t capacity) {
+  const uint64_t min_size = uint64_t(1) << kArenaMinOrder;
+  capacity = capacity < min_size ? min_size : capacity;
+  return (capacity + min_size - 1) & ~(min_size - 1);
+}
+
+// order of the largest power of two not above capacity
+uint32_t FloorOrderOf(uint64_t capacity) {
+  uint32_t order = kArenaMinOrder;
+  while (order < kArenaMaxOrder && (uint64_t(2) << order) <= capacity) {
+    ++order;
+  }
+  return order;
+}
+
+// the lock is held for a few list operations, a holder that keeps it this
+// long has died with it
+const uint32_t kMaxLockTryTimes = 100000;
+
+}  // namespace
+
+uint64_t Arena::RoundUpCapacity(uint64_t capacity) {
+  return uint64_t(1) << OrderOf(capacity);
+}
+
+uint64_t Arena::RequiredSize(uint64_t capacity) {
+  capacity = AlignCapacity(capacity);
+  return AlignUp(sizeof(Arena) + (capacity >> kArenaMinOrder)) + capacity;
+}
+
+Arena::Arena(uint64_t capacity)
+    : capacity_(AlignCapacity(capacity)) {
+  max_order_ = FloorOrderOf(capacity_);
+  data_offset_ = AlignUp(sizeof(Arena) + (capacity_ >> kArenaMinOrder));
+  std::memset(order_map(), kNotHead, capacity_ >> kArenaMinOrder);
+  for (uint32_t i = 0; i <= kArenaMaxOrder; ++i) {
+    free_heads_[i] = kNullOffset;
+  }
+  // start with the largest chunks that fit, each aligned to its own size
+  uint64_t offset = 0;
+  for (uint32_t order = max_order_ + 1; order-- > kArenaMinOrder;) {
+    if (capacity_ - offset >= (uint64_t(1) << order)) {
+      PushFree(order, offset);
+      offset += uint64_t(1) << order;
+    }
+  }
+}
+
+bool Arena::Allocate(uint64_t size, uint64_t* offset, uint64_t* buf_capacity) {
+  uint32_t order = OrderOf(size);
+  if (order > max_order_) {
+    return false;
+  }
+
+  if (!Lock()) {
+    AERROR << "arena lock is held by a dead writer, fail to allocate.";
+    return false;
+  }
+  uint32_t found = order;
+  while (found <= max_order_ && free_heads_[found] == kNullOffset) {
+    ++found;
+  }
+  if (found > max_order_) {
+    Unlock();
+    return false;
+  }
+
+  uint64_t off = free_heads_[found];
+  RemoveFree(found, off);
+  // split down to the requested order, the upper halves go back as buddies
+  while (found > order) {
+    --found;
+    PushFree(found, off + (uint64_t(1) << found));
+  }
+  order_map()[off >> kArenaMinOrder] = static_cast<uint8_t>(order);
+  Unlock();
+
+  allocated_size_.fetch_add(uint64_t(1) << order);
+  *offset = off;
+  *buf_capacity = uint64_t(1) << order;
+  return true;
+}
+
+bool Arena::Free(uint64_t offset) {
+  if (!Lock()) {
+    AERROR << "arena lock is held by a dead writer, fail to free offset["
+           << offset << "].";
+    return false;
+  }
+  uint8_t entry = order_map()[offset >> kArenaMinOrder];
+  if ((entry & kFreeFlag) || entry == kNotHead) {
+    Unlock();
+    AERROR << "invalid arena offset[" << offset << "] to free.";
+    return true;
+  }
+  uint32_t order = entry;
+  allocated_size_.fetch_sub(uint64_t(1) << order);
+
+  // merge with free buddies as far as possible
+  while (order < max_order_) {
+    uint64_t buddy = offset ^ (uint64_t(1) << order);
+    // the tail of an arena that is not a power of two has no buddy
+    if (buddy + (uint64_t(1) << order) > capacity_ ||
+        order_map()[buddy >> kArenaMinOrder] != (kFreeFlag | order)) {
+      break;
+    }
+    RemoveFree(order, buddy);
+    order_map()[buddy >> kArenaMinOrder] = kNotHead;
+    order_map()[offset >> kArenaMinOrder] = kNotHead;
+    offset = offset < buddy ? offset : buddy;
+    ++order;
+  }
+  PushFree(order, offset);
+  Unlock();
+  return true;
+}
+
+bool Arena::Lock() {
+  uint32_t unlocked = 0;
+  for (uint32_t i = 0; i < kMaxLockTryTimes; ++i) {
+    if (lock_.compare_exchange_weak(unlocked, 1, std::memory_order_acquire,
+                                    std::memory_order_relaxed)) {
+      return true;
+    }
+    unlocked = 0;
+    std::this_thread::yield();
+  }
+  return false;
+}
+
+void Arena::Unlock() { lock_.store(0, std::memory_order_release); }
+
+void Arena::PushFree(uint32_t order, uint64_t offset) {
+  FreeChunk* c = chunk(offset);
+  c->prev = kNullOffset;
+  c->next = free_heads_[order];
+  if (c->next != kNullOffset) {
+    chunk(c->next)->prev = offset;
+  }
+  free_heads_[order] = offset;
+  order_map()[offset >> kArenaMinOrder] =
+      static_cast<uint8_t>(kFreeFlag | order);
+}
+
+void Arena::RemoveFree(uint32_t order, uint64_t offset) {
+  FreeChunk* c = chunk(offset);
+  if (c->prev != kNullOffset) {
+    chunk(c->prev)->next = c->next;
+  } else {
+    free_heads_[order] = c->next;
+  }
+  if (c->next != kNullOffset) {
+    chunk(c->next)->prev = c->prev;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
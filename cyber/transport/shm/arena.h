@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_ARENA_H_
+#define CYBER_TRANSPORT_SHM_ARENA_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+const uint32_t kArenaMinOrder = 10;  // 1K
+const uint32_t kArenaMaxOrder = 40;
+
+// Buddy allocator living inside a shared memory segment, the buffers of all
+// blocks are carved out of it so messages of different sizes can share one
+// segment. Constructed in place by the creator of the segment, every other
+// process just maps it. Buffers are referred to by offsets, because each
+// process maps the segment at a different address.
+class Arena {
+ public:
+  // capacity is rounded up to a multiple of the smallest buffer, it does
+  // not need to be a power of two
+  explicit Arena(uint64_t capacity);
+
+  // bytes the arena needs in the segment, including its bookkeeping
+  static uint64_t RequiredSize(uint64_t capacity);
+  // size of the buffer a request of this size gets
+  static uint64_t RoundUpCapacity(uint64_t capacity);
+
+  // *buf_capacity is the real size of the buffer, at least size. Fails
+  // when there is no room, or the lock is left held by a dead process.
+  bool Allocate(uint64_t size, uint64_t* offset, uint64_t* buf_capacity);
+  // fails only on a lock left held by a dead process
+  bool Free(uint64_t offset);
+
+  uint8_t* Address(uint64_t offset) {
+    return reinterpret_cast<uint8_t*>(this) + data_offset_ + offset;
+  }
+
+  uint64_t capacity() const { return capacity_; }
+  uint64_t allocated_size() const { return allocated_size_.load(); }
+
+ private:
+  struct FreeChunk {
+    uint64_t prev;
+    uint64_t next;
+  };
+
+  // fails instead of spinning forever on a lock left by a dead process
+  bool Lock();
+  void Unlock();
+
+  uint8_t* order_map() {
+    return reinterpret_cast<uint8_t*>(this) + sizeof(Arena);
+  }
+  FreeChunk* chunk(uint64_t offset) {
+    return reinterpret_cast<FreeChunk*>(Address(offset));
+  }
+  void PushFree(uint32_t order, uint64_t offset);
+  void RemoveFree(uint32_t order, uint64_t offset);
+
+  std::atomic<uint32_t> lock_ = {0};
+  uint32_t max_order_;
+  uint64_t capacity_;
+  uint64_t data_offset_;
+  std::atomic<uint64_t> allocated_size_ = {0};
+  uint64_t free_heads_[kArenaMaxOrder + 1];
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_ARENA_H_
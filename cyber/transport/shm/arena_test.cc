@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/arena.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+const uint64_t kCapacity = 1024 * 1024;
+
+class ArenaTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memory_.resize(Arena::RequiredSize(kCapacity) / sizeof(uint64_t) + 1);
+    arena_ = new (memory_.data()) Arena(kCapacity);
+  }
+
+  std::vector<uint64_t> memory_;
+  Arena* arena_ = nullptr;
+};
+
+TEST_F(ArenaTest, round_up) {
+  EXPECT_EQ(Arena::RoundUpCapacity(1), 1024);
+  EXPECT_EQ(Arena::RoundUpCapacity(1025), 2048);
+  EXPECT_EQ(arena_->capacity(), kCapacity);
+}
+
+TEST_F(ArenaTest, allocate_free) {
+  uint64_t offset = 0;
+  uint64_t capacity = 0;
+  EXPECT_TRUE(arena_->Allocate(3000, &offset, &capacity));
+  EXPECT_EQ(capacity, 4096);
+  EXPECT_EQ(arena_->allocated_size(), 4096);
+  arena_->Address(offset)[capacity - 1] = 1;
+  arena_->Free(offset);
+  EXPECT_EQ(arena_->allocated_size(), 0);
+
+  // everything merged back, the whole arena is available again
+  EXPECT_TRUE(arena_->Allocate(kCapacity, &offset, &capacity));
+  EXPECT_EQ(offset, 0);
+  EXPECT_FALSE(arena_->Allocate(1, &offset, &capacity));
+}
+
+TEST_F(ArenaTest, mixed_sizes) {
+  std::vector<uint64_t> offsets;
+  uint64_t offset = 0;
+  uint64_t capacity = 0;
+  uint64_t total = 0;
+  const uint64_t sizes[] = {1000, 200 * 1024, 5000, 64 * 1024, 100};
+  for (int round = 0; round < 3; ++round) {
+    for (auto size : sizes) {
+      ASSERT_TRUE(arena_->Allocate(size, &offset, &capacity));
+      EXPECT_GE(capacity, size);
+      EXPECT_LE(offset + capacity, kCapacity);
+      offsets.push_back(offset);
+      total += capacity;
+    }
+  }
+  EXPECT_EQ(arena_->allocated_size(), total);
+  EXPECT_FALSE(arena_->Allocate(kCapacity / 2, &offset, &capacity));
+
+  for (auto off : offsets) {
+    arena_->Free(off);
+  }
+  EXPECT_EQ(arena_->allocated_size(), 0);
+  EXPECT_TRUE(arena_->Allocate(kCapacity, &offset, &capacity));
+}
+
+TEST(ArenaSizeTest, non_power_of_two) {
+  // 5K splits into a 4K and a 1K chunk
+  const uint64_t capacity = 5 * 1024;
+  std::vector<uint64_t> memory(Arena::RequiredSize(capacity) /
+                                   sizeof(uint64_t) + 1);
+  auto arena = new (memory.data()) Arena(capacity);
+  EXPECT_EQ(arena->capacity(), capacity);
+
+  std::vector<uint64_t> offsets;
+  uint64_t offset = 0;
+  uint64_t buf_capacity = 0;
+  EXPECT_FALSE(arena->Allocate(8 * 1024, &offset, &buf_capacity));
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(arena->Allocate(1000, &offset, &buf_capacity));
+    EXPECT_LE(offset + buf_capacity, capacity);
+    offsets.push_back(offset);
+  }
+  EXPECT_FALSE(arena->Allocate(1000, &offset, &buf_capacity));
+
+  // the tail chunk never merges past the end of the arena
+  for (auto off : offsets) {
+    EXPECT_TRUE(arena->Free(off));
+  }
+  EXPECT_EQ(arena->allocated_size(), 0);
+  ASSERT_TRUE(arena->Allocate(4 * 1024, &offset, &buf_capacity));
+  EXPECT_EQ(offset, 0);
+  ASSERT_TRUE(arena->Allocate(1024, &offset, &buf_capacity));
+  EXPECT_EQ(offset, 4 * 1024);
+  EXPECT_FALSE(arena->Allocate(1, &offset, &buf_capacity));
+}
+
+TEST_F(ArenaTest, dead_lock_holder) {
+  uint64_t offset = 0;
+  uint64_t capacity = 0;
+  ASSERT_TRUE(arena_->Allocate(1000, &offset, &capacity));
+  // a writer died holding the lock, which is the first field of the arena
+  auto lock = reinterpret_cast<std::atomic<uint32_t>*>(arena_);
+  lock->store(1);
+  uint64_t other = 0;
+  EXPECT_FALSE(arena_->Allocate(1000, &other, &capacity));
+  EXPECT_FALSE(arena_->Free(offset));
+  EXPECT_EQ(arena_->allocated_size(), 1024);
+
+  lock->store(0);
+  EXPECT_TRUE(arena_->Allocate(1000, &other, &capacity));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -26,7 +26,12 @@ const int32_t Block::kRWLockFree = 0;
 const int32_t Block::kWriteExclusive = -1;
 const int32_t Block::kMaxTryLockTimes = 5;
 
-Block::Block() : msg_size_(0), msg_info_size_(0) {}
+Block::Block()
+    : msg_size_(0),
+      msg_info_size_(0),
+      buf_offset_(0),
+      buf_capacity_(0),
+      msg_info_{} {}
 
 Block::~Block() {}
 
@@ -39,6 +39,16 @@ class Block {
     msg_info_size_ = msg_info_size;
   }
 
+  // the info is kept with the block, so a ceiling sized message fits its
+  // power of two arena buffer exactly
+  char* msg_info() { return msg_info_; }
+  const char* msg_info() const { return msg_info_; }
+  static constexpr uint64_t kMsgInfoCapacity = 64;
+
+  // buffer in the arena of the segment, only changed under the write lock
+  uint64_t buf_offset() const { return buf_offset_; }
+  uint64_t buf_capacity() const { return buf_capacity_; }
+
   static const int32_t kRWLockFree;
   static const int32_t kWriteExclusive;
   static const int32_t kMaxTryLockTimes;
@@ -53,6 +63,9 @@ class Block {
 
   uint64_t msg_size_;
   uint64_t msg_info_size_;
+  uint64_t buf_offset_;
+  uint64_t buf_capacity_;
+  char msg_info_[kMsgInfoCapacity];
 };
 
 }  // namespace transport
@@ -0,0 +1,267 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/channel_notifier.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+#include "cyber/transport/shm/futex_util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using base::AtomicRWLock;
+using base::ReadLockGuard;
+using base::WriteLockGuard;
+using common::GlobalData;
+using common::Hash;
+
+ChannelNotifier::ChannelNotifier() {
+  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/doorbell"));
+  ADEBUG << "channel notifier key: " << key_;
+
+  if (!Init()) {
+    AERROR << "fail to init channel notifier.";
+    is_shutdown_.store(true);
+  }
+}
+
+ChannelNotifier::~ChannelNotifier() { Shutdown(); }
+
+void ChannelNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  Ring();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  {
+    WriteLockGuard<AtomicRWLock> lock(subscriptions_lock_);
+    subscriptions_.clear();
+  }
+  {
+    WriteLockGuard<AtomicRWLock> lock(rings_lock_);
+    rings_.clear();
+  }
+  Reset();
+}
+
+bool ChannelNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  auto ring = GetRing(info.channel_id());
+  if (ring == nullptr || !ring->Push(info.host_id(), info.block_index())) {
+    AERROR << "push readable info failed, channel: "
+           << GlobalData::GetChannelById(info.channel_id());
+    return false;
+  }
+
+  Ring();
+  return true;
+}
+
+bool ChannelNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    // same ordering as FutexNotifier: sample the doorbell before scanning
+    uint32_t wake_seq = doorbell_->wake_seq.load();
+    if (TryRead(info)) {
+      return true;
+    }
+
+    auto remain = deadline - std::chrono::steady_clock::now();
+    if (remain <= std::chrono::nanoseconds::zero()) {
+      return false;
+    }
+
+    doorbell_->waiters.fetch_add(1);
+    if (FutexWait(&doorbell_->wake_seq, wake_seq,
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      remain)) == -1 &&
+        errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+      AERROR << "futex wait failed, error: " << strerror(errno);
+    }
+    doorbell_->waiters.fetch_sub(1);
+  }
+  return false;
+}
+
+void ChannelNotifier::Subscribe(uint64_t channel_id) {
+  if (is_shutdown_.load()) {
+    return;
+  }
+
+  WriteLockGuard<AtomicRWLock> lock(subscriptions_lock_);
+  for (auto& sub : subscriptions_) {
+    if (sub.ring->channel_id() == channel_id) {
+      return;
+    }
+  }
+
+  auto ring = GetRing(channel_id);
+  if (ring == nullptr) {
+    AERROR << "subscribe failed, channel: "
+           << GlobalData::GetChannelById(channel_id);
+    return;
+  }
+
+  Subscription sub;
+  sub.ring = ring;
+  sub.cursor = ring->next_seq();
+  subscriptions_.emplace_back(sub);
+}
+
+ChannelRingPtr ChannelNotifier::GetRing(uint64_t channel_id) {
+  {
+    ReadLockGuard<AtomicRWLock> lock(rings_lock_);
+    auto it = rings_.find(channel_id);
+    if (it != rings_.end()) {
+      return it->second;
+    }
+  }
+
+  WriteLockGuard<AtomicRWLock> lock(rings_lock_);
+  auto it = rings_.find(channel_id);
+  if (it != rings_.end()) {
+    return it->second;
+  }
+  auto ring = std::make_shared<ChannelRing>(channel_id);
+  if (!ring->Init()) {
+    return nullptr;
+  }
+  rings_[channel_id] = ring;
+  return ring;
+}
+
+bool ChannelNotifier::TryRead(ReadableInfo* info) {
+  ReadLockGuard<AtomicRWLock> lock(subscriptions_lock_);
+  size_t sub_num = subscriptions_.size();
+  for (size_t i = 0; i < sub_num; ++i) {
+    // round robin so that a busy channel cannot starve the others
+    size_t idx = (next_scan_ + i) % sub_num;
+    auto& sub = subscriptions_[idx];
+    uint64_t host_id = 0;
+    uint32_t block_index = 0;
+    uint64_t lost = sub.lost;
+    bool ok = sub.ring->Pop(&sub.cursor, &host_id, &block_index, &sub.lost);
+    if (sub.lost != lost) {
+      AWARN << "ring of channel "
+            << GlobalData::GetChannelById(sub.ring->channel_id())
+            << " overrun, lost " << sub.lost - lost
+            << " infos, total: " << sub.lost;
+    }
+    if (ok) {
+      info->set_host_id(host_id);
+      info->set_block_index(block_index);
+      info->set_channel_id(sub.ring->channel_id());
+      next_scan_ = idx + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ChannelNotifier::Ring() {
+  if (doorbell_ == nullptr) {
+    return;
+  }
+  doorbell_->wake_seq.fetch_add(1);
+  if (doorbell_->waiters.load() > 0) {
+    FutexWake(&doorbell_->wake_seq, INT_MAX);
+  }
+}
+
+bool ChannelNotifier::Init() { return OpenOrCreate(); }
+
+bool ChannelNotifier::OpenOrCreate() {
+  int shmid = shmget(key_, sizeof(Doorbell), 0644 | IPC_CREAT | IPC_EXCL);
+  if (shmid == -1) {
+    if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    }
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  doorbell_ = new (managed_shm_) Doorbell();
+  ADEBUG << "open or create true.";
+  return true;
+}
+
+bool ChannelNotifier::OpenOnly() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    managed_shm_ = nullptr;
+    return false;
+  }
+
+  doorbell_ = reinterpret_cast<Doorbell*>(managed_shm_);
+  ADEBUG << "open true.";
+  return true;
+}
+
+void ChannelNotifier::Reset() {
+  doorbell_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
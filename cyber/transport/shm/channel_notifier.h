@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_CHANNEL_NOTIFIER_H_
+#define CYBER_TRANSPORT_SHM_CHANNEL_NOTIFIER_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/common/macros.h"
+#include "cyber/transport/shm/channel_ring.h"
+#include "cyber/transport/shm/notifier_base.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class ChannelNotifier
+ * @brief Publishes readable infos into the ChannelRing of their channel
+ * instead of one host-wide ring, so a listener only scans the channels it
+ * subscribed to and busy channels cannot overrun the others. A host-wide
+ * futex doorbell is rung after every push to wake parked listeners.
+ */
+class ChannelNotifier : public NotifierBase {
+  struct Doorbell {
+    std::atomic<uint32_t> wake_seq = {0};
+    std::atomic<uint32_t> waiters = {0};
+  };
+
+  struct Subscription {
+    ChannelRingPtr ring;
+    uint64_t cursor = 0;
+    uint64_t lost = 0;
+  };
+
+ public:
+  virtual ~ChannelNotifier();
+
+  void Shutdown() override;
+  bool Notify(const ReadableInfo& info) override;
+  bool Listen(int timeout_ms, ReadableInfo* info) override;
+  void Subscribe(uint64_t channel_id) override;
+
+  static const char* Type() { return "channel"; }
+
+ private:
+  bool Init();
+  bool OpenOrCreate();
+  bool OpenOnly();
+  void Reset();
+
+  ChannelRingPtr GetRing(uint64_t channel_id);
+  bool TryRead(ReadableInfo* info);
+  void Ring();
+
+  key_t key_ = 0;
+  void* managed_shm_ = nullptr;
+  Doorbell* doorbell_ = nullptr;
+  std::atomic<bool> is_shutdown_ = {false};
+
+  // rings opened by this process, used by the transmitters
+  base::AtomicRWLock rings_lock_;
+  std::unordered_map<uint64_t, ChannelRingPtr> rings_;
+
+  // rings scanned by Listen, only touched by the dispatcher thread apart
+  // from Subscribe
+  base::AtomicRWLock subscriptions_lock_;
+  std::vector<Subscription> subscriptions_;
+  size_t next_scan_ = 0;
+
+  DECLARE_SINGLETON(ChannelNotifier)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_CHANNEL_NOTIFIER_H_
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/channel_notifier.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/transport/shm/channel_ring.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+const uint64_t kSubscribedChannel = 0x5a5a000000000001;
+const uint64_t kOtherChannel = 0x5a5a000000000002;
+
+TEST(ChannelRingTest, push_pop) {
+  ChannelRing writer(kOtherChannel);
+  ChannelRing reader(kOtherChannel);
+  ASSERT_TRUE(writer.Init());
+  ASSERT_TRUE(reader.Init());
+
+  uint64_t cursor = reader.next_seq();
+  uint64_t host_id = 0;
+  uint32_t block_index = 0;
+  uint64_t lost = 0;
+  EXPECT_FALSE(reader.Pop(&cursor, &host_id, &block_index, &lost));
+
+  EXPECT_TRUE(writer.Push(7, 3));
+  EXPECT_TRUE(reader.Pop(&cursor, &host_id, &block_index, &lost));
+  EXPECT_EQ(host_id, 7);
+  EXPECT_EQ(block_index, 3);
+  EXPECT_EQ(lost, 0);
+  EXPECT_FALSE(reader.Pop(&cursor, &host_id, &block_index, &lost));
+}
+
+TEST(ChannelRingTest, overrun) {
+  ChannelRing ring(kOtherChannel);
+  ASSERT_TRUE(ring.Init());
+
+  uint64_t cursor = ring.next_seq();
+  uint64_t host_id = 0;
+  uint32_t block_index = 0;
+  uint64_t lost = 0;
+  for (uint32_t i = 0; i < kChannelRingLength + 10; ++i) {
+    EXPECT_TRUE(ring.Push(0, i));
+  }
+  EXPECT_TRUE(ring.Pop(&cursor, &host_id, &block_index, &lost));
+  EXPECT_EQ(lost, 10);
+  EXPECT_EQ(block_index, 10);
+}
+
+TEST(ChannelRingTest, concurrent_writers) {
+  ChannelRing ring(kOtherChannel);
+  ASSERT_TRUE(ring.Init());
+
+  // writers lapping each other on a slot never leave an older entry there
+  const uint32_t kWriterNum = 4;
+  const uint32_t kPushNum = 20 * kChannelRingLength;
+  uint64_t cursor = ring.next_seq();
+  std::vector<std::thread> writers;
+  for (uint32_t w = 0; w < kWriterNum; ++w) {
+    writers.emplace_back([&ring, w]() {
+      for (uint32_t i = 0; i < kPushNum; ++i) {
+        EXPECT_TRUE(ring.Push(w, i));
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  uint64_t host_id = 0;
+  uint32_t block_index = 0;
+  uint64_t lost = 0;
+  uint64_t read = 0;
+  while (ring.Pop(&cursor, &host_id, &block_index, &lost)) {
+    ++read;
+  }
+  EXPECT_EQ(cursor, ring.next_seq());
+  EXPECT_EQ(read + lost, kWriterNum * kPushNum);
+  EXPECT_EQ(read, kChannelRingLength);
+}
+
+TEST(ChannelRingTest, removed_on_last_detach) {
+  {
+    ChannelRing writer(kOtherChannel);
+    ChannelRing reader(kOtherChannel);
+    ASSERT_TRUE(writer.Init());
+    ASSERT_TRUE(reader.Init());
+    EXPECT_TRUE(writer.Push(0, 1));
+    EXPECT_EQ(reader.next_seq(), 1);
+  }
+  // nobody kept it, so the next user starts with an empty ring
+  ChannelRing ring(kOtherChannel);
+  ASSERT_TRUE(ring.Init());
+  EXPECT_EQ(ring.next_seq(), 0);
+}
+
+TEST(ChannelNotifierTest, constructor) {
+  auto notifier = ChannelNotifier::Instance();
+  EXPECT_NE(notifier, nullptr);
+}
+
+TEST(ChannelNotifierTest, notify_listen) {
+  auto notifier = ChannelNotifier::Instance();
+  ReadableInfo readable_info(0, 1, kSubscribedChannel);
+  ReadableInfo other_info(0, 1, kOtherChannel);
+  ReadableInfo info;
+
+  notifier->Subscribe(kSubscribedChannel);
+  EXPECT_FALSE(notifier->Listen(100, &info));
+  EXPECT_TRUE(notifier->Notify(other_info));
+  EXPECT_FALSE(notifier->Listen(100, &info));
+
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &info));
+  EXPECT_EQ(info.channel_id(), kSubscribedChannel);
+  EXPECT_EQ(info.block_index(), 1);
+  EXPECT_FALSE(notifier->Listen(100, &info));
+
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &info));
+  EXPECT_TRUE(notifier->Listen(100, &info));
+  EXPECT_FALSE(notifier->Listen(100, &info));
+}
+
+TEST(ChannelNotifierTest, shutdown) {
+  auto notifier = ChannelNotifier::Instance();
+  notifier->Shutdown();
+  ReadableInfo readable_info(0, 1, kSubscribedChannel);
+  EXPECT_FALSE(notifier->Notify(readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
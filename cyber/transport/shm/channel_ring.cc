@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/channel_ring.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::Hash;
+
+const uint64_t ChannelRing::kSlotBusy = std::numeric_limits<uint64_t>::max();
+
+namespace {
+
+// a slot is held busy for two stores, a writer that keeps it this long has
+// died with it
+const uint32_t kMaxSlotTryTimes = 100000;
+
+}  // namespace
+
+ChannelRing::ChannelRing(uint64_t channel_id) : channel_id_(channel_id) {
+  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/ring/" +
+                                 std::to_string(channel_id)));
+}
+
+ChannelRing::~ChannelRing() {
+  Reset();
+  Remove();
+}
+
+bool ChannelRing::Init() {
+  if (indicator_ != nullptr) {
+    return true;
+  }
+  return OpenOrCreate();
+}
+
+bool ChannelRing::Push(uint64_t host_id, uint32_t block_index) {
+  if (indicator_ == nullptr) {
+    return false;
+  }
+
+  uint64_t seq = indicator_->next_seq.fetch_add(1);
+  uint64_t published = seq + 1;
+  Slot& slot = indicator_->slots[seq % kChannelRingLength];
+  // writers a lap apart may land on the same slot, it is filled by one of
+  // them at a time and never goes back to an older entry
+  uint64_t current = slot.seq.load(std::memory_order_relaxed);
+  for (uint32_t i = 0;; ++i) {
+    if (current != kSlotBusy) {
+      if (current >= published) {
+        // a newer entry is already there, ours is lost to the readers
+        return true;
+      }
+      if (slot.seq.compare_exchange_weak(current, kSlotBusy,
+                                         std::memory_order_relaxed)) {
+        break;
+      }
+      continue;
+    }
+    if (i >= kMaxSlotTryTimes) {
+      AWARN << "ring slot of channel " << channel_id_
+            << " is held by a dead writer, take it over.";
+      break;
+    }
+    std::this_thread::yield();
+    current = slot.seq.load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.host_id.store(host_id, std::memory_order_relaxed);
+  slot.block_index.store(block_index, std::memory_order_relaxed);
+  // a slow writer whose slot was taken over must not publish over the
+  // writer that took it
+  uint64_t busy = kSlotBusy;
+  slot.seq.compare_exchange_strong(busy, published, std::memory_order_release,
+                                   std::memory_order_relaxed);
+  return true;
+}
+
+bool ChannelRing::Pop(uint64_t* cursor, uint64_t* host_id,
+                      uint32_t* block_index, uint64_t* lost) {
+  if (indicator_ == nullptr) {
+    return false;
+  }
+
+  while (true) {
+    uint64_t next_seq = indicator_->next_seq.load(std::memory_order_acquire);
+    if (*cursor >= next_seq) {
+      return false;
+    }
+    // the writers have lapped us, jump to the oldest entry still in the ring
+    if (next_seq - *cursor > kChannelRingLength) {
+      *lost += next_seq - kChannelRingLength - *cursor;
+      *cursor = next_seq - kChannelRingLength;
+    }
+
+    Slot& slot = indicator_->slots[*cursor % kChannelRingLength];
+    uint64_t expected = *cursor + 1;
+    uint64_t begin = slot.seq.load(std::memory_order_acquire);
+    if (begin == kSlotBusy || begin < expected) {
+      // claimed but not published yet
+      return false;
+    }
+    if (begin == expected) {
+      *host_id = slot.host_id.load(std::memory_order_relaxed);
+      *block_index = slot.block_index.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) == begin) {
+        ++(*cursor);
+        return true;
+      }
+    }
+    // overwritten by a newer entry before (or while) we read it
+    ++(*lost);
+    ++(*cursor);
+  }
+}
+
+uint64_t ChannelRing::next_seq() const {
+  if (indicator_ == nullptr) {
+    return 0;
+  }
+  return indicator_->next_seq.load();
+}
+
+bool ChannelRing::OpenOrCreate() {
+  int shmid =
+      shmget(key_, sizeof(Indicator), 0644 | IPC_CREAT | IPC_EXCL);
+  if (shmid == -1) {
+    if (EEXIST == errno) {
+      ADEBUG << "ring already exist, open only.";
+      return OpenOnly();
+    }
+    AERROR << "create ring shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  shmid_ = shmid;
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach ring shm failed, error: " << strerror(errno);
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    shmid_ = -1;
+    return false;
+  }
+
+  indicator_ = new (managed_shm_) Indicator();
+  ADEBUG << "create ring of channel " << channel_id_;
+  return true;
+}
+
+bool ChannelRing::OpenOnly() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get ring shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  struct shmid_ds ds;
+  if (shmctl(shmid, IPC_STAT, &ds) == -1 || ds.shm_segsz < sizeof(Indicator)) {
+    AERROR << "ring shm of channel " << channel_id_ << " has unexpected size.";
+    return false;
+  }
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach ring shm failed, error: " << strerror(errno);
+    managed_shm_ = nullptr;
+    return false;
+  }
+  // the last user removed it while we attached, start a new ring instead
+  if (shmctl(shmid, IPC_STAT, &ds) == 0 && (ds.shm_perm.mode & SHM_DEST)) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    return OpenOrCreate();
+  }
+  shmid_ = shmid;
+
+  indicator_ = reinterpret_cast<Indicator*>(managed_shm_);
+  ADEBUG << "open ring of channel " << channel_id_;
+  return true;
+}
+
+void ChannelRing::Reset() {
+  indicator_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+void ChannelRing::Remove() {
+  if (shmid_ == -1) {
+    return;
+  }
+  // the kernel keeps the attach count, so processes that died still
+  // attached do not keep the ring alive
+  struct shmid_ds ds;
+  if (shmctl(shmid_, IPC_STAT, &ds) == 0 && ds.shm_nattch == 0) {
+    if (shmctl(shmid_, IPC_RMID, 0) == -1) {
+      AERROR << "remove ring shm failed, error: " << strerror(errno);
+    } else {
+      ADEBUG << "remove ring of channel " << channel_id_;
+    }
+  }
+  shmid_ = -1;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_CHANNEL_RING_H_
+#define CYBER_TRANSPORT_SHM_CHANNEL_RING_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class ChannelRing;
+using ChannelRingPtr = std::shared_ptr<ChannelRing>;
+
+const uint32_t kChannelRingLength = 1024;
+
+/**
+ * @class ChannelRing
+ * @brief Readable-info ring of a single channel, kept in its own small xsi
+ * segment next to the channel's data Segment. Any number of writers claim
+ * slots with fetch_add and publish them seqlock style; every reader keeps its
+ * own cursor, so readers never consume entries from each other. The segment
+ * is removed when the last process detaches from it.
+ */
+class ChannelRing {
+  struct Slot {
+    // seq + 1 of the info stored in this slot, 0 when never written and
+    // kSlotBusy while a writer is filling it
+    std::atomic<uint64_t> seq = {0};
+    std::atomic<uint64_t> host_id = {0};
+    std::atomic<uint32_t> block_index = {0};
+  };
+
+  struct Indicator {
+    std::atomic<uint64_t> next_seq = {0};
+    Slot slots[kChannelRingLength];
+  };
+
+ public:
+  explicit ChannelRing(uint64_t channel_id);
+  virtual ~ChannelRing();
+
+  bool Init();
+
+  /**
+   * @brief Publish the block `block_index` of this channel.
+   */
+  bool Push(uint64_t host_id, uint32_t block_index);
+
+  /**
+   * @brief Read the entry at `*cursor` and advance the cursor.
+   *
+   * @return false if no complete entry is available at `*cursor` yet.
+   * Entries overwritten before they could be read are skipped and added to
+   * `*lost`.
+   */
+  bool Pop(uint64_t* cursor, uint64_t* host_id, uint32_t* block_index,
+           uint64_t* lost);
+
+  uint64_t channel_id() const { return channel_id_; }
+  uint64_t next_seq() const;
+
+ private:
+  bool OpenOrCreate();
+  bool OpenOnly();
+  void Reset();
+  // removes the segment once no process is attached to it any more
+  void Remove();
+
+  uint64_t channel_id_;
+  key_t key_ = 0;
+  int shmid_ = -1;
+  void* managed_shm_ = nullptr;
+  Indicator* indicator_ = nullptr;
+
+  static const uint64_t kSlotBusy;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_CHANNEL_RING_H_
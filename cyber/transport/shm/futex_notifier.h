@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
+#define CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/shm/notifier_base.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+const uint32_t kFutexBufLength = 4096;
+
+/**
+ * @class FutexNotifier
+ * @brief Same ring layout as ConditionNotifier, but idle listeners park on a
+ * futex word in the shared Indicator instead of polling every 50us. Notify
+ * bumps the word and only issues FUTEX_WAKE when someone is parked.
+ */
+class FutexNotifier : public NotifierBase {
+  struct Indicator {
+    std::atomic<uint64_t> next_seq = {0};
+    // futex word, incremented after every published info
+    std::atomic<uint32_t> wake_seq = {0};
+    // number of listeners (host-wide) currently parked on wake_seq
+    std::atomic<uint32_t> waiters = {0};
+    ReadableInfo infos[kFutexBufLength];
+    uint64_t seqs[kFutexBufLength] = {0};
+  };
+
+ public:
+  virtual ~FutexNotifier();
+
+  void Shutdown() override;
+  bool Notify(const ReadableInfo& info) override;
+  bool Listen(int timeout_ms, ReadableInfo* info) override;
+
+  static const char* Type() { return "futex"; }
+
+ private:
+  bool Init();
+  bool OpenOrCreate();
+  bool OpenOnly();
+  bool Remove();
+  void Reset();
+
+  bool TryRead(ReadableInfo* info);
+  void WakeAll();
+
+  key_t key_ = 0;
+  void* managed_shm_ = nullptr;
+  size_t shm_size_ = 0;
+  Indicator* indicator_ = nullptr;
+  uint64_t next_seq_ = 0;
+  std::atomic<bool> is_shutdown_ = {false};
+
+  DECLARE_SINGLETON(FutexNotifier)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(FutexNotifierTest, constructor) {
+  auto notifier = FutexNotifier::Instance();
+  EXPECT_NE(notifier, nullptr);
+}
+
+TEST(FutexNotifierTest, notify_listen) {
+  auto notifier = FutexNotifier::Instance();
+  ReadableInfo readable_info;
+  while (notifier->Listen(100, &readable_info)) {
+  }
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+TEST(FutexNotifierTest, wakeup_parked_listener) {
+  auto notifier = FutexNotifier::Instance();
+  ReadableInfo readable_info;
+  while (notifier->Listen(0, &readable_info)) {
+  }
+
+  bool received = false;
+  auto start = std::chrono::steady_clock::now();
+  std::thread listener([&]() {
+    ReadableInfo info;
+    received = notifier->Listen(5000, &info);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  listener.join();
+  auto cost = std::chrono::steady_clock::now() - start;
+
+  EXPECT_TRUE(received);
+  EXPECT_LT(cost, std::chrono::milliseconds(1000));
+}
+
+TEST(FutexNotifierTest, shutdown) {
+  auto notifier = FutexNotifier::Instance();
+  notifier->Shutdown();
+  ReadableInfo readable_info;
+  EXPECT_FALSE(notifier->Notify(readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_FUTEX_UTIL_H_
+#define CYBER_TRANSPORT_SHM_FUTEX_UTIL_H_
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Futex words used by the shm notifiers live in memory mapped by several
+// processes, so only the non-private futex operations may be used on them.
+inline int FutexWait(std::atomic<uint32_t>* addr, uint32_t expected,
+                     const std::chrono::nanoseconds& timeout) {
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+  ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);  // NOLINT
+  return static_cast<int>(
+      syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, nullptr, 0));
+}
+
+inline int FutexWake(std::atomic<uint32_t>* addr, int count) {
+  return static_cast<int>(
+      syscall(SYS_futex, addr, FUTEX_WAKE, count, nullptr, nullptr, 0));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_FUTEX_UTIL_H_
@@ -20,7 +20,9 @@
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
+#include "cyber/transport/shm/channel_notifier.h"
 #include "cyber/transport/shm/condition_notifier.h"
+#include "cyber/transport/shm/futex_notifier.h"
 #include "cyber/transport/shm/multicast_notifier.h"
 
 namespace apollo {
@@ -43,16 +45,28 @@ auto NotifierFactory::CreateNotifier() -> NotifierPtr {
     return CreateMulticastNotifier();
   } else if (notifier_type == ConditionNotifier::Type()) {
     return CreateConditionNotifier();
+  } else if (notifier_type == FutexNotifier::Type()) {
+    return CreateFutexNotifier();
+  } else if (notifier_type == ChannelNotifier::Type()) {
+    return CreateChannelNotifier();
   }
 
   AINFO << "unknown notifier, we use default notifier: " << notifier_type;
   return CreateConditionNotifier();
 }
 
+auto NotifierFactory::CreateChannelNotifier() -> NotifierPtr {
+  return ChannelNotifier::Instance();
+}
+
 auto NotifierFactory::CreateConditionNotifier() -> NotifierPtr {
   return ConditionNotifier::Instance();
 }
 
+auto NotifierFactory::CreateFutexNotifier() -> NotifierPtr {
+  return FutexNotifier::Instance();
+}
+
 auto NotifierFactory::CreateMulticastNotifier() -> NotifierPtr {
   return MulticastNotifier::Instance();
 }
@@ -30,7 +30,9 @@ class NotifierFactory {
   static NotifierPtr CreateNotifier();
 
  private:
+  static NotifierPtr CreateChannelNotifier();
   static NotifierPtr CreateConditionNotifier();
+  static NotifierPtr CreateFutexNotifier();
   static NotifierPtr CreateMulticastNotifier();
 };
 
@@ -71,18 +71,23 @@ bool PosixSegment::OpenOrCreate() {
   }
 
   close(fd);
+  uint64_t mapped_size = conf_.managed_shm_size();
+  mapping_.reset(managed_shm_, [mapped_size](void* addr) {
+    munmap(addr, mapped_size);
+  });
 
   // create field state_
-  state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
+  state_ = new (managed_shm_)
+      State(conf_.ceiling_msg_size(), conf_.block_num());
   if (state_ == nullptr) {
     AERROR << "create state failed.";
-    munmap(managed_shm_, conf_.managed_shm_size());
+    mapping_.reset();
     managed_shm_ = nullptr;
     shm_unlink(shm_name_.c_str());
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->block_num());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
@@ -91,38 +96,22 @@ bool PosixSegment::OpenOrCreate() {
     AERROR << "create blocks failed.";
     state_->~State();
     state_ = nullptr;
-    munmap(managed_shm_, conf_.managed_shm_size());
+    mapping_.reset();
     managed_shm_ = nullptr;
     shm_unlink(shm_name_.c_str());
     return false;
   }
 
-  // create block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr =
-        new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
-
-    if (addr == nullptr) {
-      break;
-    }
-
-    std::lock_guard<std::mutex> lg(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "create block buf failed.";
+  // create field arena_
+  arena_ = new (static_cast<char*>(managed_shm_) + sizeof(State) +
+                conf_.block_num() * sizeof(Block))
+      Arena(conf_.arena_size());
+  if (arena_ == nullptr) {
+    AERROR << "create arena failed.";
     state_->~State();
     state_ = nullptr;
     blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> lg(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    munmap(managed_shm_, conf_.managed_shm_size());
+    mapping_.reset();
     managed_shm_ = nullptr;
     shm_unlink(shm_name_.c_str());
     return false;
@@ -162,16 +151,21 @@ bool PosixSegment::OpenOnly() {
   }
 
   close(fd);
+  uint64_t mapped_size = file_attr.st_size;
+  mapping_.reset(managed_shm_, [mapped_size](void* addr) {
+    munmap(addr, mapped_size);
+  });
+
   // get field state_
   state_ = reinterpret_cast<State*>(managed_shm_);
   if (state_ == nullptr) {
     AERROR << "get state failed.";
-    munmap(managed_shm_, file_attr.st_size);
+    mapping_.reset();
     managed_shm_ = nullptr;
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->block_num());
 
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
@@ -179,34 +173,21 @@ bool PosixSegment::OpenOnly() {
   if (blocks_ == nullptr) {
     AERROR << "get blocks failed.";
     state_ = nullptr;
-    munmap(managed_shm_, conf_.managed_shm_size());
+    mapping_.reset();
     managed_shm_ = nullptr;
     return false;
   }
 
-  // get block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr = reinterpret_cast<uint8_t*>(
-        static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
-
-    std::lock_guard<std::mutex> lg(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "open only failed.";
-    state_->~State();
+  // get field arena_
+  arena_ = reinterpret_cast<Arena*>(static_cast<char*>(managed_shm_) +
+                                    sizeof(State) +
+                                    conf_.block_num() * sizeof(Block));
+  if (arena_ == nullptr) {
+    AERROR << "get arena failed.";
     state_ = nullptr;
     blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> lg(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    munmap(managed_shm_, conf_.managed_shm_size());
+    mapping_.reset();
     managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
     return false;
   }
 
@@ -227,12 +208,9 @@ bool PosixSegment::Remove() {
 void PosixSegment::Reset() {
   state_ = nullptr;
   blocks_ = nullptr;
-  {
-    std::lock_guard<std::mutex> lg(block_buf_lock_);
-    block_buf_addrs_.clear();
-  }
+  arena_ = nullptr;
   if (managed_shm_ != nullptr) {
-    munmap(managed_shm_, conf_.managed_shm_size());
+    mapping_.reset();
     managed_shm_ = nullptr;
     return;
   }
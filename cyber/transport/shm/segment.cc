@@ -16,6 +16,8 @@
 
 #include "cyber/transport/shm/segment.h"
 
+#include <thread>
+
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -24,15 +26,21 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+namespace {
+// a message may take at most this fraction of the arena
+const uint64_t kMinBlocksInArena = 4;
+}  // namespace
+
 Segment::Segment(uint64_t channel_id)
     : init_(false),
       conf_(),
       channel_id_(channel_id),
       state_(nullptr),
       blocks_(nullptr),
+      arena_(nullptr),
       managed_shm_(nullptr),
-      block_buf_lock_(),
-      block_buf_addrs_() {}
+      mapping_(nullptr),
+      leased_block_num_(std::make_shared<std::atomic<uint32_t>>(0)) {}
 
 bool Segment::AcquireBlockToWrite(std::size_t msg_size,
                                   WritableBlock* writable_block) {
@@ -47,10 +55,13 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     result = Remap();
   }
 
-  if (msg_size > conf_.ceiling_msg_size()) {
+  // messages of any size share the arena, only those that would leave room
+  // for too few others in it need a larger segment
+  if (msg_size > conf_.arena_size() / kMinBlocksInArena &&
+      ShmConf(msg_size).arena_size() > conf_.arena_size()) {
     AINFO << "msg_size: " << msg_size
-          << " larger than current shm_buffer_size: "
-          << conf_.ceiling_msg_size() << " , need recreate.";
+          << " too large for current arena_size: " << conf_.arena_size()
+          << " , need recreate.";
     result = Recreate(msg_size);
   }
 
@@ -59,10 +70,21 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
-  uint32_t index = GetNextWritableBlockIndex();
+  uint32_t index = 0;
+  if (!GetNextWritableBlockIndex(&index)) {
+    AERROR << "no writable block, " << leased_block_num_->load()
+           << " blocks leased by readers.";
+    return false;
+  }
+  if (!ReserveBlockBuf(index, msg_size)) {
+    blocks_[index].ReleaseWriteLock();
+    AERROR << "no room for msg_size: " << msg_size << " in arena, "
+           << arena_->allocated_size() << " bytes in use.";
+    return false;
+  }
   writable_block->index = index;
   writable_block->block = &blocks_[index];
-  writable_block->buf = block_buf_addrs_[index];
+  writable_block->buf = arena_->Address(blocks_[index].buf_offset_);
   return true;
 }
 
@@ -100,8 +122,13 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
   if (!blocks_[index].TryLockForRead()) {
     return false;
   }
+  if (blocks_[index].buf_capacity_ == 0) {
+    // evicted by a writer short of arena space before we got to it
+    blocks_[index].ReleaseReadLock();
+    return false;
+  }
   readable_block->block = blocks_ + index;
-  readable_block->buf = block_buf_addrs_[index];
+  readable_block->buf = arena_->Address(blocks_[index].buf_offset_);
   return true;
 }
 
@@ -113,6 +140,20 @@ void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
   blocks_[index].ReleaseReadLock();
 }
 
+std::shared_ptr<ReadableBlock> Segment::LeaseReadBlock(
+    const ReadableBlock& readable_block) {
+  auto mapping = mapping_;
+  auto leased_block_num = leased_block_num_;
+  leased_block_num->fetch_add(1);
+  return std::shared_ptr<ReadableBlock>(
+      new ReadableBlock(readable_block),
+      [mapping, leased_block_num](ReadableBlock* rb) {
+        rb->block->ReleaseReadLock();
+        leased_block_num->fetch_sub(1);
+        delete rb;
+      });
+}
+
 bool Segment::Destroy() {
   if (!init_) {
     return true;
@@ -135,6 +176,7 @@ bool Segment::Destroy() {
 
 bool Segment::Remap() {
   init_ = false;
+  remap_num_.fetch_add(1);
   ADEBUG << "before reset.";
   Reset();
   ADEBUG << "after reset.";
@@ -143,6 +185,7 @@ bool Segment::Remap() {
 
 bool Segment::Recreate(const uint64_t& msg_size) {
   init_ = false;
+  recreate_num_.fetch_add(1);
   state_->set_need_remap(true);
   Reset();
   Remove();
@@ -150,15 +193,64 @@ bool Segment::Recreate(const uint64_t& msg_size) {
   return OpenOrCreate();
 }
 
-uint32_t Segment::GetNextWritableBlockIndex() {
+bool Segment::GetNextWritableBlockIndex(uint32_t* index) {
+  // readers may hold leases for a while, so never spin forever on a segment
+  // whose blocks are all busy
+  static const uint32_t kMaxTryRounds = 1000;
   const auto block_num = conf_.block_num();
-  while (1) {
-    uint32_t try_idx = state_->FetchAddSeq(1) % block_num;
-    if (blocks_[try_idx].TryLockForWrite()) {
-      return try_idx;
+  for (uint32_t round = 0; round < kMaxTryRounds; ++round) {
+    for (uint32_t i = 0; i < block_num; ++i) {
+      uint32_t try_idx = state_->FetchAddSeq(1) % block_num;
+      if (blocks_[try_idx].TryLockForWrite()) {
+        *index = try_idx;
+        return true;
+      }
+    }
+    std::this_thread::yield();
+  }
+  return false;
+}
+
+bool Segment::ReserveBlockBuf(uint32_t index, uint64_t buf_size) {
+  Block& block = blocks_[index];
+  // keep the buffer unless it is too small or much larger than needed
+  if (block.buf_capacity_ >= buf_size &&
+      block.buf_capacity_ <= 2 * Arena::RoundUpCapacity(buf_size)) {
+    return true;
+  }
+  if (block.buf_capacity_ > 0) {
+    if (!arena_->Free(block.buf_offset_)) {
+      return false;
+    }
+    block.buf_capacity_ = 0;
+  }
+
+  // drop the buffers of the oldest messages until the new one fits
+  const auto block_num = conf_.block_num();
+  for (uint32_t i = 1;; ++i) {
+    if (arena_->Allocate(buf_size, &block.buf_offset_, &block.buf_capacity_)) {
+      return true;
+    }
+    if (i >= block_num) {
+      return false;
+    }
+    Block& victim = blocks_[(index + i) % block_num];
+    if (victim.buf_capacity_ == 0 || !victim.TryLockForWrite()) {
+      continue;
+    }
+    if (victim.buf_capacity_ > 0) {
+      // evicting more does not help while the arena cannot be locked
+      if (!arena_->Free(victim.buf_offset_)) {
+        victim.ReleaseWriteLock();
+        return false;
+      }
+      victim.buf_capacity_ = 0;
+      victim.msg_size_ = 0;
+      evicted_block_num_.fetch_add(1);
     }
+    victim.ReleaseWriteLock();
   }
-  return 0;
+  return false;
 }
 
 }  // namespace transport
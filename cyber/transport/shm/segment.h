@@ -17,11 +17,11 @@
 #ifndef CYBER_TRANSPORT_SHM_SEGMENT_H_
 #define CYBER_TRANSPORT_SHM_SEGMENT_H_
 
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <string>
-#include <unordered_map>
 
+#include "cyber/transport/shm/arena.h"
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/shm_conf.h"
 #include "cyber/transport/shm/state.h"
@@ -51,6 +51,20 @@ class Segment {
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
+  // Hands the read lock of an acquired block over to the returned pointer,
+  // the lock is released and the mapping kept alive until the last copy of
+  // it is destroyed, so messages can reference the block without copying.
+  std::shared_ptr<ReadableBlock> LeaseReadBlock(
+      const ReadableBlock& readable_block);
+  uint32_t leased_block_num() const { return leased_block_num_->load(); }
+
+  // times this segment was remapped because another process recreated it,
+  // was recreated by us for a message too large for the arena, and had to
+  // drop the buffer of an unread message to make room in the arena
+  uint64_t remap_num() const { return remap_num_.load(); }
+  uint64_t recreate_num() const { return recreate_num_.load(); }
+  uint64_t evicted_block_num() const { return evicted_block_num_.load(); }
+
  protected:
   virtual bool Destroy();
   virtual void Reset() = 0;
@@ -64,14 +78,21 @@ class Segment {
 
   State* state_;
   Block* blocks_;
+  Arena* arena_;
   void* managed_shm_;
-  std::mutex block_buf_lock_;
-  std::unordered_map<uint32_t, uint8_t*> block_buf_addrs_;
+  // owns the attachment of managed_shm_, shared with outstanding leases
+  std::shared_ptr<void> mapping_;
 
  private:
   bool Remap();
   bool Recreate(const uint64_t& msg_size);
-  uint32_t GetNextWritableBlockIndex();
+  bool GetNextWritableBlockIndex(uint32_t* index);
+  bool ReserveBlockBuf(uint32_t index, uint64_t buf_size);
+
+  std::shared_ptr<std::atomic<uint32_t>> leased_block_num_;
+  std::atomic<uint64_t> remap_num_ = {0};
+  std::atomic<uint64_t> recreate_num_ = {0};
+  std::atomic<uint64_t> evicted_block_num_ = {0};
 };
 
 }  // namespace transport
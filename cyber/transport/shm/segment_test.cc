@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/segment.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/transport/shm/shm_conf.h"
+#include "cyber/transport/shm/xsi_segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(SegmentTest, lease_read_block) {
+  const uint64_t channel_id = 0x5e6d7c8b;
+  XsiSegment writer(channel_id);
+  XsiSegment reader(channel_id);
+
+  const std::string content = "leased";
+  WritableBlock wb;
+  ASSERT_TRUE(writer.AcquireBlockToWrite(content.size(), &wb));
+  std::memcpy(wb.buf, content.data(), content.size());
+  wb.block->set_msg_size(content.size());
+  writer.ReleaseWrittenBlock(wb);
+
+  ReadableBlock rb;
+  rb.index = wb.index;
+  ASSERT_TRUE(reader.AcquireBlockToRead(&rb));
+  auto lease = reader.LeaseReadBlock(rb);
+  EXPECT_EQ(reader.leased_block_num(), 1);
+
+  // the writer must go around the leased block
+  for (int i = 0; i < 1024; ++i) {
+    WritableBlock next;
+    ASSERT_TRUE(writer.AcquireBlockToWrite(content.size(), &next));
+    EXPECT_NE(next.index, rb.index);
+    writer.ReleaseWrittenBlock(next);
+  }
+  EXPECT_EQ(std::string(reinterpret_cast<char*>(lease->buf),
+                        lease->block->msg_size()),
+            content);
+
+  lease.reset();
+  EXPECT_EQ(reader.leased_block_num(), 0);
+}
+
+TEST(SegmentTest, variable_msg_size) {
+  const uint64_t channel_id = 0x5e6d7c8c;
+  XsiSegment writer(channel_id);
+  XsiSegment reader(channel_id);
+
+  // sizes jumping around like jpeg frames must not recreate the segment
+  const std::size_t sizes[] = {8 * 1024, 300 * 1024, 12 * 1024, 900 * 1024,
+                               64 * 1024};
+  std::string content;
+  for (int round = 0; round < 200; ++round) {
+    for (auto size : sizes) {
+      content.assign(size, static_cast<char>('a' + round % 26));
+      WritableBlock wb;
+      ASSERT_TRUE(writer.AcquireBlockToWrite(content.size(), &wb));
+      std::memcpy(wb.buf, content.data(), content.size());
+      wb.block->set_msg_size(content.size());
+      writer.ReleaseWrittenBlock(wb);
+
+      ReadableBlock rb;
+      rb.index = wb.index;
+      ASSERT_TRUE(reader.AcquireBlockToRead(&rb));
+      EXPECT_EQ(rb.block->msg_size(), size);
+      EXPECT_EQ(0, std::memcmp(rb.buf, content.data(), size));
+      reader.ReleaseReadBlock(rb);
+    }
+  }
+  EXPECT_EQ(writer.recreate_num(), 0);
+  EXPECT_EQ(reader.remap_num(), 0);
+  EXPECT_GT(writer.evicted_block_num(), 0);
+
+  // a message too large for the arena still gets a larger segment
+  content.assign(4 * 1024 * 1024, 'z');
+  WritableBlock wb;
+  ASSERT_TRUE(writer.AcquireBlockToWrite(content.size(), &wb));
+  wb.block->set_msg_size(content.size());
+  writer.ReleaseWrittenBlock(wb);
+  EXPECT_EQ(writer.recreate_num(), 1);
+
+  ReadableBlock rb;
+  rb.index = wb.index;
+  EXPECT_TRUE(reader.AcquireBlockToRead(&rb));
+  EXPECT_EQ(reader.remap_num(), 1);
+  reader.ReleaseReadBlock(rb);
+}
+
+TEST(SegmentTest, ceiling_msg_size_fills_all_blocks) {
+  const uint64_t channel_id = 0x5e6d7c8d;
+  XsiSegment writer(channel_id);
+  XsiSegment reader(channel_id);
+
+  // every block holds an unread message of the ceiling size at once
+  ShmConf conf;
+  const uint32_t block_num = conf.block_num();
+  const std::size_t msg_size = conf.ceiling_msg_size();
+  std::vector<uint32_t> indexes;
+  std::string content;
+  for (uint32_t i = 0; i < block_num; ++i) {
+    content.assign(msg_size, static_cast<char>('a' + i % 26));
+    WritableBlock wb;
+    ASSERT_TRUE(writer.AcquireBlockToWrite(content.size(), &wb));
+    std::memcpy(wb.buf, content.data(), content.size());
+    wb.block->set_msg_size(content.size());
+    writer.ReleaseWrittenBlock(wb);
+    indexes.push_back(wb.index);
+  }
+  EXPECT_EQ(writer.evicted_block_num(), 0);
+  EXPECT_EQ(writer.recreate_num(), 0);
+
+  for (uint32_t i = 0; i < block_num; ++i) {
+    content.assign(msg_size, static_cast<char>('a' + i % 26));
+    ReadableBlock rb;
+    rb.index = indexes[i];
+    ASSERT_TRUE(reader.AcquireBlockToRead(&rb));
+    EXPECT_EQ(rb.block->msg_size(), msg_size);
+    EXPECT_EQ(0, std::memcmp(rb.buf, content.data(), msg_size));
+    reader.ReleaseReadBlock(rb);
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -15,30 +15,45 @@
  *****************************************************************************/
 
 #include "cyber/transport/shm/shm_conf.h"
+
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 
 namespace apollo {
 namespace cyber {
 namespace transport {
 
-ShmConf::ShmConf() { Update(MESSAGE_SIZE_16K); }
+ShmConf::ShmConf() : leased_block_num_(GetLeasedBlockNum()) {
+  Update(MESSAGE_SIZE_16K);
+}
 
-ShmConf::ShmConf(const uint64_t& real_msg_size) { Update(real_msg_size); }
+ShmConf::ShmConf(const uint64_t& real_msg_size)
+    : leased_block_num_(GetLeasedBlockNum()) {
+  Update(real_msg_size);
+}
 
 ShmConf::~ShmConf() {}
 
 void ShmConf::Update(const uint64_t& real_msg_size) {
   ceiling_msg_size_ = GetCeilingMessageSize(real_msg_size);
-  block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
-  block_num_ = GetBlockNum(ceiling_msg_size_);
-  managed_shm_size_ =
-      EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_;
+  block_num_ = GetBlockNum(ceiling_msg_size_) + leased_block_num_;
+  arena_size_ = GetArenaSize(ceiling_msg_size_, block_num_);
+  managed_shm_size_ = EXTRA_SIZE + STATE_SIZE + BLOCK_SIZE * block_num_ +
+                      Arena::RequiredSize(arena_size_);
+}
+
+void ShmConf::Update(const uint64_t& ceiling_msg_size,
+                     const uint32_t& block_num) {
+  ceiling_msg_size_ = ceiling_msg_size;
+  block_num_ = block_num;
+  arena_size_ = GetArenaSize(ceiling_msg_size_, block_num_);
+  managed_shm_size_ = EXTRA_SIZE + STATE_SIZE + BLOCK_SIZE * block_num_ +
+                      Arena::RequiredSize(arena_size_);
 }
 
 const uint64_t ShmConf::EXTRA_SIZE = 1024 * 4;
 const uint64_t ShmConf::STATE_SIZE = 1024;
 const uint64_t ShmConf::BLOCK_SIZE = 1024;
-const uint64_t ShmConf::MESSAGE_INFO_SIZE = 1024;
 
 const uint32_t ShmConf::BLOCK_NUM_16K = 512;
 const uint64_t ShmConf::MESSAGE_SIZE_16K = 1024 * 16;
@@ -76,8 +91,11 @@ uint64_t ShmConf::GetCeilingMessageSize(const uint64_t& real_msg_size) {
   return ceiling_msg_size;
 }
 
-uint64_t ShmConf::GetBlockBufSize(const uint64_t& ceiling_msg_size) {
-  return ceiling_msg_size + MESSAGE_INFO_SIZE;
+uint64_t ShmConf::GetArenaSize(const uint64_t& ceiling_msg_size,
+                               const uint32_t& block_num) {
+  // ceilings are powers of two and message infos live in the blocks, so
+  // every block holds a ceiling sized message without evicting another
+  return block_num * ceiling_msg_size;
 }
 
 uint32_t ShmConf::GetBlockNum(const uint64_t& ceiling_msg_size) {
@@ -108,6 +126,14 @@ uint32_t ShmConf::GetBlockNum(const uint64_t& ceiling_msg_size) {
   return num;
 }
 
+uint32_t ShmConf::GetLeasedBlockNum() {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf()) {
+    return g_conf.transport_conf().shm_conf().leased_block_num();
+  }
+  return 0;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
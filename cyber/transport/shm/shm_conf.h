@@ -20,6 +20,8 @@
 #include <cstdint>
 #include <string>
 
+#include "cyber/transport/shm/arena.h"
+
 namespace apollo {
 namespace cyber {
 namespace transport {
@@ -31,21 +33,30 @@ class ShmConf {
   virtual ~ShmConf();
 
   void Update(const uint64_t& real_msg_size);
+  // adopt the layout of an existing segment
+  void Update(const uint64_t& ceiling_msg_size, const uint32_t& block_num);
 
   const uint64_t& ceiling_msg_size() { return ceiling_msg_size_; }
-  const uint64_t& block_buf_size() { return block_buf_size_; }
   const uint32_t& block_num() { return block_num_; }
   const uint64_t& managed_shm_size() { return managed_shm_size_; }
+  const uint32_t& leased_block_num() { return leased_block_num_; }
+  const uint64_t& arena_size() { return arena_size_; }
 
  private:
   uint64_t GetCeilingMessageSize(const uint64_t& real_msg_size);
-  uint64_t GetBlockBufSize(const uint64_t& ceiling_msg_size);
+  uint64_t GetArenaSize(const uint64_t& ceiling_msg_size,
+                        const uint32_t& block_num);
   uint32_t GetBlockNum(const uint64_t& ceiling_msg_size);
+  uint32_t GetLeasedBlockNum();
 
   uint64_t ceiling_msg_size_;
-  uint64_t block_buf_size_;
   uint32_t block_num_;
   uint64_t managed_shm_size_;
+  // block buffers are allocated from an arena of this size
+  uint64_t arena_size_;
+  // extra blocks so that writers still find free blocks while readers hold
+  // leases on received messages
+  uint32_t leased_block_num_;
 
   // Extra size, Byte
   static const uint64_t EXTRA_SIZE;
@@ -53,8 +64,6 @@ class ShmConf {
   static const uint64_t STATE_SIZE;
   // Block size, Byte
   static const uint64_t BLOCK_SIZE;
-  // Message info size, Byte
-  static const uint64_t MESSAGE_INFO_SIZE;
   // For message 0-10K
   static const uint32_t BLOCK_NUM_16K;
   static const uint64_t MESSAGE_SIZE_16K;
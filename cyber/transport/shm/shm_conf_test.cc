@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/shm_conf.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ShmConfTest, arena_size) {
+  const uint64_t kMB = 1024 * 1024;
+  struct Tier {
+    uint64_t msg_size;
+    uint64_t ceiling_msg_size;
+    uint32_t block_num;
+    uint64_t arena_size;
+  };
+  // every block holds a ceiling sized message, and not a byte more
+  const Tier tiers[] = {
+      {10 * 1024, 16 * 1024, 512, 8 * kMB},
+      {100 * 1024, 128 * 1024, 128, 16 * kMB},
+      {kMB, kMB, 64, 64 * kMB},
+      {6 * kMB, 8 * kMB, 32, 256 * kMB},
+      {10 * kMB, 16 * kMB, 16, 256 * kMB},
+      {20 * kMB, 32 * kMB, 8, 256 * kMB},
+  };
+  for (const auto& tier : tiers) {
+    ShmConf conf(tier.msg_size);
+    const uint32_t leased_block_num = conf.leased_block_num();
+    EXPECT_EQ(conf.ceiling_msg_size(), tier.ceiling_msg_size);
+    EXPECT_EQ(conf.block_num(), tier.block_num + leased_block_num);
+    EXPECT_EQ(conf.arena_size(),
+              tier.arena_size + leased_block_num * tier.ceiling_msg_size);
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -20,8 +20,8 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
-State::State(const uint64_t& ceiling_msg_size)
-    : ceiling_msg_size_(ceiling_msg_size) {}
+State::State(const uint64_t& ceiling_msg_size, const uint32_t& block_num)
+    : ceiling_msg_size_(ceiling_msg_size), block_num_(block_num) {}
 
 State::~State() {}
 
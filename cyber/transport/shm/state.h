@@ -28,7 +28,7 @@ namespace transport {
 
 class State {
  public:
-  explicit State(const uint64_t& ceiling_msg_size);
+  State(const uint64_t& ceiling_msg_size, const uint32_t& block_num);
   virtual ~State();
 
   void DecreaseReferenceCounts() {
@@ -50,6 +50,7 @@ class State {
   bool need_remap() { return need_remap_; }
 
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
+  uint32_t block_num() { return block_num_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
 
  private:
@@ -57,6 +58,8 @@ class State {
   std::atomic<uint32_t> seq_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
+  // decided by the creator, openers must not derive it from their own conf
+  std::atomic<uint32_t> block_num_;
 };
 
 }  // namespace transport
@@ -74,18 +74,20 @@ bool XsiSegment::OpenOrCreate() {
     shmctl(shmid, IPC_RMID, 0);
     return false;
   }
+  mapping_.reset(managed_shm_, [](void* addr) { shmdt(addr); });
 
   // create field state_
-  state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
+  state_ = new (managed_shm_)
+      State(conf_.ceiling_msg_size(), conf_.block_num());
   if (state_ == nullptr) {
     AERROR << "create state failed.";
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
     shmctl(shmid, IPC_RMID, 0);
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->block_num());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
@@ -94,34 +96,22 @@ bool XsiSegment::OpenOrCreate() {
     AERROR << "create blocks failed.";
     state_->~State();
     state_ = nullptr;
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
     shmctl(shmid, IPC_RMID, 0);
     return false;
   }
 
-  // create block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr =
-        new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
-
-    std::lock_guard<std::mutex> _g(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "create block buf failed.";
+  // create field arena_
+  arena_ = new (static_cast<char*>(managed_shm_) + sizeof(State) +
+                conf_.block_num() * sizeof(Block))
+      Arena(conf_.arena_size());
+  if (arena_ == nullptr) {
+    AERROR << "create arena failed.";
     state_->~State();
     state_ = nullptr;
     blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> _g(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
     shmctl(shmid, IPC_RMID, 0);
     return false;
@@ -151,17 +141,18 @@ bool XsiSegment::OpenOnly() {
     AERROR << "attach shm failed, error: " << strerror(errno);
     return false;
   }
+  mapping_.reset(managed_shm_, [](void* addr) { shmdt(addr); });
 
   // get field state_
   state_ = reinterpret_cast<State*>(managed_shm_);
   if (state_ == nullptr) {
     AERROR << "get state failed.";
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->block_num());
 
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
@@ -169,37 +160,21 @@ bool XsiSegment::OpenOnly() {
   if (blocks_ == nullptr) {
     AERROR << "get blocks failed.";
     state_ = nullptr;
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
     return false;
   }
 
-  // get block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr = reinterpret_cast<uint8_t*>(
-        static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
-
-    if (addr == nullptr) {
-      break;
-    }
-    std::lock_guard<std::mutex> _g(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "open only failed.";
-    state_->~State();
+  // get field arena_
+  arena_ = reinterpret_cast<Arena*>(static_cast<char*>(managed_shm_) +
+                                    sizeof(State) +
+                                    conf_.block_num() * sizeof(Block));
+  if (arena_ == nullptr) {
+    AERROR << "get arena failed.";
     state_ = nullptr;
     blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> _g(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
-    shmctl(shmid, IPC_RMID, 0);
     return false;
   }
 
@@ -222,12 +197,9 @@ bool XsiSegment::Remove() {
 void XsiSegment::Reset() {
   state_ = nullptr;
   blocks_ = nullptr;
-  {
-    std::lock_guard<std::mutex> _g(block_buf_lock_);
-    block_buf_addrs_.clear();
-  }
+  arena_ = nullptr;
   if (managed_shm_ != nullptr) {
-    shmdt(managed_shm_);
+    mapping_.reset();
     managed_shm_ = nullptr;
     return;
   }
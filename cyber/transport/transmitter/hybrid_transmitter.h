@@ -32,6 +32,7 @@
 #include "cyber/proto/transport_conf.pb.h"
 #include "cyber/task/task.h"
 #include "cyber/transport/message/history.h"
+#include "cyber/transport/message/serialized_payload.h"
 #include "cyber/transport/rtps/participant.h"
 #include "cyber/transport/transmitter/intra_transmitter.h"
 #include "cyber/transport/transmitter/rtps_transmitter.h"
@@ -83,6 +84,7 @@ class HybridTransmitter : public Transmitter<M> {
   void ThreadFunc(const RoleAttributes& opposite_attr,
                   const std::vector<typename History<M>::CachedMessage>& msgs);
   Relation GetRelation(const RoleAttributes& opposite_attr);
+  int SerializingTransmitterNum();
 
   HistoryPtr history_;
   TransmitterMap transmitters_;
@@ -165,12 +167,28 @@ bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
                                     const MessageInfo& msg_info) {
   std::lock_guard<std::mutex> lock(mutex_);
   history_->Add(msg, msg_info);
+  // serialize once if the message goes out through both shm and rtps
+  SerializedPayloadPtr payload = nullptr;
+  if (SerializingTransmitterNum() > 1) {
+    payload = SerializedPayload::Create(*msg);
+  }
   for (auto& item : transmitters_) {
-    item.second->Transmit(msg, msg_info);
+    item.second->Transmit(msg, msg_info, payload);
   }
   return true;
 }
 
+template <typename M>
+int HybridTransmitter<M>::SerializingTransmitterNum() {
+  int num = 0;
+  for (auto& item : receivers_) {
+    if (item.first != OptionalMode::INTRA && !item.second.empty()) {
+      ++num;
+    }
+  }
+  return num;
+}
+
 template <typename M>
 void HybridTransmitter<M>::InitMode() {
   mode_ = std::make_shared<proto::CommunicationMode>();
@@ -47,9 +47,12 @@ class RtpsTransmitter : public Transmitter<M> {
   void Disable() override;
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info,
+                const SerializedPayloadPtr& payload) override;
 
  private:
-  bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Transmit(const M& msg, const MessageInfo& msg_info,
+                SerializedPayload* payload);
 
   ParticipantPtr participant_;
   eprosima::fastrtps::Publisher* publisher_;
@@ -93,18 +96,31 @@ void RtpsTransmitter<M>::Disable() {
 template <typename M>
 bool RtpsTransmitter<M>::Transmit(const MessagePtr& msg,
                                   const MessageInfo& msg_info) {
-  return Transmit(*msg, msg_info);
+  return Transmit(*msg, msg_info, nullptr);
 }
 
 template <typename M>
-bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
+bool RtpsTransmitter<M>::Transmit(const MessagePtr& msg,
+                                  const MessageInfo& msg_info,
+                                  const SerializedPayloadPtr& payload) {
+  return Transmit(*msg, msg_info, payload.get());
+}
+
+template <typename M>
+bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info,
+                                  SerializedPayload* payload) {
   if (!this->enabled_) {
     ADEBUG << "not enable.";
     return false;
   }
 
   UnderlayMessage m;
-  RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  if (payload != nullptr) {
+    // borrow the shared bytes for the synchronous write below
+    m.data().swap(*payload->mutable_data());
+  } else {
+    RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  }
 
   eprosima::fastrtps::rtps::WriteParams wparams;
 
@@ -119,10 +135,14 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   wparams.related_sample_identity().sequence_number().low =
       (int32_t)(msg_info.seq_num() & 0xFFFFFFFF);
 
-  if (participant_->is_shutdown()) {
-    return false;
+  bool result = false;
+  if (!participant_->is_shutdown()) {
+    result = publisher_->write(reinterpret_cast<void*>(&m), wparams);
+  }
+  if (payload != nullptr) {
+    m.data().swap(*payload->mutable_data());
   }
-  return publisher_->write(reinterpret_cast<void*>(&m), wparams);
+  return result;
 }
 
 }  // namespace transport
@@ -47,9 +47,12 @@ class ShmTransmitter : public Transmitter<M> {
   void Disable() override;
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info,
+                const SerializedPayloadPtr& payload) override;
 
  private:
-  bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Transmit(const M& msg, const MessageInfo& msg_info,
+                const SerializedPayload* payload);
 
   SegmentPtr segment_;
   uint64_t channel_id_;
@@ -94,33 +97,44 @@ void ShmTransmitter<M>::Disable() {
 template <typename M>
 bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
                                  const MessageInfo& msg_info) {
-  return Transmit(*msg, msg_info);
+  return Transmit(*msg, msg_info, nullptr);
 }
 
 template <typename M>
-bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
+bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
+                                 const MessageInfo& msg_info,
+                                 const SerializedPayloadPtr& payload) {
+  return Transmit(*msg, msg_info, payload.get());
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info,
+                                 const SerializedPayload* payload) {
   if (!this->enabled_) {
     ADEBUG << "not enable.";
     return false;
   }
 
   WritableBlock wb;
-  std::size_t msg_size = message::ByteSize(msg);
+  std::size_t msg_size =
+      payload != nullptr ? payload->size() : message::ByteSize(msg);
   if (!segment_->AcquireBlockToWrite(msg_size, &wb)) {
     AERROR << "acquire block failed.";
     return false;
   }
 
   ADEBUG << "block index: " << wb.index;
-  if (!message::SerializeToArray(msg, wb.buf, static_cast<int>(msg_size))) {
+  if (payload != nullptr) {
+    std::memcpy(wb.buf, payload->data().data(), msg_size);
+  } else if (!message::SerializeToArray(msg, wb.buf,
+                                        static_cast<int>(msg_size))) {
     AERROR << "serialize to array failed.";
     segment_->ReleaseWrittenBlock(wb);
     return false;
   }
   wb.block->set_msg_size(msg_size);
 
-  char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
-  if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+  if (!msg_info.SerializeTo(wb.block->msg_info(), Block::kMsgInfoCapacity)) {
     AERROR << "serialize message info failed.";
     segment_->ReleaseWrittenBlock(wb);
     return false;
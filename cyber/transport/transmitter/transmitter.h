@@ -24,6 +24,7 @@
 #include "cyber/event/perf_event_cache.h"
 #include "cyber/transport/common/endpoint.h"
 #include "cyber/transport/message/message_info.h"
+#include "cyber/transport/message/serialized_payload.h"
 
 namespace apollo {
 namespace cyber {
@@ -48,6 +49,10 @@ class Transmitter : public Endpoint {
 
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
+  // Transports that send the message in serialized form take the bytes from
+  // payload, if one is given, instead of serializing msg again.
+  virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info,
+                        const SerializedPayloadPtr& payload);
 
   uint64_t NextSeqNum() { return ++seq_num_; }
 
@@ -76,6 +81,14 @@ bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   return Transmit(msg, msg_info_);
 }
 
+template <typename M>
+bool Transmitter<M>::Transmit(const MessagePtr& msg,
+                              const MessageInfo& msg_info,
+                              const SerializedPayloadPtr& payload) {
+  (void)payload;
+  return Transmit(msg, msg_info);
+}
+
 template <typename M>
 void Transmitter<M>::Enable(const RoleAttributes& opposite_attr) {
   (void)opposite_attr;
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/point_cloud_packing.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+namespace {
+
+template <typename FromT, typename ToT>
+void CopyAttributes(const FromT& from, ToT* to) {
+  if (from.has_header()) {
+    to->mutable_header()->CopyFrom(from.header());
+  } else {
+    to->clear_header();
+  }
+  if (from.has_frame_id()) {
+    to->set_frame_id(from.frame_id());
+  } else {
+    to->clear_frame_id();
+  }
+  if (from.has_is_dense()) {
+    to->set_is_dense(from.is_dense());
+  } else {
+    to->clear_is_dense();
+  }
+  if (from.has_measurement_time()) {
+    to->set_measurement_time(from.measurement_time());
+  } else {
+    to->clear_measurement_time();
+  }
+  if (from.has_width()) {
+    to->set_width(from.width());
+  } else {
+    to->clear_width();
+  }
+  if (from.has_height()) {
+    to->set_height(from.height());
+  } else {
+    to->clear_height();
+  }
+}
+
+}  // namespace
+
+void PackPointCloud(const drivers::PointCloud& cloud,
+                    drivers::PackedPointCloud* packed) {
+  CopyAttributes(cloud, packed);
+  const int size = cloud.point_size();
+  packed->mutable_x()->Resize(size, 0.0f);
+  packed->mutable_y()->Resize(size, 0.0f);
+  packed->mutable_z()->Resize(size, 0.0f);
+  packed->mutable_intensity()->Resize(size, 0);
+  packed->mutable_timestamp()->Resize(size, 0);
+  float* x = packed->mutable_x()->mutable_data();
+  float* y = packed->mutable_y()->mutable_data();
+  float* z = packed->mutable_z()->mutable_data();
+  uint32_t* intensity = packed->mutable_intensity()->mutable_data();
+  uint64_t* timestamp = packed->mutable_timestamp()->mutable_data();
+  for (int i = 0; i < size; ++i) {
+    const auto& point = cloud.point(i);
+    x[i] = point.x();
+    y[i] = point.y();
+    z[i] = point.z();
+    intensity[i] = point.intensity();
+    timestamp[i] = point.timestamp();
+  }
+}
+
+bool UnpackPointCloud(const drivers::PackedPointCloud& packed,
+                      drivers::PointCloud* cloud) {
+  if (!HasConsistentColumns(packed)) {
+    return false;
+  }
+  CopyAttributes(packed, cloud);
+  const int size = packed.x_size();
+  cloud->clear_point();
+  cloud->mutable_point()->Reserve(size);
+  for (int i = 0; i < size; ++i) {
+    auto* point = cloud->add_point();
+    point->set_x(packed.x(i));
+    point->set_y(packed.y(i));
+    point->set_z(packed.z(i));
+    point->set_intensity(packed.intensity(i));
+    point->set_timestamp(packed.timestamp(i));
+  }
+  return true;
+}
+
+bool HasConsistentColumns(const drivers::PackedPointCloud& cloud) {
+  const int size = cloud.x_size();
+  return cloud.y_size() == size && cloud.z_size() == size &&
+         cloud.intensity_size() == size && cloud.timestamp_size() == size;
+}
+
+void ReservePointCloud(int size, drivers::PackedPointCloud* cloud) {
+  cloud->mutable_x()->Reserve(size);
+  cloud->mutable_y()->Reserve(size);
+  cloud->mutable_z()->Reserve(size);
+  cloud->mutable_intensity()->Reserve(size);
+  cloud->mutable_timestamp()->Reserve(size);
+}
+
+void ClearPoints(drivers::PackedPointCloud* cloud) {
+  cloud->clear_x();
+  cloud->clear_y();
+  cloud->clear_z();
+  cloud->clear_intensity();
+  cloud->clear_timestamp();
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
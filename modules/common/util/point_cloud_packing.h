@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Conversions between the per-point drivers::PointCloud and the
+ * column packed drivers::PackedPointCloud, and the few operations that code
+ * handling either of them needs.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @brief Copy `cloud` into `packed`, replacing its points. The header and
+ * the cloud attributes are copied along.
+ */
+void PackPointCloud(const drivers::PointCloud& cloud,
+                    drivers::PackedPointCloud* packed);
+
+/**
+ * @brief Copy `packed` into `cloud`, replacing its points. The header and
+ * the cloud attributes are copied along. Returns false, leaving `cloud`
+ * untouched, if the columns of `packed` differ in size.
+ */
+bool UnpackPointCloud(const drivers::PackedPointCloud& packed,
+                      drivers::PointCloud* cloud);
+
+/**
+ * @brief Plain copy of one point, so code templated on the cloud type can
+ * read either of them by index.
+ */
+struct PointRecord {
+  float x;
+  float y;
+  float z;
+  uint32_t intensity;
+  uint64_t timestamp;
+};
+
+inline PointRecord GetPoint(const drivers::PointCloud& cloud, int index) {
+  const auto& point = cloud.point(index);
+  return {point.x(), point.y(), point.z(), point.intensity(),
+          point.timestamp()};
+}
+
+inline PointRecord GetPoint(const drivers::PackedPointCloud& cloud,
+                            int index) {
+  return {cloud.x(index), cloud.y(index), cloud.z(index),
+          cloud.intensity(index), cloud.timestamp(index)};
+}
+
+/**
+ * @brief Whether all the columns of `cloud` hold the same number of points.
+ * The columns of a received PackedPointCloud are filled independently, and
+ * code reading them through raw pointers up to x_size() must check this
+ * first.
+ */
+inline bool HasConsistentColumns(const drivers::PointCloud&) {
+  return true;
+}
+
+bool HasConsistentColumns(const drivers::PackedPointCloud& cloud);
+
+inline int PointCloudSize(const drivers::PointCloud& cloud) {
+  return cloud.point_size();
+}
+
+inline int PointCloudSize(const drivers::PackedPointCloud& cloud) {
+  return cloud.x_size();
+}
+
+inline void ReservePointCloud(int size, drivers::PointCloud* cloud) {
+  cloud->mutable_point()->Reserve(size);
+}
+
+void ReservePointCloud(int size, drivers::PackedPointCloud* cloud);
+
+inline void ClearPoints(drivers::PointCloud* cloud) { cloud->clear_point(); }
+
+void ClearPoints(drivers::PackedPointCloud* cloud);
+
+inline void AddPoint(float x, float y, float z, uint32_t intensity,
+                     uint64_t timestamp, drivers::PointCloud* cloud) {
+  auto* point = cloud->add_point();
+  point->set_x(x);
+  point->set_y(y);
+  point->set_z(z);
+  point->set_intensity(intensity);
+  point->set_timestamp(timestamp);
+}
+
+inline void AddPoint(float x, float y, float z, uint32_t intensity,
+                     uint64_t timestamp, drivers::PackedPointCloud* cloud) {
+  cloud->add_x(x);
+  cloud->add_y(y);
+  cloud->add_z(z);
+  cloud->add_intensity(intensity);
+  cloud->add_timestamp(timestamp);
+}
+
+template <typename CloudT>
+inline void AddPoint(const PointRecord& point, CloudT* cloud) {
+  AddPoint(point.x, point.y, point.z, point.intensity, point.timestamp, cloud);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,184 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/point_cloud_packing.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+namespace {
+
+using drivers::PackedPointCloud;
+using drivers::PointCloud;
+
+// about one frame of a 128 beam lidar
+constexpr int kBenchmarkPointNum = 240000;
+
+template <typename CloudT>
+void FillCloud(int size, CloudT* cloud) {
+  cloud->mutable_header()->set_timestamp_sec(1.5);
+  cloud->mutable_header()->set_frame_id("velodyne128");
+  cloud->set_frame_id("velodyne128");
+  cloud->set_is_dense(false);
+  cloud->set_measurement_time(1.5);
+  cloud->set_width(size);
+  cloud->set_height(1);
+  ClearPoints(cloud);
+  ReservePointCloud(size, cloud);
+  for (int i = 0; i < size; ++i) {
+    AddPoint(0.01f * static_cast<float>(i), -0.02f * static_cast<float>(i),
+             0.001f * static_cast<float>(i), i % 256,
+             1500000000ULL + static_cast<uint64_t>(i) * 400, cloud);
+  }
+}
+
+double Sum(const PointCloud& cloud) {
+  double sum = 0.0;
+  for (int i = 0; i < cloud.point_size(); ++i) {
+    const auto& point = cloud.point(i);
+    sum += point.x() + point.y() + point.z() + point.intensity();
+  }
+  return sum;
+}
+
+double Sum(const PackedPointCloud& cloud) {
+  double sum = 0.0;
+  for (int i = 0; i < cloud.x_size(); ++i) {
+    sum += cloud.x(i) + cloud.y(i) + cloud.z(i) + cloud.intensity(i);
+  }
+  return sum;
+}
+
+// driver encode, compensator decode and encode, perception decode, which
+// are the serialization hops a cloud takes between driver and perception
+template <typename CloudT>
+double DriverToPerceptionMs(int rounds, double* checksum) {
+  CloudT driver_cloud;
+  CloudT compensator_cloud;
+  CloudT perception_cloud;
+  std::string wire;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; ++i) {
+    FillCloud(kBenchmarkPointNum, &driver_cloud);
+    driver_cloud.SerializeToString(&wire);
+    compensator_cloud.ParseFromString(wire);
+    compensator_cloud.SerializeToString(&wire);
+    perception_cloud.ParseFromString(wire);
+    *checksum += Sum(perception_cloud);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         rounds;
+}
+
+}  // namespace
+
+TEST(PointCloudPackingTest, RoundTrip) {
+  PointCloud cloud;
+  FillCloud(100, &cloud);
+
+  PackedPointCloud packed;
+  PackPointCloud(cloud, &packed);
+  ASSERT_EQ(100, PointCloudSize(packed));
+  EXPECT_EQ("velodyne128", packed.header().frame_id());
+  EXPECT_EQ("velodyne128", packed.frame_id());
+  EXPECT_FALSE(packed.is_dense());
+  EXPECT_DOUBLE_EQ(1.5, packed.measurement_time());
+  EXPECT_EQ(100, packed.width());
+  EXPECT_EQ(1, packed.height());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FLOAT_EQ(cloud.point(i).x(), packed.x(i));
+    EXPECT_FLOAT_EQ(cloud.point(i).y(), packed.y(i));
+    EXPECT_FLOAT_EQ(cloud.point(i).z(), packed.z(i));
+    EXPECT_EQ(cloud.point(i).intensity(), packed.intensity(i));
+    EXPECT_EQ(cloud.point(i).timestamp(), packed.timestamp(i));
+  }
+
+  PointCloud unpacked;
+  EXPECT_TRUE(UnpackPointCloud(packed, &unpacked));
+  EXPECT_EQ(cloud.SerializeAsString(), unpacked.SerializeAsString());
+}
+
+TEST(PointCloudPackingTest, Repack) {
+  PointCloud cloud;
+  FillCloud(100, &cloud);
+  PackedPointCloud packed;
+  PackPointCloud(cloud, &packed);
+
+  // a pooled message is reused for a smaller cloud without leftovers
+  FillCloud(10, &cloud);
+  cloud.clear_is_dense();
+  PackPointCloud(cloud, &packed);
+  EXPECT_EQ(10, PointCloudSize(packed));
+  EXPECT_EQ(10, packed.timestamp_size());
+  EXPECT_FALSE(packed.has_is_dense());
+
+  ClearPoints(&packed);
+  EXPECT_EQ(0, PointCloudSize(packed));
+  EXPECT_EQ(0, packed.intensity_size());
+}
+
+TEST(PointCloudPackingTest, ConsistentColumns) {
+  PackedPointCloud packed;
+  EXPECT_TRUE(HasConsistentColumns(packed));
+  FillCloud(10, &packed);
+  EXPECT_TRUE(HasConsistentColumns(packed));
+
+  // a sender may fill the columns of a received cloud unevenly
+  packed.add_y(0.0f);
+  EXPECT_FALSE(HasConsistentColumns(packed));
+  packed.mutable_y()->Truncate(10);
+  packed.mutable_timestamp()->Truncate(9);
+  EXPECT_FALSE(HasConsistentColumns(packed));
+
+  PointCloud cloud;
+  FillCloud(10, &cloud);
+  EXPECT_TRUE(HasConsistentColumns(cloud));
+  EXPECT_FALSE(UnpackPointCloud(packed, &cloud));
+  EXPECT_EQ(10, cloud.point_size());
+}
+
+TEST(PointCloudPackingTest, DriverToPerceptionBenchmark) {
+  constexpr int kRounds = 5;
+  double legacy_checksum = 0.0;
+  double packed_checksum = 0.0;
+  const double legacy_ms =
+      DriverToPerceptionMs<PointCloud>(kRounds, &legacy_checksum);
+  const double packed_ms =
+      DriverToPerceptionMs<PackedPointCloud>(kRounds, &packed_checksum);
+  EXPECT_DOUBLE_EQ(legacy_checksum, packed_checksum);
+
+  PointCloud cloud;
+  FillCloud(kBenchmarkPointNum, &cloud);
+  PackedPointCloud packed;
+  PackPointCloud(cloud, &packed);
+  std::cout << kBenchmarkPointNum << " points, driver to perception: "
+            << "PointCloud " << legacy_ms << " ms, "
+            << cloud.ByteSizeLong() / 1024 << " KiB; "
+            << "PackedPointCloud " << packed_ms << " ms, "
+            << packed.ByteSizeLong() / 1024 << " KiB" << std::endl;
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
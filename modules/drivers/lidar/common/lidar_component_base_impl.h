@@ -23,6 +23,7 @@
 #include "modules/drivers/lidar/common/proto/lidar_config_base.pb.h"
 
 #include "cyber/cyber.h"
+#include "modules/common/util/point_cloud_packing.h"
 #include "modules/drivers/lidar/common/sync_buffering.h"
 
 namespace apollo {
@@ -56,6 +57,11 @@ class LidarComponentBaseImpl : public apollo::cyber::Component<ComponentType> {
     static void PcdDefaultCleaner(
             std::shared_ptr<PointCloud>& unused_pcd_frame);
 
+    static std::shared_ptr<PackedPointCloud> PackedPcdDefaultAllocator();
+
+    static void PackedPcdDefaultCleaner(
+            std::shared_ptr<PackedPointCloud>& unused_pcd_frame);
+
     std::string frame_id_;
 
  private:
@@ -63,6 +69,11 @@ class LidarComponentBaseImpl : public apollo::cyber::Component<ComponentType> {
     std::shared_ptr<cyber::Reader<ScanType>> scan_reader_ = nullptr;
     std::shared_ptr<cyber::Writer<PointCloud>> pcd_writer_ = nullptr;
     std::shared_ptr<SyncBuffering<PointCloud>> pcd_buffer_ = nullptr;
+    // set when the point cloud channel carries PackedPointCloud
+    std::shared_ptr<cyber::Writer<PackedPointCloud>> packed_pcd_writer_
+            = nullptr;
+    std::shared_ptr<SyncBuffering<PackedPointCloud>> packed_pcd_buffer_
+            = nullptr;
 
     std::atomic<int> pcd_sequence_num_{0};
 };
@@ -70,9 +81,21 @@ class LidarComponentBaseImpl : public apollo::cyber::Component<ComponentType> {
 template <typename ScanType, typename ComponentType>
 bool LidarComponentBaseImpl<ScanType, ComponentType>::InitConverter(
         const LidarConfigBase& lidar_config_base) {
-    pcd_writer_ = this->node_->template CreateWriter<PointCloud>(
-            lidar_config_base.point_cloud_channel());
-    RETURN_VAL_IF(pcd_writer_ == nullptr, false);
+    if (lidar_config_base.packed_point_cloud()) {
+        packed_pcd_writer_
+                = this->node_->template CreateWriter<PackedPointCloud>(
+                        lidar_config_base.point_cloud_channel());
+        RETURN_VAL_IF(packed_pcd_writer_ == nullptr, false);
+        packed_pcd_buffer_ = std::make_shared<SyncBuffering<PackedPointCloud>>(
+                LidarComponentBaseImpl::PackedPcdDefaultAllocator,
+                LidarComponentBaseImpl::PackedPcdDefaultCleaner);
+        packed_pcd_buffer_->SetBufferSize(lidar_config_base.buffer_size());
+        packed_pcd_buffer_->Init();
+    } else {
+        pcd_writer_ = this->node_->template CreateWriter<PointCloud>(
+                lidar_config_base.point_cloud_channel());
+        RETURN_VAL_IF(pcd_writer_ == nullptr, false);
+    }
 
     if (lidar_config_base.source_type()
         == LidarConfigBase_SourceType_RAW_PACKET) {
@@ -127,6 +150,13 @@ bool LidarComponentBaseImpl<ScanType, ComponentType>::WritePointCloud(
             pcd_sequence_num_.fetch_add(1));
     point_cloud->mutable_header()->set_timestamp_sec(
             cyber::Time().Now().ToSecond());
+    if (packed_pcd_writer_ != nullptr) {
+        std::shared_ptr<PackedPointCloud> packed
+                = packed_pcd_buffer_->AllocateElement();
+        apollo::common::util::PackPointCloud(*point_cloud, packed.get());
+        RETURN_VAL_IF(!packed_pcd_writer_->Write(packed), false);
+        return true;
+    }
     RETURN_VAL_IF(!pcd_writer_->Write(point_cloud), false);
     return true;
 }
@@ -147,6 +177,25 @@ void LidarComponentBaseImpl<ScanType, ComponentType>::PcdDefaultCleaner(
         std::shared_ptr<PointCloud>& unused_pcd_frame) {
     unused_pcd_frame->clear_point();
 }
+
+template <typename ScanType, typename ComponentType>
+std::shared_ptr<PackedPointCloud>
+LidarComponentBaseImpl<ScanType, ComponentType>::PackedPcdDefaultAllocator() {
+    constexpr int default_point_cloud_reserve = 170000;
+    std::shared_ptr<PackedPointCloud> new_pcd_object
+            = std::make_shared<PackedPointCloud>();
+    apollo::common::util::ReservePointCloud(
+            default_point_cloud_reserve, new_pcd_object.get());
+    AINFO << "new packed pcd frame memory allocated, reserve point size = "
+          << default_point_cloud_reserve;
+    return new_pcd_object;
+}
+
+template <typename ScanType, typename ComponentType>
+void LidarComponentBaseImpl<ScanType, ComponentType>::PackedPcdDefaultCleaner(
+        std::shared_ptr<PackedPointCloud>& unused_pcd_frame) {
+    apollo::common::util::ClearPoints(unused_pcd_frame.get());
+}
 }  // namespace lidar
 }  // namespace drivers
 }  // namespace apollo
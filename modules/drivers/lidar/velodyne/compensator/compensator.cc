@@ -20,6 +20,8 @@
 #include <memory>
 #include <string>
 
+#include "modules/common/util/point_cloud_packing.h"
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -61,7 +63,18 @@ bool Compensator::QueryPoseAffineFromTF2(const uint64_t& timestamp, void* pose,
 bool Compensator::MotionCompensation(
     const std::shared_ptr<const PointCloud>& msg,
     std::shared_ptr<PointCloud> msg_compensated) {
-  if (msg->height() == 0 || msg->width() == 0) {
+  return Compensate(*msg, msg_compensated.get());
+}
+
+bool Compensator::MotionCompensation(
+    const std::shared_ptr<const PackedPointCloud>& msg,
+    std::shared_ptr<PackedPointCloud> msg_compensated) {
+  return Compensate(*msg, msg_compensated.get());
+}
+
+template <typename CloudT>
+bool Compensator::Compensate(const CloudT& msg, CloudT* msg_compensated) {
+  if (msg.height() == 0 || msg.width() == 0) {
     AERROR << "PointCloud width & height should not be 0";
     return false;
   }
@@ -71,48 +84,59 @@ bool Compensator::MotionCompensation(
 
   uint64_t timestamp_min = 0;
   uint64_t timestamp_max = 0;
-  std::string frame_id = msg->header().frame_id();
-  GetTimestampInterval(msg, &timestamp_min, &timestamp_max);
+  std::string frame_id = msg.header().frame_id();
+  if (!GetTimestampInterval(msg, &timestamp_min, &timestamp_max)) {
+    return false;
+  }
 
   msg_compensated->mutable_header()->set_timestamp_sec(
       cyber::Time::Now().ToSecond());
-  msg_compensated->mutable_header()->set_frame_id(msg->header().frame_id());
+  msg_compensated->mutable_header()->set_frame_id(msg.header().frame_id());
   msg_compensated->mutable_header()->set_lidar_timestamp(
-      msg->header().lidar_timestamp());
-  msg_compensated->set_measurement_time(msg->measurement_time());
-  msg_compensated->set_height(msg->height());
-  msg_compensated->set_is_dense(msg->is_dense());
+      msg.header().lidar_timestamp());
+  msg_compensated->set_measurement_time(msg.measurement_time());
+  msg_compensated->set_height(msg.height());
+  msg_compensated->set_is_dense(msg.is_dense());
 
   uint64_t new_time = cyber::Time().Now().ToNanosecond();
   AINFO << "compenstator new msg diff:" << new_time - start
-        << ";meta:" << msg->header().lidar_timestamp();
-  msg_compensated->mutable_point()->Reserve(240000);
+        << ";meta:" << msg.header().lidar_timestamp();
+  common::util::ReservePointCloud(240000, msg_compensated);
 
   // compensate point cloud, remove nan point
   if (QueryPoseAffineFromTF2(timestamp_min, &pose_min_time, frame_id) &&
       QueryPoseAffineFromTF2(timestamp_max, &pose_max_time, frame_id)) {
     uint64_t tf_time = cyber::Time().Now().ToNanosecond();
     AINFO << "compenstator tf msg diff:" << tf_time - new_time
-          << ";meta:" << msg->header().lidar_timestamp();
-    MotionCompensation(msg, msg_compensated, timestamp_min, timestamp_max,
-                       pose_min_time, pose_max_time);
+          << ";meta:" << msg.header().lidar_timestamp();
+    kernel_.Init(timestamp_min, timestamp_max, pose_min_time, pose_max_time);
+    if (!ApplyCompensation(msg, msg_compensated)) {
+      return false;
+    }
     uint64_t com_time = cyber::Time().Now().ToNanosecond();
-    msg_compensated->set_width(msg_compensated->point_size() / msg->height());
+    msg_compensated->set_width(
+        common::util::PointCloudSize(*msg_compensated) / msg.height());
     AINFO << "compenstator com msg diff:" << com_time - tf_time
-          << ";meta:" << msg->header().lidar_timestamp();
+          << ";meta:" << msg.header().lidar_timestamp();
     return true;
   }
   return false;
 }
 
-inline void Compensator::GetTimestampInterval(
-    const std::shared_ptr<const PointCloud>& msg, uint64_t* timestamp_min,
-    uint64_t* timestamp_max) {
+template <typename CloudT>
+bool Compensator::GetTimestampInterval(const CloudT& msg,
+                                       uint64_t* timestamp_min,
+                                       uint64_t* timestamp_max) {
+  if (!common::util::HasConsistentColumns(msg)) {
+    AERROR << "PointCloud columns differ in size";
+    return false;
+  }
   *timestamp_max = 0;
   *timestamp_min = std::numeric_limits<uint64_t>::max();
 
-  for (const auto& point : msg->point()) {
-    uint64_t timestamp = point.timestamp();
+  const int size = common::util::PointCloudSize(msg);
+  for (int i = 0; i < size; ++i) {
+    uint64_t timestamp = common::util::GetPoint(msg, i).timestamp;
     if (timestamp < *timestamp_min) {
       *timestamp_min = timestamp;
     }
@@ -121,102 +145,93 @@ inline void Compensator::GetTimestampInterval(
       *timestamp_max = timestamp;
     }
   }
+  return true;
 }
 
-void Compensator::MotionCompensation(
-    const std::shared_ptr<const PointCloud>& msg,
-    std::shared_ptr<PointCloud> msg_compensated, const uint64_t timestamp_min,
-    const uint64_t timestamp_max, const Eigen::Affine3d& pose_min_time,
-    const Eigen::Affine3d& pose_max_time) {
-  using std::abs;
-  using std::acos;
-  using std::sin;
-
-  Eigen::Vector3d translation =
-      pose_min_time.translation() - pose_max_time.translation();
-  Eigen::Quaterniond q_max(pose_max_time.linear());
-  Eigen::Quaterniond q_min(pose_min_time.linear());
-  Eigen::Quaterniond q1(q_max.conjugate() * q_min);
-  Eigen::Quaterniond q0(Eigen::Quaterniond::Identity());
-  q1.normalize();
-  translation = q_max.conjugate() * translation;
-
-  // int total = msg->width * msg->height;
-
-  double d = q0.dot(q1);
-  double abs_d = abs(d);
-  double f = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
-
-  // Threshold for a "significant" rotation from min_time to max_time:
-  // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an angle
-  // of 0.02 / 70 =
-  // 0.0003 rad. So, we consider a rotation "significant" only if the scalar
-  // part of quaternion is
-  // less than cos(0.0003 / 2) = 1 - 1e-8.
-  if (abs_d < 1.0 - 1.0e-8) {
-    double theta = acos(abs_d);
-    double sin_theta = sin(theta);
-    double c1_sign = (d > 0) ? 1 : -1;
-    for (const auto& point : msg->point()) {
-      float x_scalar = point.x();
-      if (std::isnan(x_scalar)) {
-        // if (config_.organized()) {
-        auto* point_new = msg_compensated->add_point();
-        point_new->CopyFrom(point);
-        // } else {
-        //   AERROR << "nan point do not need motion compensation";
-        // }
-        continue;
+bool Compensator::ApplyCompensation(const PointCloud& msg,
+                                    PointCloud* msg_compensated) {
+  const int size = msg.point_size();
+  x_.resize(size);
+  y_.resize(size);
+  z_.resize(size);
+  timestamp_.resize(size);
+  for (int i = 0; i < size; ++i) {
+    const auto& point = msg.point(i);
+    x_[i] = point.x();
+    y_[i] = point.y();
+    z_[i] = point.z();
+    timestamp_[i] = point.timestamp();
+  }
+  kernel_.Apply(size, x_.data(), y_.data(), z_.data(), timestamp_.data(),
+                x_.data(), y_.data(), z_.data());
+
+  for (int i = 0; i < size; ++i) {
+    const auto& point = msg.point(i);
+    if (std::isnan(point.x())) {
+      // nan points are kept as they are if the sweep rotated, and dropped
+      // if it only translated
+      if (kernel_.has_rotation()) {
+        msg_compensated->add_point()->CopyFrom(point);
       }
-      float y_scalar = point.y();
-      float z_scalar = point.z();
-      Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-      uint64_t tp = point.timestamp();
-      double t = static_cast<double>(timestamp_max - tp) * f;
-
-      Eigen::Translation3d ti(t * translation);
-
-      double c0 = sin((1 - t) * theta) / sin_theta;
-      double c1 = sin(t * theta) / sin_theta * c1_sign;
-      Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
-
-      Eigen::Affine3d trans = ti * qi;
-      p = trans * p;
+      continue;
+    }
+    common::util::AddPoint(x_[i], y_[i], z_[i], point.intensity(),
+                           point.timestamp(), msg_compensated);
+  }
+  return true;
+}
 
-      auto* point_new = msg_compensated->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(point.timestamp());
-      point_new->set_x(static_cast<float>(p.x()));
-      point_new->set_y(static_cast<float>(p.y()));
-      point_new->set_z(static_cast<float>(p.z()));
+bool Compensator::ApplyCompensation(const PackedPointCloud& msg,
+                                    PackedPointCloud* msg_compensated) {
+  if (!common::util::HasConsistentColumns(msg)) {
+    AERROR << "PointCloud columns differ in size";
+    return false;
+  }
+  const int size = msg.x_size();
+  msg_compensated->mutable_x()->Resize(size, 0.0f);
+  msg_compensated->mutable_y()->Resize(size, 0.0f);
+  msg_compensated->mutable_z()->Resize(size, 0.0f);
+  *msg_compensated->mutable_intensity() = msg.intensity();
+  *msg_compensated->mutable_timestamp() = msg.timestamp();
+  const float* x = msg.x().data();
+  const float* y = msg.y().data();
+  const float* z = msg.z().data();
+  float* out_x = msg_compensated->mutable_x()->mutable_data();
+  float* out_y = msg_compensated->mutable_y()->mutable_data();
+  float* out_z = msg_compensated->mutable_z()->mutable_data();
+  kernel_.Apply(size, x, y, z, msg.timestamp().data(), out_x, out_y, out_z);
+
+  // same nan handling as for PointCloud
+  if (kernel_.has_rotation()) {
+    for (int i = 0; i < size; ++i) {
+      if (std::isnan(x[i])) {
+        out_x[i] = x[i];
+        out_y[i] = y[i];
+        out_z[i] = z[i];
+      }
     }
-    return;
+    return true;
   }
-  // Not a "significant" rotation. Do translation only.
-  for (auto& point : msg->point()) {
-    float x_scalar = point.x();
-    if (std::isnan(x_scalar)) {
-      // AERROR << "nan point do not need motion compensation";
+  uint32_t* intensity = msg_compensated->mutable_intensity()->mutable_data();
+  uint64_t* timestamp = msg_compensated->mutable_timestamp()->mutable_data();
+  int kept = 0;
+  for (int i = 0; i < size; ++i) {
+    if (std::isnan(x[i])) {
       continue;
     }
-    float y_scalar = point.y();
-    float z_scalar = point.z();
-    Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-    uint64_t tp = point.timestamp();
-    double t = static_cast<double>(timestamp_max - tp) * f;
-    Eigen::Translation3d ti(t * translation);
-
-    p = ti * p;
-
-    auto* point_new = msg_compensated->add_point();
-    point_new->set_intensity(point.intensity());
-    point_new->set_timestamp(point.timestamp());
-    point_new->set_x(static_cast<float>(p.x()));
-    point_new->set_y(static_cast<float>(p.y()));
-    point_new->set_z(static_cast<float>(p.z()));
+    out_x[kept] = out_x[i];
+    out_y[kept] = out_y[i];
+    out_z[kept] = out_z[i];
+    intensity[kept] = intensity[i];
+    timestamp[kept] = timestamp[i];
+    ++kept;
   }
+  msg_compensated->mutable_x()->Truncate(kept);
+  msg_compensated->mutable_y()->Truncate(kept);
+  msg_compensated->mutable_z()->Truncate(kept);
+  msg_compensated->mutable_intensity()->Truncate(kept);
+  msg_compensated->mutable_timestamp()->Truncate(kept);
+  return true;
 }
 
 }  // namespace velodyne
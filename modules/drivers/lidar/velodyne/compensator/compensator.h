@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Eigen/Eigen"
 
@@ -30,12 +31,14 @@
 #include "modules/drivers/lidar/proto/velodyne_config.pb.h"
 #include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
 
+#include "modules/drivers/lidar/velodyne/compensator/motion_compensation_kernel.h"
 #include "modules/transform/buffer.h"
 
 namespace apollo {
 namespace drivers {
 namespace velodyne {
 
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 
 class Compensator {
@@ -46,7 +49,13 @@ class Compensator {
   bool MotionCompensation(const std::shared_ptr<const PointCloud>& msg,
                           std::shared_ptr<PointCloud> msg_compensated);
 
+  bool MotionCompensation(const std::shared_ptr<const PackedPointCloud>& msg,
+                          std::shared_ptr<PackedPointCloud> msg_compensated);
+
  private:
+  template <typename CloudT>
+  bool Compensate(const CloudT& msg, CloudT* msg_compensated);
+
   /**
    * @brief get pose affine from tf2 by gps timestamp
    *   novatel-preprocess broadcast the tf2 transfrom.
@@ -55,25 +64,30 @@ class Compensator {
                               const std::string& child_frame_id);
 
   /**
-   * @brief motion compensation for point cloud
+   * @brief motion compensation for point cloud with the transforms
+   * sampled into kernel_
    */
-  void MotionCompensation(const std::shared_ptr<const PointCloud>& msg,
-                          std::shared_ptr<PointCloud> msg_compensated,
-                          const uint64_t timestamp_min,
-                          const uint64_t timestamp_max,
-                          const Eigen::Affine3d& pose_min_time,
-                          const Eigen::Affine3d& pose_max_time);
+  bool ApplyCompensation(const PointCloud& msg, PointCloud* msg_compensated);
+  bool ApplyCompensation(const PackedPointCloud& msg,
+                         PackedPointCloud* msg_compensated);
   /**
-   * @brief get min timestamp and max timestamp from points in pointcloud2
+   * @brief get min timestamp and max timestamp from points in pointcloud2,
+   * false if the columns of a packed cloud differ in size
    */
-  inline void GetTimestampInterval(const std::shared_ptr<const PointCloud>& msg,
-                                   uint64_t* timestamp_min,
-                                   uint64_t* timestamp_max);
+  template <typename CloudT>
+  bool GetTimestampInterval(const CloudT& msg, uint64_t* timestamp_min,
+                            uint64_t* timestamp_max);
 
   bool IsValid(const Eigen::Vector3d& point);
 
   transform::Buffer* tf2_buffer_ptr_ = transform::Buffer::Instance();
   CompensatorConfig config_;
+  MotionCompensationKernel kernel_;
+  // columns of a PointCloud being compensated
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<uint64_t> timestamp_;
 };
 
 }  // namespace velodyne
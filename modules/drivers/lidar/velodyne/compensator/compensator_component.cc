@@ -21,6 +21,7 @@
 
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/common/util/point_cloud_packing.h"
 #include "modules/drivers/lidar/proto/velodyne.pb.h"
 
 using apollo::cyber::Time;
@@ -29,16 +30,17 @@ namespace apollo {
 namespace drivers {
 namespace velodyne {
 
-bool CompensatorComponent::Init() {
+template <typename CloudT>
+bool CompensatorComponentBase<CloudT>::Init() {
   CompensatorConfig config;
-  if (!GetProtoConfig(&config)) {
-    AWARN << "Load config failed, config file" << ConfigFilePath();
+  if (!this->GetProtoConfig(&config)) {
+    AWARN << "Load config failed, config file" << this->ConfigFilePath();
     return false;
   }
 
-  writer_ = node_->CreateWriter<PointCloud>(config.output_channel());
+  writer_ = this->node_->template CreateWriter<CloudT>(config.output_channel());
   compensator_.reset(new Compensator(config));
-  compensator_pool_.reset(new CCObjectPool<PointCloud>(pool_size_));
+  compensator_pool_.reset(new CCObjectPool<CloudT>(pool_size_));
   compensator_pool_->ConstructAll();
   for (int i = 0; i < pool_size_; ++i) {
     auto point_cloud = compensator_pool_->GetObject();
@@ -46,20 +48,21 @@ bool CompensatorComponent::Init() {
       AERROR << "fail to getobject:" << i;
       return false;
     }
-    point_cloud->mutable_point()->Reserve(140000);
+    common::util::ReservePointCloud(140000, point_cloud.get());
   }
   return true;
 }
 
-bool CompensatorComponent::Proc(
-    const std::shared_ptr<PointCloud>& point_cloud) {
+template <typename CloudT>
+bool CompensatorComponentBase<CloudT>::Proc(
+    const std::shared_ptr<CloudT>& point_cloud) {
   const auto start_time = Time::Now();
-  std::shared_ptr<PointCloud> point_cloud_compensated =
+  std::shared_ptr<CloudT> point_cloud_compensated =
       compensator_pool_->GetObject();
   if (point_cloud_compensated == nullptr) {
     AWARN << "compensator fail to getobject, will be new";
-    point_cloud_compensated = std::make_shared<PointCloud>();
-    point_cloud_compensated->mutable_point()->Reserve(140000);
+    point_cloud_compensated = std::make_shared<CloudT>();
+    common::util::ReservePointCloud(140000, point_cloud_compensated.get());
   }
   if (point_cloud_compensated == nullptr) {
     AWARN << "compensator point_cloud is nullptr";
@@ -88,6 +91,9 @@ bool CompensatorComponent::Proc(
   return true;
 }
 
+template class CompensatorComponentBase<PointCloud>;
+template class CompensatorComponentBase<PackedPointCloud>;
+
 }  // namespace velodyne
 }  // namespace drivers
 }  // namespace apollo
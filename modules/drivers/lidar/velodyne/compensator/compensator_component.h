@@ -32,22 +32,34 @@ using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
 using apollo::cyber::base::CCObjectPool;
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 
-class CompensatorComponent : public Component<PointCloud> {
+/**
+ * @brief Motion compensation of CloudT, either PointCloud or
+ * PackedPointCloud, read from and written to channels of that type.
+ */
+template <typename CloudT>
+class CompensatorComponentBase : public Component<CloudT> {
  public:
   bool Init() override;
-  bool Proc(const std::shared_ptr<PointCloud>& point_cloud) override;
+  bool Proc(const std::shared_ptr<CloudT>& point_cloud) override;
 
  private:
   std::unique_ptr<Compensator> compensator_ = nullptr;
   int pool_size_ = 8;
   int seq_ = 0;
-  std::shared_ptr<Writer<PointCloud>> writer_ = nullptr;
-  std::shared_ptr<CCObjectPool<PointCloud>> compensator_pool_ = nullptr;
+  std::shared_ptr<Writer<CloudT>> writer_ = nullptr;
+  std::shared_ptr<CCObjectPool<CloudT>> compensator_pool_ = nullptr;
 };
 
+class CompensatorComponent : public CompensatorComponentBase<PointCloud> {};
+
+class PackedCompensatorComponent
+    : public CompensatorComponentBase<PackedPointCloud> {};
+
 CYBER_REGISTER_COMPONENT(CompensatorComponent)
+CYBER_REGISTER_COMPONENT(PackedCompensatorComponent)
 }  // namespace velodyne
 }  // namespace drivers
 }  // namespace apollo
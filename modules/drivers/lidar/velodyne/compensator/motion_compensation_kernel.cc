@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar/velodyne/compensator/motion_compensation_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define VELODYNE_COMPENSATOR_X86_DISPATCH
+#endif
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+namespace {
+
+using BinTransform = MotionCompensationKernel::BinTransform;
+
+void TransformRunScalar(const BinTransform& bin, int size,
+                        const float* fraction, const float* x, const float* y,
+                        const float* z, float* out_x, float* out_y,
+                        float* out_z) {
+  for (int i = 0; i < size; ++i) {
+    const float f = fraction[i];
+    float m[12];
+    for (int j = 0; j < 12; ++j) {
+      m[j] = bin.base[j] + f * bin.delta[j];
+    }
+    const float px = x[i];
+    const float py = y[i];
+    const float pz = z[i];
+    out_x[i] = m[0] * px + m[1] * py + m[2] * pz + m[3];
+    out_y[i] = m[4] * px + m[5] * py + m[6] * pz + m[7];
+    out_z[i] = m[8] * px + m[9] * py + m[10] * pz + m[11];
+  }
+}
+
+#ifdef VELODYNE_COMPENSATOR_X86_DISPATCH
+__attribute__((target("avx2,fma"))) void TransformRunAvx2(
+    const BinTransform& bin, int size, const float* fraction, const float* x,
+    const float* y, const float* z, float* out_x, float* out_y,
+    float* out_z) {
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m256 f = _mm256_loadu_ps(fraction + i);
+    const __m256 px = _mm256_loadu_ps(x + i);
+    const __m256 py = _mm256_loadu_ps(y + i);
+    const __m256 pz = _mm256_loadu_ps(z + i);
+    __m256 row[3];
+    for (int r = 0; r < 3; ++r) {
+      const float* base = bin.base + 4 * r;
+      const float* delta = bin.delta + 4 * r;
+      const __m256 m0 = _mm256_fmadd_ps(f, _mm256_set1_ps(delta[0]),
+                                        _mm256_set1_ps(base[0]));
+      const __m256 m1 = _mm256_fmadd_ps(f, _mm256_set1_ps(delta[1]),
+                                        _mm256_set1_ps(base[1]));
+      const __m256 m2 = _mm256_fmadd_ps(f, _mm256_set1_ps(delta[2]),
+                                        _mm256_set1_ps(base[2]));
+      const __m256 m3 = _mm256_fmadd_ps(f, _mm256_set1_ps(delta[3]),
+                                        _mm256_set1_ps(base[3]));
+      row[r] = _mm256_fmadd_ps(
+          m0, px, _mm256_fmadd_ps(m1, py, _mm256_fmadd_ps(m2, pz, m3)));
+    }
+    _mm256_storeu_ps(out_x + i, row[0]);
+    _mm256_storeu_ps(out_y + i, row[1]);
+    _mm256_storeu_ps(out_z + i, row[2]);
+  }
+  // the tail and the callers are SSE code, which stalls on dirty upper
+  // halves of the ymm registers
+  _mm256_zeroupper();
+  TransformRunScalar(bin, size - i, fraction + i, x + i, y + i, z + i,
+                     out_x + i, out_y + i, out_z + i);
+}
+
+bool HasAvx2() {
+  static const bool has_avx2 =
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return has_avx2;
+}
+#endif
+
+void TransformRun(const BinTransform& bin, int size, const float* fraction,
+                  const float* x, const float* y, const float* z, float* out_x,
+                  float* out_y, float* out_z) {
+#ifdef VELODYNE_COMPENSATOR_X86_DISPATCH
+  if (HasAvx2()) {
+    TransformRunAvx2(bin, size, fraction, x, y, z, out_x, out_y, out_z);
+    return;
+  }
+#endif
+  TransformRunScalar(bin, size, fraction, x, y, z, out_x, out_y, out_z);
+}
+
+}  // namespace
+
+void MotionCompensationKernel::Init(uint64_t timestamp_min,
+                                    uint64_t timestamp_max,
+                                    const Eigen::Affine3d& pose_min_time,
+                                    const Eigen::Affine3d& pose_max_time) {
+  using std::abs;
+  using std::acos;
+  using std::sin;
+
+  // same interpolation as the per point compensation: t runs from 0 at
+  // timestamp_max to 1 at timestamp_min
+  Eigen::Vector3d translation =
+      pose_min_time.translation() - pose_max_time.translation();
+  Eigen::Quaterniond q_max(pose_max_time.linear());
+  Eigen::Quaterniond q_min(pose_min_time.linear());
+  Eigen::Quaterniond q1(q_max.conjugate() * q_min);
+  Eigen::Quaterniond q0(Eigen::Quaterniond::Identity());
+  q1.normalize();
+  translation = q_max.conjugate() * translation;
+
+  double d = q0.dot(q1);
+  double abs_d = abs(d);
+  // Threshold for a "significant" rotation from min_time to max_time:
+  // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an angle
+  // of 0.02 / 70 = 0.0003 rad. So, we consider a rotation "significant" only
+  // if the scalar part of quaternion is less than cos(0.0003 / 2) = 1 - 1e-8.
+  has_rotation_ = abs_d < 1.0 - 1.0e-8;
+  double theta = has_rotation_ ? acos(abs_d) : 0.0;
+  double sin_theta = sin(theta);
+  double c1_sign = (d > 0) ? 1 : -1;
+
+  timestamp_max_ = timestamp_max;
+  bin_scale_ = timestamp_max > timestamp_min
+                   ? kBinNum / static_cast<double>(timestamp_max -
+                                                   timestamp_min)
+                   : 0.0;
+
+  Eigen::Matrix<double, 3, 4> previous;
+  for (int k = 0; k <= kBinNum; ++k) {
+    double t = static_cast<double>(k) / kBinNum;
+    Eigen::Matrix<double, 3, 4> current;
+    if (has_rotation_) {
+      double c0 = sin((1 - t) * theta) / sin_theta;
+      double c1 = sin(t * theta) / sin_theta * c1_sign;
+      Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
+      current.leftCols<3>() = qi.toRotationMatrix();
+    } else {
+      current.leftCols<3>().setIdentity();
+    }
+    current.col(3) = t * translation;
+
+    if (k > 0) {
+      BinTransform& bin = bins_[k - 1];
+      for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 4; ++c) {
+          bin.base[4 * r + c] = static_cast<float>(previous(r, c));
+          bin.delta[4 * r + c] =
+              static_cast<float>(current(r, c) - previous(r, c));
+        }
+      }
+    }
+    previous = current;
+  }
+}
+
+void MotionCompensationKernel::Apply(int size, const float* x, const float* y,
+                                     const float* z,
+                                     const uint64_t* timestamp, float* out_x,
+                                     float* out_y, float* out_z) {
+  if (static_cast<int>(fraction_.size()) < size) {
+    fraction_.resize(size);
+  }
+  float* fraction = fraction_.data();
+
+  int begin = 0;
+  while (begin < size) {
+    // the run extends while the points stay in the bin of its first point
+    const double u0 =
+        static_cast<double>(timestamp_max_ - timestamp[begin]) * bin_scale_;
+    const int bin = std::min(static_cast<int>(u0), kBinNum - 1);
+    int end = begin;
+    for (; end < size; ++end) {
+      const double u =
+          static_cast<double>(timestamp_max_ - timestamp[end]) * bin_scale_;
+      if (std::min(static_cast<int>(u), kBinNum - 1) != bin) {
+        break;
+      }
+      fraction[end] = static_cast<float>(u - bin);
+    }
+    TransformRun(bins_[bin], end - begin, fraction + begin, x + begin,
+                 y + begin, z + begin, out_x + begin, out_y + begin,
+                 out_z + begin);
+    begin = end;
+  }
+}
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
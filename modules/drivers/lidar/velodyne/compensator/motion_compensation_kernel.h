@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Eigen/Eigen"
+
+// Eigen 3.3.7: #define ALIVE (0)
+// fastrtps: enum ChangeKind_t { ALIVE, ... };
+#if defined(ALIVE)
+#undef ALIVE
+#endif
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+/**
+ * @class MotionCompensationKernel
+ * @brief Motion compensation of a whole sweep over x/y/z/timestamp columns.
+ *
+ * Init samples the interpolated pose of the sweep at kBinNum + 1 evenly
+ * spaced times. A point then takes the transform of its time bin,
+ * interpolated linearly to its own timestamp, which costs a few
+ * multiply-adds instead of a slerp and a quaternion to matrix conversion.
+ * Consecutive points of a sweep mostly fall into the same bin, so Apply
+ * transforms runs of them with the bin transform broadcast over the lanes.
+ *
+ * The linear interpolation deviates from the slerp by less than
+ * (rotation of the sweep / kBinNum)^2 / 8 times the point range, which is
+ * below a micrometer for any realistic sweep.
+ */
+class MotionCompensationKernel {
+ public:
+  static constexpr int kBinNum = 256;
+
+  /**
+   * @brief Sample the transforms that bring a point measured between
+   * timestamp_min and timestamp_max into the lidar frame at timestamp_max.
+   */
+  void Init(uint64_t timestamp_min, uint64_t timestamp_max,
+            const Eigen::Affine3d& pose_min_time,
+            const Eigen::Affine3d& pose_max_time);
+
+  /**
+   * @brief Transform `size` points. The outputs may alias the inputs.
+   * Every timestamp must lie within the interval given to Init.
+   */
+  void Apply(int size, const float* x, const float* y, const float* z,
+             const uint64_t* timestamp, float* out_x, float* out_y,
+             float* out_z);
+
+  /**
+   * @brief Whether the sweep rotated enough for the rotation to be
+   * interpolated. Otherwise only the translation is applied.
+   */
+  bool has_rotation() const { return has_rotation_; }
+
+  /**
+   * @brief Row major 3x4 transform at the start of a bin, and its change
+   * until the end of the bin.
+   */
+  struct BinTransform {
+    float base[12];
+    float delta[12];
+  };
+
+ private:
+  BinTransform bins_[kBinNum];
+  uint64_t timestamp_max_ = 0;
+  // bins per nanosecond
+  double bin_scale_ = 0.0;
+  bool has_rotation_ = false;
+  // position of each point within its bin, in [0, 1]
+  std::vector<float> fraction_;
+};
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,237 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar/velodyne/compensator/motion_compensation_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+namespace {
+
+constexpr uint64_t kSweepStart = 1700000000000000000ULL;
+// 10 Hz sweep
+constexpr uint64_t kSweepNs = 100000000;
+
+struct Columns {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<uint64_t> timestamp;
+
+  int size() const { return static_cast<int>(x.size()); }
+};
+
+// 128 beams firing together every 55us, in firing order when `organized`
+// is false and ring by ring when it is true
+Columns MakeSweep(int firing_num, bool organized) {
+  constexpr int kBeamNum = 128;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> range(1.0f, 120.0f);
+  std::uniform_real_distribution<float> pitch(-0.4f, 0.2f);
+  Columns sweep;
+  for (int n = 0; n < firing_num * kBeamNum; ++n) {
+    int firing = organized ? n % firing_num : n / kBeamNum;
+    float azimuth = static_cast<float>(2.0 * M_PI * firing / firing_num);
+    float r = range(rng);
+    float p = pitch(rng);
+    sweep.x.push_back(r * std::cos(p) * std::cos(azimuth));
+    sweep.y.push_back(r * std::cos(p) * std::sin(azimuth));
+    sweep.z.push_back(r * std::sin(p));
+    sweep.timestamp.push_back(kSweepStart + kSweepNs * firing / firing_num);
+  }
+  return sweep;
+}
+
+Eigen::Affine3d Pose(double yaw, double x, double y) {
+  return Eigen::Translation3d(x, y, 0.3) *
+         Eigen::Quaterniond(Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()));
+}
+
+// the per point compensation the kernel replaces
+void ReferenceCompensation(const Columns& in, uint64_t timestamp_min,
+                           uint64_t timestamp_max,
+                           const Eigen::Affine3d& pose_min_time,
+                           const Eigen::Affine3d& pose_max_time,
+                           Columns* out) {
+  Eigen::Vector3d translation =
+      pose_min_time.translation() - pose_max_time.translation();
+  Eigen::Quaterniond q_max(pose_max_time.linear());
+  Eigen::Quaterniond q_min(pose_min_time.linear());
+  Eigen::Quaterniond q1(q_max.conjugate() * q_min);
+  Eigen::Quaterniond q0(Eigen::Quaterniond::Identity());
+  q1.normalize();
+  translation = q_max.conjugate() * translation;
+  double d = q0.dot(q1);
+  double abs_d = std::abs(d);
+  double f = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
+  double theta = std::acos(abs_d);
+  double sin_theta = std::sin(theta);
+  double c1_sign = (d > 0) ? 1 : -1;
+  *out = in;
+  for (int i = 0; i < in.size(); ++i) {
+    Eigen::Vector3d p(in.x[i], in.y[i], in.z[i]);
+    double t = static_cast<double>(timestamp_max - in.timestamp[i]) * f;
+    Eigen::Translation3d ti(t * translation);
+    double c0 = std::sin((1 - t) * theta) / sin_theta;
+    double c1 = std::sin(t * theta) / sin_theta * c1_sign;
+    Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
+    Eigen::Affine3d trans = ti * qi;
+    p = trans * p;
+    out->x[i] = static_cast<float>(p.x());
+    out->y[i] = static_cast<float>(p.y());
+    out->z[i] = static_cast<float>(p.z());
+  }
+}
+
+float MaxError(const Columns& a, const Columns& b) {
+  float error = 0.0f;
+  for (int i = 0; i < a.size(); ++i) {
+    error = std::max(error, std::abs(a.x[i] - b.x[i]));
+    error = std::max(error, std::abs(a.y[i] - b.y[i]));
+    error = std::max(error, std::abs(a.z[i] - b.z[i]));
+  }
+  return error;
+}
+
+void RunKernel(const Columns& in, MotionCompensationKernel* kernel,
+               Columns* out) {
+  *out = in;
+  kernel->Apply(in.size(), in.x.data(), in.y.data(), in.z.data(),
+                in.timestamp.data(), out->x.data(), out->y.data(),
+                out->z.data());
+}
+
+}  // namespace
+
+TEST(MotionCompensationKernelTest, MatchesPerPointCompensation) {
+  const uint64_t timestamp_min = kSweepStart;
+  const uint64_t timestamp_max = kSweepStart + kSweepNs;
+  // 15 m/s while yawing at 0.5 rad/s
+  const auto pose_min = Pose(0.30, 100.0, 20.0);
+  const auto pose_max = Pose(0.35, 101.5, 20.2);
+  for (bool organized : {false, true}) {
+    Columns sweep = MakeSweep(1800, organized);
+    MotionCompensationKernel kernel;
+    kernel.Init(timestamp_min, timestamp_max, pose_min, pose_max);
+    EXPECT_TRUE(kernel.has_rotation());
+
+    Columns expected;
+    ReferenceCompensation(sweep, timestamp_min, timestamp_max, pose_min,
+                          pose_max, &expected);
+    Columns actual;
+    RunKernel(sweep, &kernel, &actual);
+    EXPECT_LT(MaxError(expected, actual), 1e-4f);
+
+    // in place
+    kernel.Apply(sweep.size(), sweep.x.data(), sweep.y.data(), sweep.z.data(),
+                 sweep.timestamp.data(), sweep.x.data(), sweep.y.data(),
+                 sweep.z.data());
+    EXPECT_EQ(0.0f, MaxError(actual, sweep));
+  }
+}
+
+TEST(MotionCompensationKernelTest, TranslationOnly) {
+  const uint64_t timestamp_min = kSweepStart;
+  const uint64_t timestamp_max = kSweepStart + kSweepNs;
+  MotionCompensationKernel kernel;
+  kernel.Init(timestamp_min, timestamp_max, Pose(0.3, 10.0, 0.0),
+              Pose(0.3, 11.0, 0.0));
+  EXPECT_FALSE(kernel.has_rotation());
+
+  Columns sweep;
+  sweep.x = {1.0f, 1.0f, 1.0f};
+  sweep.y = {2.0f, 2.0f, 2.0f};
+  sweep.z = {3.0f, 3.0f, 3.0f};
+  sweep.timestamp = {timestamp_min, timestamp_min + kSweepNs / 2,
+                     timestamp_max};
+  Columns out;
+  RunKernel(sweep, &kernel, &out);
+  // the vehicle moved 1 m along world x, seen from its heading of 0.3 rad
+  EXPECT_NEAR(1.0 - std::cos(0.3), out.x[0], 1e-5);
+  EXPECT_NEAR(2.0 + std::sin(0.3), out.y[0], 1e-5);
+  EXPECT_NEAR(1.0 - 0.5 * std::cos(0.3), out.x[1], 1e-5);
+  EXPECT_NEAR(2.0 + 0.5 * std::sin(0.3), out.y[1], 1e-5);
+  EXPECT_FLOAT_EQ(1.0f, out.x[2]);
+  EXPECT_FLOAT_EQ(2.0f, out.y[2]);
+  EXPECT_FLOAT_EQ(3.0f, out.z[2]);
+}
+
+TEST(MotionCompensationKernelTest, SingleTimestamp) {
+  MotionCompensationKernel kernel;
+  kernel.Init(kSweepStart, kSweepStart, Pose(0.3, 10.0, 0.0),
+              Pose(0.4, 11.0, 0.0));
+  Columns sweep;
+  sweep.x = {1.0f};
+  sweep.y = {2.0f};
+  sweep.z = {3.0f};
+  sweep.timestamp = {kSweepStart};
+  Columns out;
+  RunKernel(sweep, &kernel, &out);
+  EXPECT_FLOAT_EQ(1.0f, out.x[0]);
+  EXPECT_FLOAT_EQ(2.0f, out.y[0]);
+  EXPECT_FLOAT_EQ(3.0f, out.z[0]);
+}
+
+TEST(MotionCompensationKernelTest, Benchmark) {
+  constexpr int kRounds = 5;
+  const uint64_t timestamp_min = kSweepStart;
+  const uint64_t timestamp_max = kSweepStart + kSweepNs;
+  const auto pose_min = Pose(0.30, 100.0, 20.0);
+  const auto pose_max = Pose(0.35, 101.5, 20.2);
+  for (bool organized : {false, true}) {
+    // about 240k points
+    Columns sweep = MakeSweep(1875, organized);
+    Columns out;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+      ReferenceCompensation(sweep, timestamp_min, timestamp_max, pose_min,
+                            pose_max, &out);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    MotionCompensationKernel kernel;
+    for (int i = 0; i < kRounds; ++i) {
+      kernel.Init(timestamp_min, timestamp_max, pose_min, pose_max);
+      RunKernel(sweep, &kernel, &out);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << sweep.size() << (organized ? " organized" : " unorganized")
+              << " points, per point: "
+              << std::chrono::duration<double, std::milli>(middle - start)
+                         .count() /
+                     kRounds
+              << " ms, batched: "
+              << std::chrono::duration<double, std::milli>(end - middle)
+                         .count() /
+                     kRounds
+              << " ms" << std::endl;
+  }
+}
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
@@ -19,31 +19,59 @@
 #include <memory>
 #include <thread>
 
+#include "modules/common/util/point_cloud_packing.h"
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
 
 using apollo::cyber::Time;
 
-bool PriSecFusionComponent::Init() {
-  if (!GetProtoConfig(&conf_)) {
-    AWARN << "Load config failed, config file" << ConfigFilePath();
+namespace {
+
+template <typename Func>
+void UpdateTimestamps(Func func, PointCloud* point_cloud) {
+  for (auto& point : *point_cloud->mutable_point()) {
+    point.set_timestamp(func(point.timestamp()));
+  }
+}
+
+template <typename Func>
+void UpdateTimestamps(Func func, PackedPointCloud* point_cloud) {
+  for (auto& timestamp : *point_cloud->mutable_timestamp()) {
+    timestamp = func(timestamp);
+  }
+}
+
+}  // namespace
+
+template <typename CloudT>
+bool PriSecFusionComponentBase<CloudT>::Init() {
+  if (!this->GetProtoConfig(&conf_)) {
+    AWARN << "Load config failed, config file" << this->ConfigFilePath();
     return false;
   }
   buffer_ptr_ = apollo::transform::Buffer::Instance();
 
-  fusion_writer_ = node_->CreateWriter<PointCloud>(conf_.fusion_channel());
+  fusion_writer_ =
+      this->node_->template CreateWriter<CloudT>(conf_.fusion_channel());
 
   for (const auto& channel : conf_.input_channel()) {
-    auto reader = node_->CreateReader<PointCloud>(channel);
+    auto reader = this->node_->template CreateReader<CloudT>(channel);
     readers_.emplace_back(reader);
   }
   return true;
 }
 
-bool PriSecFusionComponent::Proc(
-    const std::shared_ptr<PointCloud>& point_cloud) {
-  auto target = std::make_shared<PointCloud>(*point_cloud);
+template <typename CloudT>
+bool PriSecFusionComponentBase<CloudT>::Proc(
+    const std::shared_ptr<CloudT>& point_cloud) {
+  if (!common::util::HasConsistentColumns(*point_cloud)) {
+    AERROR << "Pointcloud columns differ in size, frame_id: "
+           << point_cloud->header().frame_id();
+    return false;
+  }
+  auto target = std::make_shared<CloudT>(*point_cloud);
   // set measure timestamp
   lidar_system_offset_ns_ = 0;
   if (conf_.has_use_system_clock() && conf_.use_system_clock()) {
@@ -55,12 +83,12 @@ bool PriSecFusionComponent::Proc(
   if (conf_.has_target_frame_id()
       && conf_.target_frame_id() != target->header().frame_id()) {
     target->mutable_header()->set_frame_id(conf_.target_frame_id());
-    target->clear_point();
+    common::util::ClearPoints(target.get());
     Fusion(target, point_cloud);
   } else if (lidar_system_offset_ns_ != 0) {
-    for (auto& point : *target->mutable_point()) {
-      point.set_timestamp(GetPointTimestamp(point.timestamp()));
-    }
+    UpdateTimestamps(
+        [this](uint64_t timestamp) { return GetPointTimestamp(timestamp); },
+        target.get());
   }
   auto fusion_readers = readers_;
   auto start_time = Time::Now().ToSecond();
@@ -90,16 +118,18 @@ bool PriSecFusionComponent::Proc(
   return true;
 }
 
-bool PriSecFusionComponent::IsExpired(
-    const std::shared_ptr<PointCloud>& target,
-    const std::shared_ptr<PointCloud>& source) {
+template <typename CloudT>
+bool PriSecFusionComponentBase<CloudT>::IsExpired(
+    const std::shared_ptr<CloudT>& target,
+    const std::shared_ptr<CloudT>& source) {
   auto diff = target->measurement_time() - source->measurement_time();
   return diff * 1000 > conf_.max_interval_ms();
 }
 
-bool PriSecFusionComponent::QueryPoseAffine(const std::string& target_frame_id,
-                                            const std::string& source_frame_id,
-                                            Eigen::Affine3d* pose) {
+template <typename CloudT>
+bool PriSecFusionComponentBase<CloudT>::QueryPoseAffine(
+    const std::string& target_frame_id, const std::string& source_frame_id,
+    Eigen::Affine3d* pose) {
   std::string err_string;
   if (!buffer_ptr_->canTransform(target_frame_id, source_frame_id,
                                  cyber::Time(0), 0.02f, &err_string)) {
@@ -127,59 +157,63 @@ bool PriSecFusionComponent::QueryPoseAffine(const std::string& target_frame_id,
   return true;
 }
 
-uint64_t PriSecFusionComponent::GetPointTimestamp(const uint64_t& timestamp) {
+template <typename CloudT>
+uint64_t PriSecFusionComponentBase<CloudT>::GetPointTimestamp(
+    const uint64_t& timestamp) {
   if (lidar_system_offset_ns_ == 0) {
     return timestamp;
   }
   return static_cast<uint64_t>(timestamp - lidar_system_offset_ns_);
 }
 
-void PriSecFusionComponent::AppendPointCloud(
-    std::shared_ptr<PointCloud> point_cloud,
-    const std::shared_ptr<PointCloud> point_cloud_add,
+template <typename CloudT>
+void PriSecFusionComponentBase<CloudT>::AppendPointCloud(
+    std::shared_ptr<CloudT> point_cloud,
+    const std::shared_ptr<CloudT> point_cloud_add,
     const Eigen::Affine3d& pose) {
+  const int size_add = common::util::PointCloudSize(*point_cloud_add);
+  common::util::ReservePointCloud(
+      common::util::PointCloudSize(*point_cloud) + size_add,
+      point_cloud.get());
   if (std::isnan(pose(0, 0))) {
-    for (auto& point : point_cloud_add->point()) {
-      PointXYZIT* point_new = point_cloud->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(GetPointTimestamp(point.timestamp()));
-      point_new->set_x(point.x());
-      point_new->set_y(point.y());
-      point_new->set_z(point.z());
+    for (int i = 0; i < size_add; ++i) {
+      auto point = common::util::GetPoint(*point_cloud_add, i);
+      point.timestamp = GetPointTimestamp(point.timestamp);
+      common::util::AddPoint(point, point_cloud.get());
     }
   } else {
-    for (auto& point : point_cloud_add->point()) {
-      if (std::isnan(point.x())) {
-        PointXYZIT* point_new = point_cloud->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(GetPointTimestamp(point.timestamp()));
-        point_new->set_x(point.x());
-        point_new->set_y(point.y());
-        point_new->set_z(point.z());
-      } else {
-        PointXYZIT* point_new = point_cloud->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(GetPointTimestamp(point.timestamp()));
-        Eigen::Matrix<float, 3, 1> pt(point.x(), point.y(), point.z());
-        point_new->set_x(static_cast<float>(
+    for (int i = 0; i < size_add; ++i) {
+      auto point = common::util::GetPoint(*point_cloud_add, i);
+      point.timestamp = GetPointTimestamp(point.timestamp);
+      if (!std::isnan(point.x)) {
+        Eigen::Matrix<float, 3, 1> pt(point.x, point.y, point.z);
+        point.x = static_cast<float>(
             pose(0, 0) * pt.coeffRef(0) + pose(0, 1) * pt.coeffRef(1) +
-            pose(0, 2) * pt.coeffRef(2) + pose(0, 3)));
-        point_new->set_y(static_cast<float>(
+            pose(0, 2) * pt.coeffRef(2) + pose(0, 3));
+        point.y = static_cast<float>(
             pose(1, 0) * pt.coeffRef(0) + pose(1, 1) * pt.coeffRef(1) +
-            pose(1, 2) * pt.coeffRef(2) + pose(1, 3)));
-        point_new->set_z(static_cast<float>(
+            pose(1, 2) * pt.coeffRef(2) + pose(1, 3));
+        point.z = static_cast<float>(
             pose(2, 0) * pt.coeffRef(0) + pose(2, 1) * pt.coeffRef(1) +
-            pose(2, 2) * pt.coeffRef(2) + pose(2, 3)));
+            pose(2, 2) * pt.coeffRef(2) + pose(2, 3));
       }
+      common::util::AddPoint(point, point_cloud.get());
     }
   }
 
-  int new_width = point_cloud->point_size() / point_cloud->height();
+  int new_width =
+      common::util::PointCloudSize(*point_cloud) / point_cloud->height();
   point_cloud->set_width(new_width);
 }
 
-bool PriSecFusionComponent::Fusion(std::shared_ptr<PointCloud> target,
-                                   const std::shared_ptr<PointCloud> source) {
+template <typename CloudT>
+bool PriSecFusionComponentBase<CloudT>::Fusion(
+    std::shared_ptr<CloudT> target, const std::shared_ptr<CloudT> source) {
+  if (!common::util::HasConsistentColumns(*source)) {
+    AERROR << "Pointcloud columns differ in size, frame_id: "
+           << source->header().frame_id();
+    return false;
+  }
   Eigen::Affine3d pose;
   if (QueryPoseAffine(target->header().frame_id(), source->header().frame_id(),
                       &pose)) {
@@ -189,6 +223,9 @@ bool PriSecFusionComponent::Fusion(std::shared_ptr<PointCloud> target,
   return false;
 }
 
+template class PriSecFusionComponentBase<PointCloud>;
+template class PriSecFusionComponentBase<PackedPointCloud>;
+
 }  // namespace velodyne
 }  // namespace drivers
 }  // namespace apollo
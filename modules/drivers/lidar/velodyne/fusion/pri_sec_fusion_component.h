@@ -41,23 +41,29 @@ namespace velodyne {
 using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 
-class PriSecFusionComponent : public Component<PointCloud> {
+/**
+ * @brief Fuses the clouds of the input channels into the frame of the
+ * primary one. CloudT is PointCloud or PackedPointCloud, on all channels.
+ */
+template <typename CloudT>
+class PriSecFusionComponentBase : public Component<CloudT> {
  public:
   bool Init() override;
-  bool Proc(const std::shared_ptr<PointCloud>& point_cloud) override;
+  bool Proc(const std::shared_ptr<CloudT>& point_cloud) override;
 
  private:
-  bool Fusion(std::shared_ptr<PointCloud> target,
-              const std::shared_ptr<PointCloud> source);
-  bool IsExpired(const std::shared_ptr<PointCloud>& target,
-                 const std::shared_ptr<PointCloud>& source);
+  bool Fusion(std::shared_ptr<CloudT> target,
+              const std::shared_ptr<CloudT> source);
+  bool IsExpired(const std::shared_ptr<CloudT>& target,
+                 const std::shared_ptr<CloudT>& source);
   bool QueryPoseAffine(const std::string& target_frame_id,
                        const std::string& source_frame_id,
                        Eigen::Affine3d* pose);
-  void AppendPointCloud(std::shared_ptr<PointCloud> point_cloud,
-                        const std::shared_ptr<PointCloud> point_cloud_add,
+  void AppendPointCloud(std::shared_ptr<CloudT> point_cloud,
+                        const std::shared_ptr<CloudT> point_cloud_add,
                         const Eigen::Affine3d& pose);
 
   /**
@@ -73,14 +79,20 @@ class PriSecFusionComponent : public Component<PointCloud> {
 
   FusionConfig conf_;
   apollo::transform::Buffer* buffer_ptr_ = nullptr;
-  std::shared_ptr<Writer<PointCloud>> fusion_writer_;
-  std::vector<std::shared_ptr<Reader<PointCloud>>> readers_;
+  std::shared_ptr<Writer<CloudT>> fusion_writer_;
+  std::vector<std::shared_ptr<Reader<CloudT>>> readers_;
 
   // lidar to system clock offset nanoseconds
   int64_t lidar_system_offset_ns_ = 0;
 };
 
+class PriSecFusionComponent : public PriSecFusionComponentBase<PointCloud> {};
+
+class PackedPriSecFusionComponent
+    : public PriSecFusionComponentBase<PackedPointCloud> {};
+
 CYBER_REGISTER_COMPONENT(PriSecFusionComponent)
+CYBER_REGISTER_COMPONENT(PackedPriSecFusionComponent)
 }  // namespace velodyne
 }  // namespace drivers
 }  // namespace apollo
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar/velodyne/fusion/pri_sec_fusion_component.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "cyber/init.h"
+#include "modules/common/util/point_cloud_packing.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+namespace {
+
+std::shared_ptr<PackedPointCloud> MakeCloud(int size) {
+  auto cloud = std::make_shared<PackedPointCloud>();
+  cloud->mutable_header()->set_frame_id("velodyne128");
+  cloud->set_width(size);
+  cloud->set_height(1);
+  for (int i = 0; i < size; ++i) {
+    common::util::AddPoint(static_cast<float>(i), 0.0f, 0.0f, 0,
+                           static_cast<uint64_t>(i), cloud.get());
+  }
+  return cloud;
+}
+
+}  // namespace
+
+TEST(PriSecFusionComponentTest, uneven_columns) {
+  cyber::Init("pri_sec_fusion_component_test");
+  // rejected before the cloud is copied or anything is published
+  PackedPriSecFusionComponent component;
+
+  auto cloud = MakeCloud(10);
+  cloud->add_x(10.0f);
+  EXPECT_FALSE(component.Proc(cloud));
+
+  cloud = MakeCloud(10);
+  cloud->mutable_intensity()->Truncate(5);
+  EXPECT_FALSE(component.Proc(cloud));
+
+  cloud = MakeCloud(10);
+  cloud->clear_timestamp();
+  EXPECT_FALSE(component.Proc(cloud));
+}
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
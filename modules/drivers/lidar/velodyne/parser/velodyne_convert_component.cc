@@ -35,8 +35,24 @@ bool VelodyneConvertComponent::Init() {
 
   conv_.reset(new Convert());
   conv_->init(velodyne_config);
-  writer_ =
-      node_->CreateWriter<PointCloud>(velodyne_config.convert_channel_name());
+  if (velodyne_config.packed_point_cloud()) {
+    packed_writer_ = node_->CreateWriter<PackedPointCloud>(
+        velodyne_config.convert_channel_name());
+    packed_point_cloud_pool_.reset(
+        new CCObjectPool<PackedPointCloud>(pool_size_));
+    packed_point_cloud_pool_->ConstructAll();
+    for (int i = 0; i < pool_size_; i++) {
+      auto packed = packed_point_cloud_pool_->GetObject();
+      if (packed == nullptr) {
+        AERROR << "fail to getobject, i: " << i;
+        return false;
+      }
+      common::util::ReservePointCloud(140000, packed.get());
+    }
+  } else {
+    writer_ = node_->CreateWriter<PointCloud>(
+        velodyne_config.convert_channel_name());
+  }
   point_cloud_pool_.reset(new CCObjectPool<PointCloud>(pool_size_));
   point_cloud_pool_->ConstructAll();
   for (int i = 0; i < pool_size_; i++) {
@@ -70,6 +86,16 @@ bool VelodyneConvertComponent::Proc(
     AWARN << "point_cloud_out convert is empty.";
     return false;
   }
+  if (packed_writer_ != nullptr) {
+    std::shared_ptr<PackedPointCloud> packed =
+        packed_point_cloud_pool_->GetObject();
+    if (packed == nullptr) {
+      packed = std::make_shared<PackedPointCloud>();
+    }
+    common::util::PackPointCloud(*point_cloud_out, packed.get());
+    packed_writer_->Write(packed);
+    return true;
+  }
   writer_->Write(point_cloud_out);
   return true;
 }
@@ -26,6 +26,7 @@
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/common/util/point_cloud_packing.h"
 #include "modules/drivers/lidar/velodyne/parser/convert.h"
 
 namespace apollo {
@@ -36,6 +37,7 @@ using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
 using apollo::cyber::base::CCObjectPool;
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 using apollo::drivers::velodyne::VelodyneScan;
 
@@ -48,6 +50,10 @@ class VelodyneConvertComponent : public Component<VelodyneScan> {
   std::shared_ptr<Writer<PointCloud>> writer_;
   std::unique_ptr<Convert> conv_ = nullptr;
   std::shared_ptr<CCObjectPool<PointCloud>> point_cloud_pool_ = nullptr;
+  // only used when the convert channel carries PackedPointCloud
+  std::shared_ptr<Writer<PackedPointCloud>> packed_writer_;
+  std::shared_ptr<CCObjectPool<PackedPointCloud>> packed_point_cloud_pool_ =
+      nullptr;
   int pool_size_ = 8;
 };
 
@@ -0,0 +1,302 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/perception/base/point.h"
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+// @brief Point cloud class keeping x, y, z and intensity in separate
+// contiguous columns, next to the attribute columns of AttributePointCloud.
+// Kernels that only read a few of the coordinates, like roi filtering on
+// x and y, load only those instead of whole 16 or 32 byte points.
+template <typename T>
+class ColumnarPointCloud {
+ public:
+  using PointType = Point<T>;
+  // @brief default constructor
+  ColumnarPointCloud() = default;
+  // @brief construct from a point cloud of the same point type
+  explicit ColumnarPointCloud(const AttributePointCloud<PointType>& cloud) {
+    CopyFrom(cloud);
+  }
+  // @brief destructor
+  virtual ~ColumnarPointCloud() = default;
+
+  // @brief accessor of point size
+  inline size_t size() const { return x_.size(); }
+  // @brief empty function wrapper of vector
+  inline bool empty() const { return x_.empty(); }
+  // @brief reserve function wrapper of vector
+  inline void reserve(const size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+    points_timestamp_.reserve(size);
+    points_height_.reserve(size);
+    points_beam_id_.reserve(size);
+    points_label_.reserve(size);
+  }
+  // @brief resize function wrapper of vector, with the defaults of
+  // AttributePointCloud for new attributes
+  inline void resize(const size_t size) {
+    x_.resize(size, 0);
+    y_.resize(size, 0);
+    z_.resize(size, 0);
+    intensity_.resize(size, 0);
+    points_timestamp_.resize(size, 0.0);
+    points_height_.resize(size, std::numeric_limits<float>::max());
+    points_beam_id_.resize(size, -1);
+    points_label_.resize(size, 0);
+  }
+  // @brief clear function wrapper of vector
+  inline void clear() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    intensity_.clear();
+    points_timestamp_.clear();
+    points_height_.clear();
+    points_beam_id_.clear();
+    points_label_.clear();
+  }
+  // @brief push_back function wrapper of vector
+  inline void push_back(const PointType& point, double timestamp = 0.0,
+                        float height = std::numeric_limits<float>::max(),
+                        int32_t beam_id = -1, uint8_t label = 0) {
+    x_.push_back(point.x);
+    y_.push_back(point.y);
+    z_.push_back(point.z);
+    intensity_.push_back(point.intensity);
+    points_timestamp_.push_back(timestamp);
+    points_height_.push_back(height);
+    points_beam_id_.push_back(beam_id);
+    points_label_.push_back(label);
+  }
+  // @brief accessor of point via 1d index, gathered from the columns
+  inline PointType at(size_t i) const {
+    PointType point;
+    point.x = x_[i];
+    point.y = y_[i];
+    point.z = z_[i];
+    point.intensity = intensity_[i];
+    return point;
+  }
+  inline PointType operator[](size_t i) const { return at(i); }
+  // @brief setter of point via 1d index, scattered to the columns
+  inline void set_point(size_t i, const PointType& point) {
+    x_[i] = point.x;
+    y_[i] = point.y;
+    z_[i] = point.z;
+    intensity_[i] = point.intensity;
+  }
+
+  // @brief coordinate columns
+  const T* x() const { return x_.data(); }
+  const T* y() const { return y_.data(); }
+  const T* z() const { return z_.data(); }
+  const T* intensity() const { return intensity_.data(); }
+  T* mutable_x() { return x_.data(); }
+  T* mutable_y() { return y_.data(); }
+  T* mutable_z() { return z_.data(); }
+  T* mutable_intensity() { return intensity_.data(); }
+
+  // @brief attribute columns, named as in AttributePointCloud
+  const std::vector<double>& points_timestamp() const {
+    return points_timestamp_;
+  }
+  double points_timestamp(size_t i) const { return points_timestamp_[i]; }
+  std::vector<double>* mutable_points_timestamp() { return &points_timestamp_; }
+
+  const std::vector<float>& points_height() const { return points_height_; }
+  float points_height(size_t i) const { return points_height_[i]; }
+  std::vector<float>* mutable_points_height() { return &points_height_; }
+
+  const std::vector<int32_t>& points_beam_id() const { return points_beam_id_; }
+  int32_t points_beam_id(size_t i) const { return points_beam_id_[i]; }
+  std::vector<int32_t>* mutable_points_beam_id() { return &points_beam_id_; }
+
+  const std::vector<uint8_t>& points_label() const { return points_label_; }
+  uint8_t points_label(size_t i) const { return points_label_[i]; }
+  std::vector<uint8_t>* mutable_points_label() { return &points_label_; }
+
+  // @brief cloud timestamp setter
+  void set_timestamp(const double timestamp) { timestamp_ = timestamp; }
+  // @brief cloud timestamp getter
+  double get_timestamp() const { return timestamp_; }
+  // @brief sensor to world pose setter
+  void set_sensor_to_world_pose(const Eigen::Affine3d& sensor_to_world_pose) {
+    sensor_to_world_pose_ = sensor_to_world_pose;
+  }
+  // @brief sensor to world pose getter
+  const Eigen::Affine3d& sensor_to_world_pose() const {
+    return sensor_to_world_pose_;
+  }
+
+  // @brief copy from a point cloud, replacing all points
+  void CopyFrom(const AttributePointCloud<PointType>& cloud) {
+    const size_t size = cloud.size();
+    resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      set_point(i, cloud[i]);
+    }
+    points_timestamp_ = cloud.points_timestamp();
+    points_height_ = cloud.points_height();
+    points_beam_id_ = cloud.points_beam_id();
+    points_label_ = cloud.points_label();
+    timestamp_ = cloud.get_timestamp();
+    sensor_to_world_pose_ = cloud.sensor_to_world_pose();
+  }
+  // @brief copy to a point cloud, replacing all its points
+  void CopyTo(AttributePointCloud<PointType>* cloud) const {
+    const size_t size = this->size();
+    cloud->resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      cloud->at(i) = at(i);
+    }
+    *cloud->mutable_points_timestamp() = points_timestamp_;
+    *cloud->mutable_points_height() = points_height_;
+    *cloud->mutable_points_beam_id() = points_beam_id_;
+    *cloud->mutable_points_label() = points_label_;
+    cloud->set_timestamp(timestamp_);
+    cloud->set_sensor_to_world_pose(sensor_to_world_pose_);
+  }
+
+  // @brief swap point cloud
+  inline void SwapPointCloud(ColumnarPointCloud<T>* rhs) {
+    x_.swap(rhs->x_);
+    y_.swap(rhs->y_);
+    z_.swap(rhs->z_);
+    intensity_.swap(rhs->intensity_);
+    points_timestamp_.swap(rhs->points_timestamp_);
+    points_height_.swap(rhs->points_height_);
+    points_beam_id_.swap(rhs->points_beam_id_);
+    points_label_.swap(rhs->points_label_);
+    std::swap(sensor_to_world_pose_, rhs->sensor_to_world_pose_);
+    std::swap(timestamp_, rhs->timestamp_);
+  }
+  // @brief check data member consistency
+  bool CheckConsistency() const {
+    const size_t size = x_.size();
+    return y_.size() == size && z_.size() == size &&
+           intensity_.size() == size && points_timestamp_.size() == size &&
+           points_height_.size() == size && points_beam_id_.size() == size &&
+           points_label_.size() == size;
+  }
+
+ protected:
+  std::vector<T> x_;
+  std::vector<T> y_;
+  std::vector<T> z_;
+  std::vector<T> intensity_;
+  std::vector<double> points_timestamp_;
+  std::vector<float> points_height_;
+  std::vector<int32_t> points_beam_id_;
+  std::vector<uint8_t> points_label_;
+
+  Eigen::Affine3d sensor_to_world_pose_ = Eigen::Affine3d::Identity();
+  double timestamp_ = 0.0;
+};
+
+// @brief Read only view of the coordinates of either point cloud layout,
+// without copying. Coordinate i of a column is at column[i * stride], which
+// is every point for a PointCloud and every element for a
+// ColumnarPointCloud, so kernels written against the view run on both.
+// The view is invalidated by anything that reallocates the cloud.
+template <typename T>
+class PointCloudView {
+ public:
+  using PointType = Point<T>;
+
+  explicit PointCloudView(const PointCloud<PointType>& cloud)
+      : size_(cloud.size()),
+        stride_(sizeof(PointType) / sizeof(T)),
+        x_(cloud.empty() ? nullptr : &cloud[0].x),
+        y_(cloud.empty() ? nullptr : &cloud[0].y),
+        z_(cloud.empty() ? nullptr : &cloud[0].z),
+        intensity_(cloud.empty() ? nullptr : &cloud[0].intensity) {}
+  explicit PointCloudView(const ColumnarPointCloud<T>& cloud)
+      : size_(cloud.size()),
+        stride_(1),
+        x_(cloud.x()),
+        y_(cloud.y()),
+        z_(cloud.z()),
+        intensity_(cloud.intensity()) {}
+
+  // @brief accessor of point size
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return size_ == 0; }
+  // @brief distance between consecutive coordinates of a column
+  inline size_t stride() const { return stride_; }
+  // @brief whether the columns are contiguous
+  inline bool IsColumnar() const { return stride_ == 1; }
+
+  inline T x(size_t i) const { return x_[i * stride_]; }
+  inline T y(size_t i) const { return y_[i * stride_]; }
+  inline T z(size_t i) const { return z_[i * stride_]; }
+  inline T intensity(size_t i) const { return intensity_[i * stride_]; }
+  // @brief accessor of point via 1d index, as PointCloud::operator[]
+  inline PointType operator[](size_t i) const {
+    PointType point;
+    point.x = x(i);
+    point.y = y(i);
+    point.z = z(i);
+    point.intensity = intensity(i);
+    return point;
+  }
+
+  // @brief first coordinate of each column
+  const T* x_data() const { return x_; }
+  const T* y_data() const { return y_; }
+  const T* z_data() const { return z_; }
+  const T* intensity_data() const { return intensity_; }
+
+ private:
+  size_t size_ = 0;
+  size_t stride_ = 1;
+  const T* x_ = nullptr;
+  const T* y_ = nullptr;
+  const T* z_ = nullptr;
+  const T* intensity_ = nullptr;
+};
+
+typedef ColumnarPointCloud<float> ColumnarPointFCloud;
+typedef ColumnarPointCloud<double> ColumnarPointDCloud;
+
+typedef std::shared_ptr<ColumnarPointFCloud> ColumnarPointFCloudPtr;
+typedef std::shared_ptr<const ColumnarPointFCloud> ColumnarPointFCloudConstPtr;
+
+typedef std::shared_ptr<ColumnarPointDCloud> ColumnarPointDCloudPtr;
+typedef std::shared_ptr<const ColumnarPointDCloud> ColumnarPointDCloudConstPtr;
+
+typedef PointCloudView<float> PointFCloudView;
+typedef PointCloudView<double> PointDCloudView;
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/base/columnar_point_cloud.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/base/point_cloud_util.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+// about one frame of a 128 beam lidar
+constexpr size_t kBenchmarkPointNum = 240000;
+
+void MockCloud(size_t size, PointFCloud* cloud) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> xy(-100.f, 100.f);
+  std::uniform_real_distribution<float> z(-2.f, 4.f);
+  cloud->clear();
+  cloud->reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    PointF point;
+    point.x = xy(rng);
+    point.y = xy(rng);
+    point.z = z(rng);
+    point.intensity = static_cast<float>(i % 256);
+    cloud->push_back(point, 1e-6 * static_cast<double>(i),
+                     static_cast<float>(i % 7),
+                     static_cast<int32_t>(i % 128),
+                     static_cast<uint8_t>(i % 3));
+  }
+  cloud->set_timestamp(1.5);
+}
+
+// Grid of 0.25 m cells over 200 m x 200 m, the layout of the roi bitmap
+class GridRoi {
+ public:
+  GridRoi() : cells_(kDim * kDim, 0) {
+    // a cross of two 30 m wide roads
+    for (size_t r = 0; r < kDim; ++r) {
+      for (size_t c = 0; c < kDim; ++c) {
+        cells_[r * kDim + c] = (r > 340 && r < 460) || (c > 340 && c < 460);
+      }
+    }
+  }
+
+  bool Check(float x, float y) const {
+    const int c = static_cast<int>((x + 100.f) * 4.f);
+    const int r = static_cast<int>((y + 100.f) * 4.f);
+    if (c < 0 || r < 0 || c >= static_cast<int>(kDim) ||
+        r >= static_cast<int>(kDim)) {
+      return false;
+    }
+    return cells_[r * kDim + c] != 0;
+  }
+
+ private:
+  static constexpr size_t kDim = 800;
+  std::vector<uint8_t> cells_;
+};
+
+// the loop of HdmapROIFilter::Bitmap2dFilter, over points
+void RoiFilter(const PointFCloud& cloud, const GridRoi& roi,
+               std::vector<int>* indices) {
+  indices->clear();
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    const auto& pt = cloud.at(i);
+    if (roi.Check(pt.x, pt.y)) {
+      indices->push_back(static_cast<int>(i));
+    }
+  }
+}
+
+// the same over a view, with the contiguous columns of a columnar cloud
+void RoiFilter(const PointFCloudView& view, const GridRoi& roi,
+               std::vector<int>* indices) {
+  indices->clear();
+  if (view.IsColumnar()) {
+    const float* x = view.x_data();
+    const float* y = view.y_data();
+    for (size_t i = 0; i < view.size(); ++i) {
+      if (roi.Check(x[i], y[i])) {
+        indices->push_back(static_cast<int>(i));
+      }
+    }
+    return;
+  }
+  for (size_t i = 0; i < view.size(); ++i) {
+    if (roi.Check(view.x(i), view.y(i))) {
+      indices->push_back(static_cast<int>(i));
+    }
+  }
+}
+
+template <typename Func>
+double AverageMs(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; ++i) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         rounds;
+}
+
+}  // namespace
+
+TEST(ColumnarPointCloudTest, copy_test) {
+  PointFCloud cloud;
+  MockCloud(100, &cloud);
+  ColumnarPointFCloud columnar(cloud);
+  EXPECT_TRUE(columnar.CheckConsistency());
+  ASSERT_EQ(columnar.size(), 100);
+  EXPECT_EQ(columnar.get_timestamp(), 1.5);
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_EQ(columnar.x()[i], cloud[i].x);
+    EXPECT_EQ(columnar.y()[i], cloud[i].y);
+    EXPECT_EQ(columnar.z()[i], cloud[i].z);
+    EXPECT_EQ(columnar.intensity()[i], cloud[i].intensity);
+    EXPECT_EQ(columnar.points_timestamp(i), cloud.points_timestamp(i));
+    EXPECT_EQ(columnar.points_height(i), cloud.points_height(i));
+    EXPECT_EQ(columnar.points_beam_id(i), cloud.points_beam_id(i));
+    EXPECT_EQ(columnar.points_label(i), cloud.points_label(i));
+  }
+
+  PointFCloud copied;
+  columnar.CopyTo(&copied);
+  ASSERT_EQ(copied.size(), cloud.size());
+  EXPECT_TRUE(copied.CheckConsistency());
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_EQ(copied[i].x, cloud[i].x);
+    EXPECT_EQ(copied[i].intensity, cloud[i].intensity);
+    EXPECT_EQ(copied.points_beam_id(i), cloud.points_beam_id(i));
+  }
+
+  columnar.resize(101);
+  EXPECT_EQ(columnar.points_beam_id(100), -1);
+  EXPECT_EQ(columnar.points_height(100), std::numeric_limits<float>::max());
+  columnar.clear();
+  EXPECT_TRUE(columnar.empty());
+}
+
+TEST(ColumnarPointCloudTest, view_test) {
+  PointFCloud cloud;
+  MockCloud(100, &cloud);
+  ColumnarPointFCloud columnar(cloud);
+  PointFCloudView point_view(cloud);
+  PointFCloudView columnar_view(columnar);
+  EXPECT_FALSE(point_view.IsColumnar());
+  EXPECT_EQ(point_view.stride(), 4);
+  EXPECT_TRUE(columnar_view.IsColumnar());
+  ASSERT_EQ(point_view.size(), columnar_view.size());
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_EQ(point_view.x(i), columnar_view.x(i));
+    EXPECT_EQ(point_view.y(i), columnar_view.y(i));
+    EXPECT_EQ(point_view.z(i), columnar_view.z(i));
+    EXPECT_EQ(point_view[i].intensity, columnar_view[i].intensity);
+  }
+  // no copy
+  EXPECT_EQ(point_view.x_data(), &cloud[0].x);
+  EXPECT_EQ(columnar_view.x_data(), columnar.x());
+
+  PointFCloud empty;
+  EXPECT_TRUE(PointFCloudView(empty).empty());
+}
+
+TEST(ColumnarPointCloudTest, downsample_test) {
+  PointFCloud cloud;
+  MockCloud(1000, &cloud);
+  PointFCloudPtr cloud_ptr(new PointFCloud(cloud));
+  PointFCloudPtr expected(new PointFCloud);
+  EXPECT_TRUE(DownSamplePointCloudBeams(cloud_ptr, expected, 4));
+
+  ColumnarPointFCloud columnar(cloud);
+  ColumnarPointFCloud downsampled;
+  EXPECT_FALSE(DownSamplePointCloudBeams(columnar, &downsampled, 0));
+  EXPECT_TRUE(DownSamplePointCloudBeams(columnar, &downsampled, 4));
+  EXPECT_TRUE(downsampled.CheckConsistency());
+  ASSERT_EQ(downsampled.size(), expected->size());
+  for (size_t i = 0; i < downsampled.size(); ++i) {
+    EXPECT_EQ(downsampled.x()[i], expected->at(i).x);
+    EXPECT_EQ(downsampled.intensity()[i], expected->at(i).intensity);
+    EXPECT_EQ(downsampled.points_timestamp(i), expected->points_timestamp(i));
+    EXPECT_EQ(downsampled.points_height(i), expected->points_height(i));
+    EXPECT_EQ(downsampled.points_beam_id(i), expected->points_beam_id(i));
+    EXPECT_EQ(downsampled.points_label(i), expected->points_label(i));
+  }
+}
+
+TEST(ColumnarPointCloudTest, benchmark_test) {
+  constexpr int kRounds = 10;
+  PointFCloud cloud;
+  MockCloud(kBenchmarkPointNum, &cloud);
+  ColumnarPointFCloud columnar(cloud);
+  GridRoi roi;
+
+  std::vector<int> point_indices;
+  std::vector<int> view_indices;
+  std::vector<int> columnar_indices;
+  const double roi_point_ms =
+      AverageMs(kRounds, [&] { RoiFilter(cloud, roi, &point_indices); });
+  const double roi_view_ms = AverageMs(kRounds, [&] {
+    RoiFilter(PointFCloudView(cloud), roi, &view_indices);
+  });
+  const double roi_columnar_ms = AverageMs(kRounds, [&] {
+    RoiFilter(PointFCloudView(columnar), roi, &columnar_indices);
+  });
+  EXPECT_EQ(point_indices, view_indices);
+  EXPECT_EQ(point_indices, columnar_indices);
+
+  PointFCloudPtr cloud_ptr(new PointFCloud(cloud));
+  PointFCloudPtr downsampled(new PointFCloud);
+  ColumnarPointFCloud columnar_downsampled;
+  const double downsample_point_ms = AverageMs(kRounds, [&] {
+    downsampled->clear();
+    DownSamplePointCloudBeams(cloud_ptr, downsampled, 4);
+  });
+  const double downsample_columnar_ms = AverageMs(kRounds, [&] {
+    columnar_downsampled.clear();
+    DownSamplePointCloudBeams(columnar, &columnar_downsampled, 4);
+  });
+  EXPECT_EQ(downsampled->size(), columnar_downsampled.size());
+
+  std::cout << kBenchmarkPointNum << " points, roi: point cloud "
+            << roi_point_ms << " ms, view " << roi_view_ms
+            << " ms, columnar " << roi_columnar_ms
+            << " ms; beam downsample: point cloud " << downsample_point_ms
+            << " ms, columnar " << downsample_columnar_ms << " ms"
+            << std::endl;
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
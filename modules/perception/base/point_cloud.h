@@ -186,13 +186,13 @@ class PointCloud {
   // @brief cloud timestamp setter
   void set_timestamp(const double timestamp) { timestamp_ = timestamp; }
   // @brief cloud timestamp getter
-  double get_timestamp() { return timestamp_; }
+  double get_timestamp() const { return timestamp_; }
   // @brief sensor to world pose setter
   void set_sensor_to_world_pose(const Eigen::Affine3d& sensor_to_world_pose) {
     sensor_to_world_pose_ = sensor_to_world_pose;
   }
   // @brief sensor to world pose getter
-  const Eigen::Affine3d& sensor_to_world_pose() {
+  const Eigen::Affine3d& sensor_to_world_pose() const {
     return sensor_to_world_pose_;
   }
   // @brief rotate the point cloud and set rotation part of pose to identity
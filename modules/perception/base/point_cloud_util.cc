@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <vector>
+
 #include "Eigen/Dense"
 #include "opencv2/opencv.hpp"
 
@@ -45,6 +47,23 @@ bool DownSamplePointCloudBeams(base::PointFCloudPtr cloud_ptr,
   return true;
 }
 
+bool DownSamplePointCloudBeams(const ColumnarPointFCloud& cloud,
+                               ColumnarPointFCloud* out_cloud,
+                               int downsample_factor) {
+  if (downsample_factor <= 0) {
+    return false;
+  }
+  const int32_t* beam_id = cloud.points_beam_id().data();
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    if (beam_id[i] % downsample_factor == 0) {
+      out_cloud->push_back(cloud.at(i), cloud.points_timestamp(i),
+                           cloud.points_height(i), beam_id[i],
+                           cloud.points_label(i));
+    }
+  }
+  return true;
+}
+
 void GetPointCloudCentroid(const PointFCloud& cloud, PointF* centroid) {
   for (size_t i = 0; i < cloud.size(); ++i) {
     centroid->x += cloud[i].x;
@@ -21,6 +21,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/perception/base/columnar_point_cloud.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/base/point_cloud.h"
 
@@ -45,6 +46,12 @@ bool DownSamplePointCloudBeams(base::PointFCloudPtr cloud_ptr,
                                base::PointFCloudPtr out_cloud_ptr,
                                int downsample_factor);
 
+// @brief keep the points of every downsample_factor-th beam, reading only
+// the beam id column to select them
+bool DownSamplePointCloudBeams(const ColumnarPointFCloud& cloud,
+                               ColumnarPointFCloud* out_cloud,
+                               int downsample_factor);
+
 bool GetPointCloudMinareaBbox(const base::PointFCloud& pc, BoundingCube* box,
                               const int& min_num_points = 5,
                               const bool& verbose = false);
@@ -15,8 +15,13 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor.h"
 
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/common/file.h"
 #include "modules/common/configs/vehicle_config_helper.h"
@@ -32,6 +37,66 @@ using cyber::common::GetAbsolutePath;
 
 const float PointCloudPreprocessor::kPointInfThreshold = 1e3;
 
+namespace {
+
+// fewer points than this per chunk are not worth another thread
+constexpr size_t kMinChunkSize = 16384;
+
+class MessageReader {
+ public:
+  explicit MessageReader(const drivers::PointCloud& message)
+      : message_(message) {}
+
+  void ReadXYZ(size_t i, float* x, float* y, float* z) const {
+    const auto& pt = message_.point(static_cast<int>(i));
+    *x = pt.x();
+    *y = pt.y();
+    *z = pt.z();
+  }
+
+  void Read(size_t i, base::PointF* point, double* timestamp, float* height,
+            int32_t* beam_id, uint8_t* label) const {
+    const auto& pt = message_.point(static_cast<int>(i));
+    point->x = pt.x();
+    point->y = pt.y();
+    point->z = pt.z();
+    point->intensity = static_cast<float>(pt.intensity());
+    *timestamp = static_cast<double>(pt.timestamp()) * 1e-9;
+    *height = std::numeric_limits<float>::max();
+    *beam_id = static_cast<int32_t>(i);
+    *label = 0;
+  }
+
+ private:
+  const drivers::PointCloud& message_;
+};
+
+class CloudReader {
+ public:
+  explicit CloudReader(const base::PointFCloud& cloud) : cloud_(cloud) {}
+
+  void ReadXYZ(size_t i, float* x, float* y, float* z) const {
+    const auto& pt = cloud_.at(i);
+    *x = pt.x;
+    *y = pt.y;
+    *z = pt.z;
+  }
+
+  void Read(size_t i, base::PointF* point, double* timestamp, float* height,
+            int32_t* beam_id, uint8_t* label) const {
+    *point = cloud_.at(i);
+    *timestamp = cloud_.points_timestamp(i);
+    *height = cloud_.points_height(i);
+    *beam_id = cloud_.points_beam_id(i);
+    *label = cloud_.points_label(i);
+  }
+
+ private:
+  const base::PointFCloud& cloud_;
+};
+
+}  // namespace
+
 bool PointCloudPreprocessor::Init(
     const PointCloudPreprocessorInitOptions& options) {
   auto config_manager = lib::ConfigManager::Instance();
@@ -60,6 +125,7 @@ bool PointCloudPreprocessor::Init(
   box_backward_y_ = static_cast<float>(-vehicle_param.back_edge_to_center());*/
   filter_high_z_points_ = config.filter_high_z_points();
   z_threshold_ = config.z_threshold();
+  num_threads_ = config.num_threads();
   return true;
 }
 
@@ -83,6 +149,7 @@ bool PointCloudPreprocessor::Init(const StageConfig& stage_config) {
   filter_high_z_points_ =
       pointcloud_preprocessor_config_.filter_high_z_points();
   z_threshold_    = pointcloud_preprocessor_config_.z_threshold();
+  num_threads_    = pointcloud_preprocessor_config_.num_threads();
   return true;
 }
 
@@ -115,40 +182,10 @@ bool PointCloudPreprocessor::Preprocess(
   }
   frame->cloud->set_timestamp(message->measurement_time());
   if (message->point_size() > 0) {
-    frame->cloud->reserve(message->point_size());
-    base::PointF point;
-    for (int i = 0; i < message->point_size(); ++i) {
-      const apollo::drivers::PointXYZIT& pt = message->point(i);
-      if (filter_naninf_points_) {
-        if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
-          continue;
-        }
-        if (fabs(pt.x()) > kPointInfThreshold ||
-            fabs(pt.y()) > kPointInfThreshold ||
-            fabs(pt.z()) > kPointInfThreshold) {
-          continue;
-        }
-      }
-      Eigen::Vector3d vec3d_lidar(pt.x(), pt.y(), pt.z());
-      Eigen::Vector3d vec3d_novatel =
-          options.sensor2novatel_extrinsics * vec3d_lidar;
-      if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
-          vec3d_novatel[0] > box_backward_x_ &&
-          vec3d_novatel[1] < box_forward_y_ &&
-          vec3d_novatel[1] > box_backward_y_) {
-        continue;
-      }
-      if (filter_high_z_points_ && pt.z() > z_threshold_) {
-        continue;
-      }
-      point.x = pt.x();
-      point.y = pt.y();
-      point.z = pt.z();
-      point.intensity = static_cast<float>(pt.intensity());
-      frame->cloud->push_back(point, static_cast<double>(pt.timestamp()) * 1e-9,
-                              std::numeric_limits<float>::max(), i, 0);
-    }
-    TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
+    FilterAndTransform(MessageReader(*message), message->point_size(),
+                       options.sensor2novatel_extrinsics,
+                       frame->lidar2world_pose, frame->cloud.get(),
+                       frame->world_cloud.get());
   }
   return true;
 }
@@ -162,68 +199,130 @@ bool PointCloudPreprocessor::Preprocess(
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
   if (frame->cloud->size() > 0) {
-    size_t size = frame->cloud->size();
-    size_t i = 0;
-    while (i < size) {
-      auto& pt = frame->cloud->at(i);
-      if (filter_naninf_points_) {
-        if (std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z)) {
-          frame->cloud->SwapPoint(i, size--);
-          continue;
-        }
-        if (fabs(pt.x) > kPointInfThreshold ||
-            fabs(pt.y) > kPointInfThreshold ||
-            fabs(pt.z) > kPointInfThreshold) {
-          frame->cloud->SwapPoint(i, size--);
-          continue;
-        }
-      }
-      Eigen::Vector3d vec3d_lidar(pt.x, pt.y, pt.z);
-      Eigen::Vector3d vec3d_novatel =
-          options.sensor2novatel_extrinsics * vec3d_lidar;
-      if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
-          vec3d_novatel[0] > box_backward_x_ &&
-          vec3d_novatel[1] < box_forward_y_ &&
-          vec3d_novatel[1] > box_backward_y_) {
-        frame->cloud->SwapPoint(i, size--);
-        continue;
-      }
-      if (filter_high_z_points_ && pt.z > z_threshold_) {
-        frame->cloud->SwapPoint(i, size--);
-        continue;
-      }
-      ++i;
-    }
+    // filtered into a pooled cloud that then takes the place of the input
+    base::PointFCloudPtr filtered = base::PointFCloudPool::Instance().Get();
+    filtered->set_timestamp(frame->cloud->get_timestamp());
+    filtered->set_sensor_to_world_pose(frame->cloud->sensor_to_world_pose());
+    FilterAndTransform(CloudReader(*frame->cloud), frame->cloud->size(),
+                       options.sensor2novatel_extrinsics,
+                       frame->lidar2world_pose, filtered.get(),
+                       frame->world_cloud.get());
     AINFO << "Preprocessor filter points: "
-          << frame->cloud->size() << " to " << size;
-    frame->cloud->resize(size);
-    TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
+          << frame->cloud->size() << " to " << filtered->size();
+    frame->cloud->SwapPointCloud(filtered.get());
   }
   return true;
 }
 
-bool PointCloudPreprocessor::TransformCloud(
-    const base::PointFCloudPtr& local_cloud, const Eigen::Affine3d& pose,
-    base::PointDCloudPtr world_cloud) const {
-  if (local_cloud == nullptr) {
-    return false;
+template <typename ReaderT>
+void PointCloudPreprocessor::FilterAndTransform(
+    const ReaderT& reader, size_t size, const Eigen::Affine3d& sensor2novatel,
+    const Eigen::Affine3d& lidar2world, base::PointFCloud* local_cloud,
+    base::PointDCloud* world_cloud) const {
+  // more threads than cores only add switches
+  const int thread_num =
+      std::max(1, std::min(num_threads_, omp_get_num_procs()));
+  const int chunk_num = static_cast<int>(std::max<size_t>(
+      1, std::min<size_t>(thread_num, size / kMinChunkSize)));
+  std::vector<size_t> chunk_begin(chunk_num + 1);
+  for (int c = 0; c <= chunk_num; ++c) {
+    chunk_begin[c] = size * c / chunk_num;
   }
-  world_cloud->clear();
-  world_cloud->reserve(local_cloud->size());
-  for (size_t i = 0; i < local_cloud->size(); ++i) {
-    auto& pt = local_cloud->at(i);
-    Eigen::Vector3d trans_point(pt.x, pt.y, pt.z);
-    trans_point = pose * trans_point;
-    base::PointD world_point;
-    world_point.x = trans_point(0);
-    world_point.y = trans_point(1);
-    world_point.z = trans_point(2);
-    world_point.intensity = pt.intensity;
-    world_cloud->push_back(world_point, local_cloud->points_timestamp(i),
-                           std::numeric_limits<float>::max(),
-                           local_cloud->points_beam_id()[i], 0);
+  // kept points of each chunk, then their offset in the outputs
+  std::vector<size_t> chunk_offset(chunk_num + 1, 0);
+  // indices of the kept points, packed to the front of their chunk. Kept per
+  // calling thread to not fault in fresh pages per frame, while concurrent
+  // calls on one preprocessor each get their own
+  thread_local std::vector<uint32_t> kept_index_buffer;
+  if (kept_index_buffer.size() < size) {
+    kept_index_buffer.resize(size);
+  }
+  uint32_t* kept_index = kept_index_buffer.data();
+
+  // only x and y in the novatel frame are needed
+  const Eigen::Matrix4d& novatel = sensor2novatel.matrix();
+  const double n00 = novatel(0, 0), n01 = novatel(0, 1), n02 = novatel(0, 2),
+               n03 = novatel(0, 3);
+  const double n10 = novatel(1, 0), n11 = novatel(1, 1), n12 = novatel(1, 2),
+               n13 = novatel(1, 3);
+  // nan fails every comparison, so it is caught by the range check. The
+  // tests are combined bitwise, short circuits would branch on every point
+  auto drop = [&](float x, float y, float z) {
+    const bool naninf = !((std::fabs(x) <= kPointInfThreshold) &
+                          (std::fabs(y) <= kPointInfThreshold) &
+                          (std::fabs(z) <= kPointInfThreshold));
+    const double novatel_x = n00 * x + n01 * y + n02 * z + n03;
+    const double novatel_y = n10 * x + n11 * y + n12 * z + n13;
+    const bool in_box =
+        (novatel_x < box_forward_x_) & (novatel_x > box_backward_x_) &
+        (novatel_y < box_forward_y_) & (novatel_y > box_backward_y_);
+    return (filter_naninf_points_ & naninf) |
+           (filter_nearby_box_points_ & in_box) |
+           (filter_high_z_points_ & (z > z_threshold_));
+  };
+
+#pragma omp parallel for num_threads(chunk_num) schedule(static, 1)
+  for (int c = 0; c < chunk_num; ++c) {
+    const size_t begin = chunk_begin[c];
+    size_t count = 0;
+    for (size_t i = begin; i < chunk_begin[c + 1]; ++i) {
+      float x = 0.0f;
+      float y = 0.0f;
+      float z = 0.0f;
+      reader.ReadXYZ(i, &x, &y, &z);
+      kept_index[begin + count] = static_cast<uint32_t>(i);
+      count += !drop(x, y, z);
+    }
+    chunk_offset[c + 1] = count;
+  }
+
+  for (int c = 0; c < chunk_num; ++c) {
+    chunk_offset[c + 1] += chunk_offset[c];
+  }
+  const size_t kept = chunk_offset[chunk_num];
+  local_cloud->resize(kept);
+  world_cloud->resize(kept);
+  if (kept == 0) {
+    return;
+  }
+  base::PointF* local_points = &local_cloud->at(0);
+  double* local_timestamps = local_cloud->mutable_points_timestamp()->data();
+  float* local_heights = local_cloud->mutable_points_height()->data();
+  int32_t* local_beam_ids = local_cloud->mutable_points_beam_id()->data();
+  uint8_t* local_labels = local_cloud->mutable_points_label()->data();
+  base::PointD* world_points = &world_cloud->at(0);
+  double* world_timestamps = world_cloud->mutable_points_timestamp()->data();
+  float* world_heights = world_cloud->mutable_points_height()->data();
+  int32_t* world_beam_ids = world_cloud->mutable_points_beam_id()->data();
+  uint8_t* world_labels = world_cloud->mutable_points_label()->data();
+
+  const Eigen::Matrix4d& world = lidar2world.matrix();
+  const double w00 = world(0, 0), w01 = world(0, 1), w02 = world(0, 2),
+               w03 = world(0, 3);
+  const double w10 = world(1, 0), w11 = world(1, 1), w12 = world(1, 2),
+               w13 = world(1, 3);
+  const double w20 = world(2, 0), w21 = world(2, 1), w22 = world(2, 2),
+               w23 = world(2, 3);
+
+#pragma omp parallel for num_threads(chunk_num) schedule(static, 1)
+  for (int c = 0; c < chunk_num; ++c) {
+    const uint32_t* index = kept_index + chunk_begin[c];
+    for (size_t j = chunk_offset[c]; j < chunk_offset[c + 1]; ++j) {
+      reader.Read(*index++, local_points + j, local_timestamps + j,
+                  local_heights + j, local_beam_ids + j, local_labels + j);
+      const double x = local_points[j].x;
+      const double y = local_points[j].y;
+      const double z = local_points[j].z;
+      world_points[j].x = w00 * x + w01 * y + w02 * z + w03;
+      world_points[j].y = w10 * x + w11 * y + w12 * z + w13;
+      world_points[j].z = w20 * x + w21 * y + w22 * z + w23;
+      world_points[j].intensity = local_points[j].intensity;
+      world_timestamps[j] = local_timestamps[j];
+      world_heights[j] = std::numeric_limits<float>::max();
+      world_beam_ids[j] = local_beam_ids[j];
+      world_labels[j] = 0;
+    }
   }
-  return true;
 }
 
 PERCEPTION_REGISTER_POINTCLOUDPREPROCESSOR(PointCloudPreprocessor);
@@ -51,9 +51,20 @@ class PointCloudPreprocessor : public BasePointCloudPreprocessor {
   std::string Name() const override { return name_; }
 
  private:
-  bool TransformCloud(const base::PointFCloudPtr& local_cloud,
-                      const Eigen::Affine3d& pose,
-                      base::PointDCloudPtr world_cloud) const;
+  /**
+   * @brief Filter `size` points read through `reader` and write the kept
+   * ones to local_cloud, and transformed by lidar2world to world_cloud, in
+   * one pass. The points are split into chunks that are filtered in
+   * parallel, and a prefix sum over the chunk counts gives each chunk its
+   * place in the presized outputs. Order is preserved.
+   */
+  template <typename ReaderT>
+  void FilterAndTransform(const ReaderT& reader, size_t size,
+                          const Eigen::Affine3d& sensor2novatel,
+                          const Eigen::Affine3d& lidar2world,
+                          base::PointFCloud* local_cloud,
+                          base::PointDCloud* world_cloud) const;
+
   // params
   bool filter_naninf_points_ = true;
   bool filter_nearby_box_points_ = true;
@@ -63,6 +74,7 @@ class PointCloudPreprocessor : public BasePointCloudPreprocessor {
   float box_backward_y_ = 0.0f;
   bool filter_high_z_points_ = true;
   float z_threshold_ = 5.0f;
+  int num_threads_ = 4;
   static const float kPointInfThreshold;
 
 
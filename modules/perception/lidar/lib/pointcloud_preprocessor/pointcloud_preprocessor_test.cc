@@ -16,6 +16,13 @@
 
 #include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor.h"
 
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
 DECLARE_string(work_root);
 
 namespace apollo {
@@ -86,6 +93,66 @@ void MockMessage(adu::common::sensor::PointCloud* message) {
 }
 #endif
 
+// about one frame of a 128 beam lidar, a few percent of it nan or high
+void MockFrame(size_t size, base::PointFCloud* cloud) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> xy(-80.f, 80.f);
+  std::uniform_real_distribution<float> z(-2.f, 6.f);
+  cloud->clear();
+  for (size_t i = 0; i < size; ++i) {
+    base::PointF pt;
+    pt.x = i % 50 == 0 ? std::numeric_limits<float>::quiet_NaN() : xy(rng);
+    pt.y = xy(rng);
+    pt.z = z(rng);
+    pt.intensity = static_cast<float>(i % 256);
+    cloud->push_back(pt, 1e-6 * static_cast<double>(i),
+                     std::numeric_limits<float>::max(),
+                     static_cast<int32_t>(i % 128), 0);
+  }
+}
+
+// the serial filter and transform the fused pass replaced, with the
+// default config, whose nearby box is empty
+void ReferencePreprocess(const base::PointFCloud& input,
+                         const Eigen::Affine3d& lidar2world,
+                         base::PointFCloud* cloud,
+                         base::PointDCloud* world_cloud) {
+  const float inf_threshold = 1e3;
+  const float z_threshold = 5.0f;
+  cloud->clear();
+  cloud->reserve(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    const auto& pt = input.at(i);
+    if (std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z)) {
+      continue;
+    }
+    if (fabs(pt.x) > inf_threshold || fabs(pt.y) > inf_threshold ||
+        fabs(pt.z) > inf_threshold) {
+      continue;
+    }
+    if (pt.z > z_threshold) {
+      continue;
+    }
+    cloud->push_back(pt, input.points_timestamp(i), input.points_height(i),
+                     input.points_beam_id(i), input.points_label(i));
+  }
+  world_cloud->clear();
+  world_cloud->reserve(cloud->size());
+  for (size_t i = 0; i < cloud->size(); ++i) {
+    auto& pt = cloud->at(i);
+    Eigen::Vector3d trans_point(pt.x, pt.y, pt.z);
+    trans_point = lidar2world * trans_point;
+    base::PointD world_point;
+    world_point.x = trans_point(0);
+    world_point.y = trans_point(1);
+    world_point.z = trans_point(2);
+    world_point.intensity = pt.intensity;
+    world_cloud->push_back(world_point, cloud->points_timestamp(i),
+                           std::numeric_limits<float>::max(),
+                           cloud->points_beam_id()[i], 0);
+  }
+}
+
 TEST_F(PointCloudPreprocessorTest, basic_test) {
   EXPECT_EQ(preprocessor.Name(), "PointCloudPreprocessor");
   EXPECT_TRUE(preprocessor.Init());
@@ -129,6 +196,52 @@ TEST_F(PointCloudPreprocessorTest, basic_test) {
 #endif
 }
 
+TEST_F(PointCloudPreprocessorTest, benchmark_test) {
+  constexpr size_t kPointNum = 240000;
+  constexpr int kRounds = 5;
+  PointCloudPreprocessorOptions option;
+  option.sensor2novatel_extrinsics =
+      Eigen::Translation3d(1.0, 0.0, 1.5) *
+      Eigen::AngleAxisd(0.02, Eigen::Vector3d::UnitZ());
+  base::PointFCloud input;
+  MockFrame(kPointNum, &input);
+
+  LidarFrame frame;
+  frame.lidar2world_pose = Eigen::Translation3d(400.0, 300.0, 10.0) *
+                           Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ());
+  base::PointFCloud reference;
+  base::PointDCloud reference_world;
+  double reference_ms = 0.0;
+  double fused_ms = 0.0;
+  for (int i = 0; i < kRounds; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    ReferencePreprocess(input, frame.lidar2world_pose, &reference,
+                        &reference_world);
+    auto end = std::chrono::steady_clock::now();
+    reference_ms +=
+        std::chrono::duration<double, std::milli>(end - start).count();
+
+    frame.cloud = base::PointFCloudPool::Instance().Get();
+    *frame.cloud = input;
+    start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(preprocessor.Preprocess(option, &frame));
+    end = std::chrono::steady_clock::now();
+    fused_ms += std::chrono::duration<double, std::milli>(end - start).count();
+  }
+  ASSERT_EQ(reference.size(), frame.cloud->size());
+  ASSERT_EQ(reference_world.size(), frame.world_cloud->size());
+  for (size_t i = 0; i < reference_world.size(); ++i) {
+    EXPECT_EQ(reference.points_timestamp(i), frame.cloud->points_timestamp(i));
+    EXPECT_EQ(reference.points_beam_id(i), frame.cloud->points_beam_id(i));
+    EXPECT_EQ(reference.at(i).x, frame.cloud->at(i).x);
+    EXPECT_NEAR(reference_world.at(i).x, frame.world_cloud->at(i).x, 1e-9);
+    EXPECT_NEAR(reference_world.at(i).y, frame.world_cloud->at(i).y, 1e-9);
+    EXPECT_NEAR(reference_world.at(i).z, frame.world_cloud->at(i).z, 1e-9);
+  }
+  std::cout << kPointNum << " points, serial: " << reference_ms / kRounds
+            << " ms, fused: " << fused_ms / kRounds << " ms" << std::endl;
+}
+
 }  // namespace lidar
 }  // namespace perception
 }  // namespace apollo
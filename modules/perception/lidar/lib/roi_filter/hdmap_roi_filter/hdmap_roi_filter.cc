@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "cyber/common/file.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_point_label.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
@@ -52,6 +53,9 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   extend_dist_ = config.extend_dist();
   no_edge_table_ = config.no_edge_table();
   set_roi_service_ = config.set_roi_service();
+  use_world_roi_cache_ = config.use_world_roi_cache();
+  roi_cache_.Init(cell_size_, config.roi_cache_tile_size(), extend_dist_,
+                  no_edge_table_);
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
@@ -69,7 +73,8 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
         << " range: " << range_ << " cell_size: " << cell_size_
         << " extend_dist: " << extend_dist_
         << " no_edge_table: " << no_edge_table_
-        << " set_roi_service: " << set_roi_service_;
+        << " set_roi_service: " << set_roi_service_
+        << " use_world_roi_cache: " << use_world_roi_cache_;
   return true;
 }
 
@@ -84,6 +89,9 @@ bool HdmapROIFilter::Init(const StageConfig& stage_config) {
   extend_dist_ = hdmap_roi_filter_config_.extend_dist();
   no_edge_table_ = hdmap_roi_filter_config_.no_edge_table();
   set_roi_service_ = hdmap_roi_filter_config_.set_roi_service();
+  use_world_roi_cache_ = hdmap_roi_filter_config_.use_world_roi_cache();
+  roi_cache_.Init(cell_size_, hdmap_roi_filter_config_.roi_cache_tile_size(),
+                  extend_dist_, no_edge_table_);
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
@@ -132,13 +140,23 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
     polygons_world_[i++] = &polygon;
   }
 
-  // transform to local
-  base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
-  TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
-                 &polygons_local_, &cloud_local);
-
-  bool ret = FilterWithPolygonMask(cloud_local, polygons_local_,
-                                   &(frame->roi_indices));
+  bool ret = false;
+  // the roi service takes the local bitmap, which only the per frame path
+  // draws
+  if (use_world_roi_cache_ && !set_roi_service_ &&
+      frame->world_cloud != nullptr &&
+      frame->world_cloud->size() == frame->cloud->size()) {
+    ret = FilterWithRoiCache(frame->world_cloud, frame->lidar2world_pose,
+                             &(frame->roi_indices));
+  } else {
+    // transform to local
+    base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
+    TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
+                   &polygons_local_, &cloud_local);
+
+    ret = FilterWithPolygonMask(cloud_local, polygons_local_,
+                                &(frame->roi_indices));
+  }
 
   // set roi points label
   if (ret) {
@@ -214,6 +232,41 @@ bool HdmapROIFilter::FilterWithPolygonMask(
          Bitmap2dFilter(cloud, bitmap_, roi_indices);
 }
 
+bool HdmapROIFilter::FilterWithRoiCache(
+    const base::PointDCloudPtr& world_cloud, const Eigen::Affine3d& vel_pose,
+    base::PointIndices* roi_indices) {
+  // the cached polygons belong to the loaded map
+  if (roi_cache_map_dir_ != FLAGS_map_dir) {
+    roi_cache_.Clear();
+    roi_cache_map_dir_ = FLAGS_map_dir;
+  }
+  roi_cache_.SetPolygons(polygons_world_);
+
+  const Eigen::Vector3d vel_location = vel_pose.translation();
+  if (!roi_cache_.Check(vel_location.x(), vel_location.y())) {
+    AWARN << " Car is not in roi!!.";
+    return false;
+  }
+  // the range of the local bitmap around the car
+  const double min_x = vel_location.x() - range_;
+  const double max_x = vel_location.x() + range_;
+  const double min_y = vel_location.y() - range_;
+  const double max_y = vel_location.y() + range_;
+  roi_indices->indices.clear();
+  roi_indices->indices.reserve(world_cloud->size());
+  for (size_t i = 0; i < world_cloud->size(); ++i) {
+    const auto& pt = world_cloud->at(i);
+    if (pt.x < min_x || pt.x >= max_x || pt.y < min_y || pt.y >= max_y) {
+      continue;
+    }
+    if (roi_cache_.Check(pt.x, pt.y)) {
+      roi_indices->indices.push_back(static_cast<int>(i));
+    }
+  }
+  roi_cache_.Prune(vel_location.head<2>(), range_);
+  return true;
+}
+
 void HdmapROIFilter::TransformFrame(
     const base::PointFCloudPtr& cloud, const Eigen::Affine3d& vel_pose,
     const EigenVector<PolygonDType*>& polygons_world,
@@ -23,6 +23,7 @@
 #include "modules/perception/base/point_cloud.h"
 #include "modules/perception/lidar/lib/interface/base_roi_filter.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/world_roi_bitmap_cache.h"
 #include "modules/perception/lidar/lib/scene_manager/roi_service/roi_service.h"
 #include "modules/perception/pipeline/stage.h"
 
@@ -75,16 +76,26 @@ class HdmapROIFilter : public BaseROIFilter {
   bool Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
                       const Bitmap2D& bitmap, base::PointIndices* roi_indices);
 
+  // same roi as FilterWithPolygonMask, looked up in the cached world frame
+  // bitmap with the world cloud, without transforming and drawing per frame
+  bool FilterWithRoiCache(const base::PointDCloudPtr& world_cloud,
+                          const Eigen::Affine3d& vel_pose,
+                          base::PointIndices* roi_indices);
+
   // parameters for polygons scans convert
   double range_ = 120.0;
   double cell_size_ = 0.25;
   double extend_dist_ = 0.0;
   bool no_edge_table_ = false;
   bool set_roi_service_ = false;
+  bool use_world_roi_cache_ = false;
   EigenVector<base::PolygonDType*> polygons_world_;
   EigenVector<base::PolygonDType> polygons_local_;
   Bitmap2D bitmap_;
   ROIServiceContent roi_service_content_;
+  // world frame roi, valid for the map of roi_cache_map_dir_
+  WorldRoiBitmapCache roi_cache_;
+  std::string roi_cache_map_dir_;
 
   HDMapRoiFilterConfig hdmap_roi_filter_config_;
 
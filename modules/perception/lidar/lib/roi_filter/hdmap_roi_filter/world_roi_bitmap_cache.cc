@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/world_roi_bitmap_cache.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+// fnv-1a over the vertices, map polygons are rebuilt every frame with the
+// same coordinates
+uint64_t PolygonSignature(const base::PolygonDType& polygon) {
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  };
+  const size_t size = polygon.size();
+  mix(&size, sizeof(size));
+  for (size_t i = 0; i < size; ++i) {
+    mix(&polygon[i].x, sizeof(polygon[i].x));
+    mix(&polygon[i].y, sizeof(polygon[i].y));
+  }
+  return hash;
+}
+
+}  // namespace
+
+void WorldRoiBitmapCache::Init(double cell_size, double tile_size,
+                               double extend_dist, bool no_edge_table) {
+  CHECK_GT(cell_size, 0.0);
+  cell_size_ = cell_size;
+  // whole cells per tile keep the cells of all tiles on one world grid
+  tile_size_ =
+      std::max(1.0, std::round(tile_size / cell_size_)) * cell_size_;
+  tile_size_inv_ = 1.0 / tile_size_;
+  extend_dist_ = extend_dist;
+  no_edge_table_ = no_edge_table;
+  Clear();
+}
+
+void WorldRoiBitmapCache::SetPolygons(
+    const EigenVector<base::PolygonDType*>& polygons) {
+  std::unordered_set<uint64_t> signatures;
+  std::vector<MapPolygon> added;
+  for (const auto* polygon : polygons) {
+    if (polygon == nullptr || polygon->empty()) {
+      continue;
+    }
+    const uint64_t signature = PolygonSignature(*polygon);
+    if (!signatures.insert(signature).second ||
+        signatures_.count(signature) > 0) {
+      continue;
+    }
+    MapPolygon map_polygon;
+    map_polygon.signature = signature;
+    map_polygon.points.resize(polygon->size());
+    map_polygon.min_point.setConstant(std::numeric_limits<double>::max());
+    map_polygon.max_point = -map_polygon.min_point;
+    for (size_t i = 0; i < polygon->size(); ++i) {
+      auto& point = map_polygon.points[i];
+      point.x() = polygon->at(i).x;
+      point.y() = polygon->at(i).y;
+      map_polygon.min_point = map_polygon.min_point.cwiseMin(point);
+      map_polygon.max_point = map_polygon.max_point.cwiseMax(point);
+    }
+    added.push_back(std::move(map_polygon));
+  }
+
+  // polygons the map no longer hands out take their mask with them
+  auto removed = std::stable_partition(
+      polygons_.begin(), polygons_.end(), [&](const MapPolygon& polygon) {
+        return signatures.count(polygon.signature) > 0;
+      });
+  for (auto it = removed; it != polygons_.end(); ++it) {
+    DropTiles(*it);
+  }
+  polygons_.erase(removed, polygons_.end());
+  for (auto& map_polygon : added) {
+    DropTiles(map_polygon);
+    polygons_.push_back(std::move(map_polygon));
+  }
+  signatures_.swap(signatures);
+}
+
+bool WorldRoiBitmapCache::Check(double x, double y) {
+  const int64_t tile_x = TileIndex(x);
+  const int64_t tile_y = TileIndex(y);
+  const uint64_t key = TileKey(tile_x, tile_y);
+  TileSlot& slot = tile_slots_[(tile_x & (kTileSlotDim - 1)) * kTileSlotDim +
+                               (tile_y & (kTileSlotDim - 1))];
+  if (slot.tile == nullptr || slot.key != key) {
+    slot.tile = GetTile(tile_x, tile_y);
+    slot.key = key;
+  }
+  return slot.tile->Check(Eigen::Vector2d(x, y));
+}
+
+void WorldRoiBitmapCache::Prune(const Eigen::Vector2d& center,
+                                double distance) {
+  const int64_t min_tile_x = TileIndex(center.x() - distance);
+  const int64_t max_tile_x = TileIndex(center.x() + distance);
+  const int64_t min_tile_y = TileIndex(center.y() - distance);
+  const int64_t max_tile_y = TileIndex(center.y() + distance);
+  for (auto it = tiles_.begin(); it != tiles_.end();) {
+    const Eigen::Vector2d& min_range = it->second->min_range();
+    const int64_t tile_x = TileIndex(min_range.x() + 0.5 * tile_size_);
+    const int64_t tile_y = TileIndex(min_range.y() + 0.5 * tile_size_);
+    if (tile_x < min_tile_x || tile_x > max_tile_x || tile_y < min_tile_y ||
+        tile_y > max_tile_y) {
+      it = tiles_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ResetTileSlots();
+}
+
+void WorldRoiBitmapCache::Clear() {
+  polygons_.clear();
+  signatures_.clear();
+  tiles_.clear();
+  ResetTileSlots();
+}
+
+const Bitmap2D* WorldRoiBitmapCache::GetTile(int64_t tile_x,
+                                             int64_t tile_y) {
+  auto& tile = tiles_[TileKey(tile_x, tile_y)];
+  if (tile == nullptr) {
+    tile = BuildTile(tile_x, tile_y);
+  }
+  return tile.get();
+}
+
+std::unique_ptr<Bitmap2D> WorldRoiBitmapCache::BuildTile(
+    int64_t tile_x, int64_t tile_y) const {
+  const Eigen::Vector2d origin(tile_x * tile_size_, tile_y * tile_size_);
+  const Eigen::Vector2d tile_end = origin.array() + tile_size_;
+  // one more cell on each side, the scan converter leaves out the last
+  // scan of a polygon clipped by the bitmap range
+  const Eigen::Vector2d cell_size(cell_size_, cell_size_);
+  std::unique_ptr<Bitmap2D> tile(new Bitmap2D);
+  tile->Init(origin - cell_size, tile_end + cell_size, cell_size);
+  tile->SetUp(Bitmap2D::DirectionMajor::XMAJOR);
+
+  for (const auto& polygon : polygons_) {
+    if (!Overlaps(polygon, tile_x, tile_y)) {
+      continue;
+    }
+    // an illegal polygon only loses its own mask
+    DrawPolygonMask<double>(polygon.points, tile.get(), extend_dist_,
+                            no_edge_table_);
+  }
+  return tile;
+}
+
+bool WorldRoiBitmapCache::Overlaps(const MapPolygon& polygon, int64_t tile_x,
+                                   int64_t tile_y) const {
+  // scans are x major through the cell centres, so the polygon has to reach
+  // the centre of a cell of the tile, half a cell past the extra one the
+  // tile bitmap has on each side
+  const double min_x = tile_x * tile_size_ - cell_size_;
+  const double max_x = (tile_x + 1) * tile_size_ + cell_size_;
+  if (std::min(polygon.max_point.x(), max_x) -
+          std::max(polygon.min_point.x(), min_x) <
+      1.5 * cell_size_) {
+    return false;
+  }
+  // scan intervals are extended along y
+  const double min_y = tile_y * tile_size_ - extend_dist_;
+  const double max_y = (tile_y + 1) * tile_size_ + extend_dist_;
+  return polygon.max_point.y() >= min_y && polygon.min_point.y() <= max_y;
+}
+
+void WorldRoiBitmapCache::ResetTileSlots() {
+  for (auto& slot : tile_slots_) {
+    slot.tile = nullptr;
+  }
+}
+
+void WorldRoiBitmapCache::DropTiles(const MapPolygon& polygon) {
+  if (tiles_.empty()) {
+    return;
+  }
+  const int64_t min_tile_x = TileIndex(polygon.min_point.x() - cell_size_);
+  const int64_t max_tile_x = TileIndex(polygon.max_point.x() + cell_size_);
+  const int64_t min_tile_y = TileIndex(polygon.min_point.y() - extend_dist_);
+  const int64_t max_tile_y = TileIndex(polygon.max_point.y() + extend_dist_);
+  for (int64_t tile_x = min_tile_x; tile_x <= max_tile_x; ++tile_x) {
+    for (int64_t tile_y = min_tile_y; tile_y <= max_tile_y; ++tile_y) {
+      if (Overlaps(polygon, tile_x, tile_y)) {
+        tiles_.erase(TileKey(tile_x, tile_y));
+      }
+    }
+  }
+  ResetTileSlots();
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/common/util/eigen_defs.h"
+#include "modules/perception/base/point_cloud.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_scan_cvter.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+/**
+ * @class WorldRoiBitmapCache
+ * @brief Roi bitmap in the world frame, split into square tiles that are
+ * rasterized from the map polygons on first lookup and then kept across
+ * frames.
+ *
+ * Every frame sets the map polygons it queried, and only those make up the
+ * roi. A polygon that is new, or no longer queried, drops the tiles it
+ * overlaps, which are rasterized again on their next lookup. Tiles far from
+ * the vehicle are pruned, and Clear drops everything when the map itself
+ * changes.
+ */
+class WorldRoiBitmapCache {
+ public:
+  template <class EigenType>
+  using EigenVector = apollo::common::EigenVector<EigenType>;
+
+  WorldRoiBitmapCache() = default;
+  ~WorldRoiBitmapCache() = default;
+
+  void Init(double cell_size, double tile_size, double extend_dist,
+            bool no_edge_table);
+
+  // @brief set the map polygons of the current frame
+  void SetPolygons(const EigenVector<base::PolygonDType*>& polygons);
+
+  // @brief whether the world point lies in the roi, tiles are rasterized
+  // on demand
+  bool Check(double x, double y);
+
+  // @brief keep only the tiles overlapping the square of half size distance
+  // around center
+  void Prune(const Eigen::Vector2d& center, double distance);
+
+  // @brief drop all tiles and polygons
+  void Clear();
+
+  size_t tile_num() const { return tiles_.size(); }
+  size_t polygon_num() const { return polygons_.size(); }
+
+ private:
+  typedef PolygonScanCvter<double>::Polygon Polygon;
+
+  struct MapPolygon {
+    Polygon points;
+    Eigen::Vector2d min_point;
+    Eigen::Vector2d max_point;
+    uint64_t signature = 0;
+  };
+
+  struct TileSlot {
+    uint64_t key = 0;
+    const Bitmap2D* tile = nullptr;
+  };
+  // kTileSlotDim x kTileSlotDim neighbouring tiles map to distinct slots
+  static constexpr int kTileSlotDim = 8;
+
+  int64_t TileIndex(double v) const {
+    return static_cast<int64_t>(std::floor(v * tile_size_inv_));
+  }
+  uint64_t TileKey(int64_t tile_x, int64_t tile_y) const {
+    return (static_cast<uint64_t>(tile_x) << 32) ^
+           (static_cast<uint64_t>(tile_y) & 0xffffffff);
+  }
+  const Bitmap2D* GetTile(int64_t tile_x, int64_t tile_y);
+  std::unique_ptr<Bitmap2D> BuildTile(int64_t tile_x, int64_t tile_y) const;
+  // whether drawing the polygon may set cells of the tile
+  bool Overlaps(const MapPolygon& polygon, int64_t tile_x,
+                int64_t tile_y) const;
+  void DropTiles(const MapPolygon& polygon);
+  void ResetTileSlots();
+
+  double cell_size_ = 0.25;
+  double tile_size_ = 64.0;
+  double tile_size_inv_ = 1.0 / 64.0;
+  double extend_dist_ = 0.0;
+  bool no_edge_table_ = false;
+
+  std::vector<MapPolygon> polygons_;
+  std::unordered_set<uint64_t> signatures_;
+  std::unordered_map<uint64_t, std::unique_ptr<Bitmap2D>> tiles_;
+  // tiles of recent lookups, without hashing the key of every point
+  std::array<TileSlot, kTileSlotDim * kTileSlotDim> tile_slots_;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
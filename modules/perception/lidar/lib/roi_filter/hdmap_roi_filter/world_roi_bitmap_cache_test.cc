@@ -0,0 +1,279 @@
+/******************************************************************************
+ * Copyright 2025 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/world_roi_bitmap_cache.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+template <class EigenType>
+using EigenVector = apollo::common::EigenVector<EigenType>;
+
+constexpr double kRange = 120.0;
+constexpr double kCellSize = 0.25;
+// utm like coordinates
+constexpr double kOriginX = 587000.0;
+constexpr double kOriginY = 4141000.0;
+
+base::PolygonDType MakePolygon(
+    const std::vector<std::pair<double, double>>& points) {
+  base::PolygonDType polygon;
+  for (const auto& p : points) {
+    base::PointD point;
+    point.x = kOriginX + p.first;
+    point.y = kOriginY + p.second;
+    polygon.push_back(point);
+  }
+  return polygon;
+}
+
+// a 2 km road along x cut into 50 m lanes, crossed by a road every 200 m,
+// with a slanted junction at each crossing
+EigenVector<base::PolygonDType> MakeMap() {
+  EigenVector<base::PolygonDType> polygons;
+  for (double x = 0.0; x < 2000.0; x += 50.0) {
+    polygons.push_back(
+        MakePolygon({{x, 0.0}, {x + 50.0, 0.3}, {x + 50.0, 15.3}, {x, 15.0}}));
+  }
+  for (double x = 100.0; x < 2000.0; x += 200.0) {
+    polygons.push_back(MakePolygon(
+        {{x, -200.0}, {x + 12.0, -200.0}, {x + 12.0, -5.0}, {x, -5.0}}));
+    polygons.push_back(MakePolygon(
+        {{x, 20.0}, {x + 12.0, 20.0}, {x + 12.0, 200.0}, {x, 200.0}}));
+    polygons.push_back(MakePolygon({{x - 8.0, -6.0},
+                                    {x + 20.0, -8.0},
+                                    {x + 22.0, 22.0},
+                                    {x - 6.0, 23.0}}));
+  }
+  return polygons;
+}
+
+// the polygons the map input hands out around a location
+EigenVector<base::PolygonDType*> QueryPolygons(
+    EigenVector<base::PolygonDType>* map, const Eigen::Vector2d& location) {
+  EigenVector<base::PolygonDType*> polygons;
+  for (auto& polygon : *map) {
+    for (const auto& point : polygon) {
+      if (std::abs(point.x - location.x()) < kRange &&
+          std::abs(point.y - location.y()) < kRange) {
+        polygons.push_back(&polygon);
+        break;
+      }
+    }
+  }
+  return polygons;
+}
+
+// world points around a location
+std::vector<Eigen::Vector2d> MakePoints(const Eigen::Vector2d& location,
+                                        size_t size, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> offset(-100.0, 100.0);
+  std::vector<Eigen::Vector2d> points(size);
+  for (auto& point : points) {
+    point = location + Eigen::Vector2d(offset(rng), offset(rng));
+  }
+  return points;
+}
+
+// the per frame path of HdmapROIFilter: polygons moved to the location,
+// drawn into the local bitmap, points looked up relative to the location
+class LocalRoi {
+ public:
+  LocalRoi() {
+    bitmap_.Init(Eigen::Vector2d(-kRange, -kRange),
+                 Eigen::Vector2d(kRange, kRange),
+                 Eigen::Vector2d(kCellSize, kCellSize));
+  }
+
+  void Draw(const EigenVector<base::PolygonDType*>& polygons,
+            const Eigen::Vector2d& location) {
+    location_ = location;
+    raw_polygons_.resize(polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      raw_polygons_[i].resize(polygons[i]->size());
+      for (size_t j = 0; j < polygons[i]->size(); ++j) {
+        raw_polygons_[i][j].x() = polygons[i]->at(j).x - location.x();
+        raw_polygons_[i][j].y() = polygons[i]->at(j).y - location.y();
+      }
+    }
+    bitmap_.SetUp(Bitmap2D::DirectionMajor::XMAJOR);
+    DrawPolygonsMask<double>(raw_polygons_, &bitmap_);
+  }
+
+  bool Check(const Eigen::Vector2d& point) const {
+    const Eigen::Vector2d local = point - location_;
+    return bitmap_.IsExists(local) && bitmap_.Check(local);
+  }
+
+ private:
+  Bitmap2D bitmap_;
+  Eigen::Vector2d location_;
+  std::vector<PolygonScanCvter<double>::Polygon> raw_polygons_;
+};
+
+Eigen::Vector2d Location(double x, double y) {
+  return Eigen::Vector2d(kOriginX + x, kOriginY + y);
+}
+
+}  // namespace
+
+TEST(WorldRoiBitmapCacheTest, matches_local_bitmap) {
+  auto map = MakeMap();
+  WorldRoiBitmapCache cache;
+  cache.Init(kCellSize, 64.0, 0.0, false);
+  LocalRoi local_roi;
+  // driving along the road, the cells of the local bitmap move with the car
+  for (double x = 0.0; x < 600.0; x += 37.3) {
+    const Eigen::Vector2d location = Location(x, 7.1);
+    const auto polygons = QueryPolygons(&map, location);
+    cache.SetPolygons(polygons);
+    local_roi.Draw(polygons, location);
+    EXPECT_TRUE(cache.Check(location.x(), location.y()));
+
+    size_t roi_num = 0;
+    size_t diff_num = 0;
+    for (const auto& point : MakePoints(location, 20000, 1)) {
+      const bool expected = local_roi.Check(point);
+      roi_num += expected;
+      diff_num += expected != cache.Check(point.x(), point.y());
+    }
+    EXPECT_GT(roi_num, 500);
+    // only the points in the border cells of the two grids may differ
+    EXPECT_LT(diff_num, roi_num / 50);
+    cache.Prune(location, kRange);
+  }
+}
+
+TEST(WorldRoiBitmapCacheTest, invalidation_test) {
+  auto map = MakeMap();
+  WorldRoiBitmapCache cache;
+  cache.Init(kCellSize, 64.0, 0.0, false);
+  const Eigen::Vector2d lane = Location(25.0, 7.0);
+  const Eigen::Vector2d crossing_road = Location(106.0, 100.0);
+
+  EigenVector<base::PolygonDType*> polygons = {&map[0]};
+  cache.SetPolygons(polygons);
+  EXPECT_TRUE(cache.Check(lane.x(), lane.y()));
+  EXPECT_FALSE(cache.Check(crossing_road.x(), crossing_road.y()));
+  EXPECT_EQ(cache.polygon_num(), 1);
+  EXPECT_EQ(cache.tile_num(), 2);
+
+  // polygons seen before keep the tiles
+  cache.SetPolygons(polygons);
+  EXPECT_EQ(cache.polygon_num(), 1);
+  EXPECT_EQ(cache.tile_num(), 2);
+
+  // a new polygon drops the tiles it overlaps
+  polygons.push_back(&map[41]);
+  cache.SetPolygons(polygons);
+  EXPECT_EQ(cache.polygon_num(), 2);
+  EXPECT_TRUE(cache.Check(crossing_road.x(), crossing_road.y()));
+  EXPECT_TRUE(cache.Check(lane.x(), lane.y()));
+
+  // a polygon the map query no longer returns is not roi any more
+  polygons = {&map[41]};
+  cache.SetPolygons(polygons);
+  EXPECT_EQ(cache.polygon_num(), 1);
+  EXPECT_FALSE(cache.Check(lane.x(), lane.y()));
+  EXPECT_TRUE(cache.Check(crossing_road.x(), crossing_road.y()));
+
+  // far down the road no tile is kept
+  cache.Prune(Location(1500.0, 7.0), kRange);
+  EXPECT_EQ(cache.tile_num(), 0);
+
+  cache.Clear();
+  EXPECT_EQ(cache.polygon_num(), 0);
+  EXPECT_FALSE(cache.Check(crossing_road.x(), crossing_road.y()));
+}
+
+TEST(WorldRoiBitmapCacheTest, benchmark_test) {
+  constexpr int kFrameNum = 50;
+  constexpr size_t kPointNum = 120000;
+  auto map = MakeMap();
+  WorldRoiBitmapCache cache;
+  cache.Init(kCellSize, 64.0, 0.0, false);
+  LocalRoi local_roi;
+
+  // 10 Hz at 15 m/s
+  std::vector<Eigen::Vector2d> locations;
+  std::vector<EigenVector<base::PolygonDType*>> polygons;
+  for (int i = 0; i < kFrameNum; ++i) {
+    locations.push_back(Location(300.0 + 1.5 * i, 7.0));
+    polygons.push_back(QueryPolygons(&map, locations.back()));
+  }
+  const auto points = MakePoints(locations[0], kPointNum, 2);
+
+  // per frame mask update and point lookup of both paths
+  double local_draw_ms = 0.0;
+  double local_check_ms = 0.0;
+  double cache_update_ms = 0.0;
+  double cache_check_ms = 0.0;
+  size_t local_num = 0;
+  size_t cache_num = 0;
+  for (int i = 0; i < kFrameNum; ++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    local_roi.Draw(polygons[i], locations[i]);
+    auto t1 = std::chrono::steady_clock::now();
+    for (const auto& point : points) {
+      local_num += local_roi.Check(point);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    cache.SetPolygons(polygons[i]);
+    cache.Prune(locations[i], kRange);
+    auto t3 = std::chrono::steady_clock::now();
+    for (const auto& point : points) {
+      const Eigen::Vector2d local = point - locations[i];
+      if (std::abs(local.x()) < kRange && std::abs(local.y()) < kRange) {
+        cache_num += cache.Check(point.x(), point.y());
+      }
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    local_draw_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+    local_check_ms +=
+        std::chrono::duration<double, std::milli>(t2 - t1).count();
+    cache_update_ms +=
+        std::chrono::duration<double, std::milli>(t3 - t2).count();
+    cache_check_ms +=
+        std::chrono::duration<double, std::milli>(t4 - t3).count();
+  }
+  EXPECT_NEAR(static_cast<double>(cache_num), static_cast<double>(local_num),
+              0.02 * static_cast<double>(local_num));
+
+  std::cout << kPointNum << " points, per frame roi: local bitmap draw "
+            << local_draw_ms / kFrameNum << " ms + lookup "
+            << local_check_ms / kFrameNum << " ms, world cache update "
+            << cache_update_ms / kFrameNum << " ms + lookup "
+            << cache_check_ms / kFrameNum << " ms" << std::endl;
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -16,6 +16,7 @@
 #include "modules/perception/onboard/component/lidar_detection_component.h"
 
 #include "cyber/time/clock.h"
+#include "modules/common/util/point_cloud_packing.h"
 #include "modules/common/util/string_util.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
 #include "modules/perception/lidar/common/lidar_error_code.h"
@@ -31,11 +32,13 @@ namespace onboard {
 
 using apollo::cyber::common::GetAbsolutePath;
 
-std::atomic<uint32_t> LidarDetectionComponent::seq_num_{0};
+template <typename CloudT>
+std::atomic<uint32_t> LidarDetectionComponentBase<CloudT>::seq_num_{0};
 
-bool LidarDetectionComponent::Init() {
+template <typename CloudT>
+bool LidarDetectionComponentBase<CloudT>::Init() {
   LidarDetectionComponentConfig comp_config;
-  if (!GetProtoConfig(&comp_config)) {
+  if (!this->GetProtoConfig(&comp_config)) {
     AERROR << "Get config failed";
     return false;
   }
@@ -48,7 +51,8 @@ bool LidarDetectionComponent::Init() {
   lidar_query_tf_offset_ =
       static_cast<float>(comp_config.lidar_query_tf_offset());
   enable_hdmap_ = comp_config.enable_hdmap();
-  writer_ = node_->CreateWriter<LidarFrameMessage>(output_channel_name_);
+  writer_ = this->node_->template CreateWriter<LidarFrameMessage>(
+      output_channel_name_);
 
   const auto& lidar_detection_root_dir = comp_config.lidar_detection_conf_dir();
   const auto& lidar_detection_conf_file =
@@ -73,8 +77,9 @@ bool LidarDetectionComponent::Init() {
   return true;
 }
 
-bool LidarDetectionComponent::Proc(
-    const std::shared_ptr<drivers::PointCloud>& message) {
+template <typename CloudT>
+bool LidarDetectionComponentBase<CloudT>::Proc(
+    const std::shared_ptr<CloudT>& message) {
   AINFO << std::setprecision(16)
         << "Enter detection component, message timestamp: "
         << message->measurement_time()
@@ -90,7 +95,8 @@ bool LidarDetectionComponent::Proc(
   return status;
 }
 
-bool LidarDetectionComponent::InitAlgorithmPlugin() {
+template <typename CloudT>
+bool LidarDetectionComponentBase<CloudT>::InitAlgorithmPlugin() {
   ACHECK(common::SensorManager::Instance()->GetSensorInfo(sensor_name_,
                                                           &sensor_info_));
 
@@ -115,7 +121,8 @@ bool LidarDetectionComponent::InitAlgorithmPlugin() {
   return true;
 }
 
-bool LidarDetectionComponent::ConvertCloud(
+template <typename CloudT>
+bool LidarDetectionComponentBase<CloudT>::ConvertCloud(
     const std::shared_ptr<const drivers::PointCloud>& from,
     std::shared_ptr<base::AttributePointCloud<base::PointF>> to) {
   to->set_timestamp(from->measurement_time());
@@ -133,8 +140,40 @@ bool LidarDetectionComponent::ConvertCloud(
   return true;
 }
 
-bool LidarDetectionComponent::InternalProc(
-    const std::shared_ptr<const drivers::PointCloud>& in_message,
+template <typename CloudT>
+bool LidarDetectionComponentBase<CloudT>::ConvertCloud(
+    const std::shared_ptr<const drivers::PackedPointCloud>& from,
+    std::shared_ptr<base::AttributePointCloud<base::PointF>> to) {
+  if (!common::util::HasConsistentColumns(*from)) {
+    AERROR << "Point cloud columns differ in size, x: " << from->x_size()
+           << ", y: " << from->y_size() << ", z: " << from->z_size()
+           << ", intensity: " << from->intensity_size()
+           << ", timestamp: " << from->timestamp_size();
+    return false;
+  }
+  to->set_timestamp(from->measurement_time());
+  const int size = from->x_size();
+  to->reserve(size);
+  const float* x = from->x().data();
+  const float* y = from->y().data();
+  const float* z = from->z().data();
+  const uint32_t* intensity = from->intensity().data();
+  const uint64_t* timestamp = from->timestamp().data();
+  base::PointF point;
+  for (int i = 0; i < size; ++i) {
+    point.x = x[i];
+    point.y = y[i];
+    point.z = z[i];
+    point.intensity = static_cast<float>(intensity[i]);
+    to->push_back(point, static_cast<double>(timestamp[i]) * 1e-9,
+                  std::numeric_limits<float>::max(), i, 0);
+  }
+  return true;
+}
+
+template <typename CloudT>
+bool LidarDetectionComponentBase<CloudT>::InternalProc(
+    const std::shared_ptr<const CloudT>& in_message,
     const std::shared_ptr<LidarFrameMessage>& out_message) {
   uint32_t seq_num = seq_num_.fetch_add(1);
   const double timestamp = in_message->measurement_time();
@@ -183,7 +222,12 @@ bool LidarDetectionComponent::InternalProc(
   // }
 
   // Add point cloud to frame
-  ConvertCloud(in_message, frame->cloud);
+  if (!ConvertCloud(in_message, frame->cloud)) {
+    out_message->error_code_ =
+        apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
+    AERROR << "Failed to convert point cloud of sensor " << sensor_name_;
+    return false;
+  }
   frame->lidar2novatel_extrinsics = detect_opts.sensor2novatel_extrinsics;
 
   pipeline::DataFrame data_frame;
@@ -200,6 +244,9 @@ bool LidarDetectionComponent::InternalProc(
   return true;
 }
 
+template class LidarDetectionComponentBase<drivers::PointCloud>;
+template class LidarDetectionComponentBase<drivers::PackedPointCloud>;
+
 }  // namespace onboard
 }  // namespace perception
 }  // namespace apollo
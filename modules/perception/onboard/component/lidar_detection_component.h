@@ -33,27 +33,36 @@ namespace apollo {
 namespace perception {
 namespace onboard {
 
-class LidarDetectionComponent : public cyber::Component<drivers::PointCloud> {
+/**
+ * @brief Lidar detection on clouds of type CloudT, which is
+ * drivers::PointCloud or drivers::PackedPointCloud.
+ */
+template <typename CloudT>
+class LidarDetectionComponentBase : public cyber::Component<CloudT> {
  public:
   using PipelineConfig = pipeline::PipelineConfig;
 
  public:
-  LidarDetectionComponent() = default;
-  virtual ~LidarDetectionComponent() = default;
+  LidarDetectionComponentBase() = default;
+  virtual ~LidarDetectionComponentBase() = default;
 
   bool Init() override;
-  bool Proc(const std::shared_ptr<drivers::PointCloud>& message) override;
+  bool Proc(const std::shared_ptr<CloudT>& message) override;
 
  private:
   bool InitAlgorithmPlugin();
   bool InternalProc(
-      const std::shared_ptr<const drivers::PointCloud>& in_message,
+      const std::shared_ptr<const CloudT>& in_message,
       const std::shared_ptr<LidarFrameMessage>& out_message);
 
   bool ConvertCloud(
       const std::shared_ptr<const drivers::PointCloud>& from,
       std::shared_ptr<base::AttributePointCloud<base::PointF>> to);
 
+  bool ConvertCloud(
+      const std::shared_ptr<const drivers::PackedPointCloud>& from,
+      std::shared_ptr<base::AttributePointCloud<base::PointF>> to);
+
  private:
   static std::atomic<uint32_t> seq_num_;
   std::string sensor_name_;
@@ -73,7 +82,14 @@ class LidarDetectionComponent : public cyber::Component<drivers::PointCloud> {
   std::shared_ptr<apollo::cyber::Writer<LidarFrameMessage>> writer_;
 };
 
+class LidarDetectionComponent
+    : public LidarDetectionComponentBase<drivers::PointCloud> {};
+
+class PackedLidarDetectionComponent
+    : public LidarDetectionComponentBase<drivers::PackedPointCloud> {};
+
 CYBER_REGISTER_COMPONENT(LidarDetectionComponent);
+CYBER_REGISTER_COMPONENT(PackedLidarDetectionComponent);
 
 }  // namespace onboard
 }  // namespace perception